@@ -10,13 +10,14 @@
 #include "../States/LobbyState.h"
 #include "../States/GameplayState.h"
 #include "../States/GameOverState.h"
+#include "../Rendering/RenderThread.h"
 
 //==============================================================================
 // Standard Library Includes
 //==============================================================================
+#include <algorithm>
 #include <memory>
 #include <cmath>
-#include <cstdio>    // for snprintf
 #include <iostream>
 
 //==============================================================================
@@ -48,17 +49,21 @@ void CubeGame::ResetPlayerState(Player& p) {
     p.shape.setPosition(SCREEN_WIDTH / 2.f, SCREEN_HEIGHT / 2.f);
 }
 
-// Formats a string update for the given player state.
-// Returns an empty string if formatting fails.
-std::string CubeGame::FormatPlayerUpdate(const Player& p) {
-    char buffer[256];
-    int bytes = snprintf(buffer, sizeof(buffer),
-                         "P|%llu|%.1f|%.1f|%.1f|%.1f|%d|%d|%d|%d|%.1f|%d",
-                         p.steamID.ConvertToUint64(), p.x, p.y, p.renderedX, p.renderedY,
-                         p.health, p.kills, p.ready ? 1 : 0, p.money, p.speed, p.isAlive ? 1 : 0);
-    if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer))
-        return std::string(buffer);
-    return "";
+// Builds the replicated state message for the given player.
+Wire::PlayerUpdate CubeGame::MakePlayerUpdate(const Player& p) {
+    Wire::PlayerUpdate msg;
+    msg.player = p.steamID;
+    msg.x = p.x;
+    msg.y = p.y;
+    msg.renderedX = p.renderedX;
+    msg.renderedY = p.renderedY;
+    msg.health = p.health;
+    msg.kills = p.kills;
+    msg.money = p.money;
+    msg.speed = p.speed;
+    msg.ready = p.ready;
+    msg.alive = p.isAlive;
+    return msg;
 }
 
 //==============================================================================
@@ -68,9 +73,14 @@ std::string CubeGame::FormatPlayerUpdate(const Player& p) {
 //--------------------------------------
 // Constructor & Initialization
 //--------------------------------------
-CubeGame::CubeGame() : hud(font)
+CubeGame::CubeGame() : hud(font), renderStats(window)
 {
     networkManager = new NetworkManager(debugMode, this);
+    lobbyBrowser.setPingSender([this](CSteamID host, uint32_t nonce) {
+        Wire::Ping ping;
+        ping.nonce = nonce;
+        return networkManager->sendMessage(host, ping);
+    });
     entityManager = new EntityManager();
 
     // Initialize Steam API unless in debug mode.
@@ -86,6 +96,17 @@ CubeGame::CubeGame() : hud(font)
     if (!window.isOpen()) std::exit(1);
     window.setFramerateLimit(60);
 
+    // Pack the entity sprites into a single atlas texture.
+    sprites = buildEntitySprites(atlas);
+    if (!sprites.texture) {
+        std::cerr << "[ERROR] Failed to build entity atlas, using flat colours" << std::endl;
+    } else {
+        std::cout << "[DEBUG] Entity atlas: " << atlas.getRegionCount() << " sprites, "
+                  << atlas.getSize().x << "x" << atlas.getSize().y << ", "
+                  << atlas.getMemoryBytes() / 1024 << " KiB, built in "
+                  << atlas.getBuildTime().asMicroseconds() << " us" << std::endl;
+    }
+
     // Load the game font.
     if (!font.loadFromFile("Roboto-Regular.ttf")) {
         std::cerr << "[ERROR] Failed to load font!" << std::endl;
@@ -108,13 +129,6 @@ CubeGame::CubeGame() : hud(font)
     shootCooldown = 0.0f;
     deltaTime = 0.0f;
     // Removed SetupInitialHUD – HUD elements are now set up in the appropriate states.
-
-    // Set callback for enemy updates.
-    entityManager->setEnemyUpdateCallback([this](const std::string& msg) {
-        if (m_isHost) {
-            networkManager->broadcastMessage(msg);
-        }
-    });
 }
 
 // Returns the current GameplayState if active.
@@ -126,6 +140,8 @@ GameplayState* CubeGame::GetGameplayState() {
 // Destructor & Cleanup
 //--------------------------------------
 CubeGame::~CubeGame() {
+    if (renderThread)
+        renderThread->stop();
     delete networkManager;
     delete entityManager;
 
@@ -141,6 +157,10 @@ float CubeGame::GetDeltaTime() const {
     return deltaTime;
 }
 
+bool CubeGame::IsRenderThreadActive() const {
+    return renderThread && renderThread->isRunning();
+}
+
 //--------------------------------------
 // Main Game Loop
 //--------------------------------------
@@ -149,10 +169,19 @@ void CubeGame::Run() {
     const float fixedDt = 1.0f / 60.0f; // Fixed timestep: 60 updates per second
     float accumulator = 0.0f;
 
+    renderStats.setLogging(debugMode);
+    renderThread = std::make_unique<RenderThread>(window, renderStats, fixedDt);
+    renderThread->setSprites(sprites);
+
+    sf::Clock loopClock; // Absolute time base for the frame scheduler.
+
     while (window.isOpen()) {
-        // Process network and events
-        networkManager->processCallbacks();
-        networkManager->receiveMessages();
+        // Network is polled at its own rate, independent of how often we render.
+        if (scheduler.shouldPollNetwork(loopClock.getElapsedTime())) {
+            networkManager->processCallbacks();
+            if (networkManager->receiveMessages() > 0)
+                scheduler.requestRedraw();
+        }
 
         // Calculate elapsed time since last frame
         float frameTime = clock.restart().asSeconds();
@@ -160,27 +189,29 @@ void CubeGame::Run() {
         accumulator += frameTime;
 
         // Update game logic with fixed timestep
+        bool ticked = false;
         while (accumulator >= fixedDt) {
-            if (m_isHost) {
-                enemySyncTimer += fixedDt;
-                if (enemySyncTimer >= ENEMY_SYNC_INTERVAL) {
-                    networkManager->SyncEnemies();
-                    enemySyncTimer = 0.0f;
-                }
-            }
             if (shootCooldown > 0) shootCooldown -= fixedDt;
             if (state) state->Update(fixedDt); // Logic update with fixed timestep
+            if (m_isHost && currentState == GameState::Playing)
+                networkManager->UpdateSnapshots(); // Replicates the world every few ticks.
             accumulator -= fixedDt;
+            ticked = true;
         }
 
         // Handle events
         sf::Event event;
         while (window.pollEvent(event)) {
+            scheduler.onEvent(event);
             ProcessEvents(event);
             if (state) state->ProcessEvent(event);
         }
 
+        // Everything queued by this iteration's ticks and events leaves as one batch per peer.
+        networkManager->flushOutgoing();
+
         // State management
+        const State* previousState = state.get();
         switch (currentState) {
             case GameState::MainMenu:
                 if (!state || !dynamic_cast<MainMenuState*>(state.get()))
@@ -209,22 +240,65 @@ void CubeGame::Run() {
             default:
                 break;
         }
+        if (state.get() != previousState)
+            scheduler.requestRedraw();
+
+        // Gameplay is drawn by the render thread; menus stay on this thread.
+        GameplayState* gameplay = GetGameplayState();
+        scheduler.setContinuous(gameplay != nullptr);
+        if (threadedRendering && gameplay && window.isOpen() && !IsRenderThreadActive()) {
+            renderThread->start();
+        } else if (!gameplay && IsRenderThreadActive()) {
+            renderThread->stop();
+            window.setView(view);
+        }
 
         // Calculate interpolation factor (alpha) for rendering
         float alpha = accumulator / fixedDt; // Between 0 and 1
         if (state) {
             state->Interpolate(alpha); // New method to interpolate positions
-            state->Render();           // Render with interpolated positions
+            if (IsRenderThreadActive()) {
+                if (ticked) {
+                    gameplay->PublishSnapshot(renderThread->publishSlot());
+                    renderThread->publish();
+                }
+                renderThread->setMinFrameInterval(scheduler.isFocused() ? sf::Time::Zero
+                                                                        : scheduler.getConfig().unfocusedFrameInterval);
+                // No display() to pace this thread any more; wait for the next tick.
+                sf::sleep(sf::seconds(fixedDt - accumulator));
+            } else {
+                if (hud.consumeChanged())
+                    scheduler.requestRedraw();
+                if (scheduler.shouldRender(loopClock.getElapsedTime())) {
+                    state->Render();       // Render with interpolated positions
+                    scheduler.onRendered(loopClock.getElapsedTime());
+                } else {
+                    // Nothing changed on a static screen: sleep until the next tick or poll.
+                    scheduler.countSkippedFrame();
+                    sf::Time untilTick = sf::seconds(fixedDt - accumulator);
+                    sf::sleep(std::min(untilTick, scheduler.timeUntilNextWork(loopClock.getElapsedTime())));
+                }
+            }
         }
     }
+    if (renderThread)
+        renderThread->stop();
+    if (debugMode)
+        std::cout << "[DEBUG] Main loop rendered " << scheduler.getRenderedFrames()
+                  << " frames, skipped " << scheduler.getSkippedFrames() << std::endl;
+    if (debugMode)
+        renderStats.writeCsv("render_stats.csv");
 }
 
 //--------------------------------------
 // Event Handling & View Management
 //--------------------------------------
 void CubeGame::ProcessEvents(sf::Event& event) {
-    if (event.type == sf::Event::Closed)
+    if (event.type == sf::Event::Closed) {
+        if (renderThread)
+            renderThread->stop(); // The render thread must release the context first.
         window.close();
+    }
     if (event.type == sf::Event::Resized) {
         std::cout << "[DEBUG] Resized window\n";
         AdjustViewToWindow();
@@ -235,7 +309,8 @@ void CubeGame::ResetViewToDefault() {
     sf::Vector2u winSize = window.getSize();
     view.setSize(static_cast<float>(winSize.x), static_cast<float>(winSize.y));
     view.setCenter(static_cast<float>(winSize.x) / 2.f, static_cast<float>(winSize.y) / 2.f);
-    window.setView(view);
+    if (!IsRenderThreadActive())
+        window.setView(view);
 }
 
 void CubeGame::AdjustViewToWindow() {
@@ -257,7 +332,8 @@ void CubeGame::AdjustViewToWindow() {
         viewport.top = (1.f - heightRatio) / 2.f;
     }
     view.setViewport(viewport);
-    window.setView(view);
+    if (!IsRenderThreadActive())
+        window.setView(view); // Otherwise picked up from the next snapshot.
 }
 
 //--------------------------------------
@@ -269,6 +345,7 @@ void CubeGame::ToggleReady() {
     Player& localPlayer = entityManager->getPlayers()[localSteamID];
     localPlayer.ready = !localPlayer.ready;
     SteamMatchmaking()->SetLobbyMemberData(m_currentLobby, "ready", localPlayer.ready ? "1" : "0");
+    lobbyMembers.refreshMember(localSteamID);
     entityManager->getPlayers()[localSteamID].ready = localPlayer.ready;
     networkManager->SendPlayerUpdate();
 }
@@ -285,11 +362,9 @@ void CubeGame::ReturnToLobby() {
             ResetPlayerState(player);
             SteamMatchmaking()->SetLobbyMemberData(m_currentLobby, "ready", "0");
 
-            std::string updateMsg = FormatPlayerUpdate(player);
-            if (!updateMsg.empty()) {
-                networkManager->broadcastMessage(updateMsg);
-            }
+            networkManager->broadcastMessage(MakePlayerUpdate(player));
         }
+        lobbyMembers.refreshMember(localSteamID);
     }
 
     // Reset local player state.
@@ -318,17 +393,13 @@ void CubeGame::ResetGame() {
         player.steamID = id;  // Preserve Steam ID
         player.isAlive = true;  // Ensure player is alive after reset
 
-        std::string updateMsg = FormatPlayerUpdate(player);
-        if (!updateMsg.empty()) {
-            if (m_isHost) {
-                networkManager->broadcastMessage(updateMsg);  // Host broadcasts update.
-            } else if (id == localSteamID) {
-                // Client sends its update to the host.
-                const char* hostStr = SteamMatchmaking()->GetLobbyData(m_currentLobby, "host_steam_id");
-                if (hostStr && *hostStr) {
-                    CSteamID hostID(std::stoull(hostStr));
-                    networkManager->sendMessage(hostID, updateMsg);
-                }
+        if (m_isHost) {
+            networkManager->broadcastMessage(MakePlayerUpdate(player));  // Host broadcasts update.
+        } else if (id == localSteamID) {
+            // Client sends its update to the host.
+            CSteamID hostID = parseSteamID(SteamMatchmaking()->GetLobbyData(m_currentLobby, "host_steam_id"));
+            if (hostID.IsValid()) {
+                networkManager->sendMessage(hostID, MakePlayerUpdate(player));
             }
         }
     }
@@ -347,6 +418,8 @@ void CubeGame::ReturnToMainMenu() {
         SteamMatchmaking()->LeaveLobby(m_currentLobby);
         inLobby = false;
         m_currentLobby = k_steamIDNil;
+        lobbyMembers.clear();
+        networkManager->leftLobby();
     }
     currentState = GameState::MainMenu;
     gameStarted = false;
@@ -362,7 +435,7 @@ void CubeGame::ReturnToMainMenu() {
 
     currentLevel = 0;
     enemiesPerWave = 0;
-    lobbyList.clear();
+    lobbyBrowser.stop();
     ResetViewToDefault();
 }
 
@@ -377,6 +450,7 @@ void CubeGame::StartGame() {
     if (hasGameBeenPlayed) {
         ResetGame();  // Only reset if a game was already played.
     }
+    networkManager->ResetReplication(); // Snapshots from a previous game are no valid baseline.
     if (m_isHost) {
         // Check that all clients are connected.
         bool allConnected = true;
@@ -400,10 +474,7 @@ void CubeGame::StartGame() {
             ResetPlayerState(player);
             SteamMatchmaking()->SetLobbyMemberData(m_currentLobby, "ready", "0");
 
-            std::string updateMsg = FormatPlayerUpdate(player);
-            if (!updateMsg.empty()) {
-                networkManager->broadcastMessage(updateMsg);
-            }
+            networkManager->broadcastMessage(MakePlayerUpdate(player));
         }
 
         // Reset local player state.
@@ -411,32 +482,14 @@ void CubeGame::StartGame() {
         ResetPlayerState(localPlayer);
         entityManager->getPlayers()[localSteamID] = localPlayer;
         
-        // Spawn enemies and sync with clients.
+        // Spawn enemies; clients receive them with the first snapshot.
         entityManager->spawnEnemies(enemiesPerWave, entityManager->getPlayers(), localSteamID.ConvertToUint64());
-        networkManager->SyncEnemiesFull();
 
         // Send game start message.
-        char startBuffer[64];
-        int startBytes = snprintf(startBuffer, sizeof(startBuffer), "S|START");
-        if (startBytes > 0 && static_cast<size_t>(startBytes) < sizeof(startBuffer)) {
-            networkManager->SendGameplayMessage(std::string(startBuffer));
-        }
+        networkManager->SendGameplayMessage(Wire::Start());
 
-        // Broadcast enemy spawn messages.
-        uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-
-        for (auto& [eid, enemy] : entityManager->getEnemies()) {
-                enemy.spawnDelay = CubeGame::INITIAL_WAVE_DELAY;
-                char buffer[128];
-                int bytes = snprintf(buffer, sizeof(buffer),
-                                     "E|SPAWN|%llu|%.1f|%.1f|%d|%.2f|%d|%llu",
-                                     eid, enemy.x, enemy.y, enemy.health, enemy.spawnDelay,
-                                     static_cast<int>(enemy.type), timestamp);
-                if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                    networkManager->broadcastMessage(std::string(buffer));
-            }
-        }
+        for (auto& [eid, enemy] : entityManager->getEnemies())
+            enemy.spawnDelay = CubeGame::INITIAL_WAVE_DELAY;
     }
 
     // Transition to gameplay.
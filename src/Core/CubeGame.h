@@ -26,10 +26,19 @@
 #include "../States/GameState.h"
 #include "../Entities/Player.h"
 #include "../Hud/Hud.h"
+#include "../Networking/PersonaNameCache.h"
+#include "../Networking/LobbyMembershipCache.h"
+#include "../Networking/LobbyBrowser.h"
+#include "../Rendering/RenderQueue.h"
+#include "../Rendering/RenderStats.h"
+#include "../Rendering/TextureAtlas.h"
+#include "FrameScheduler.h"
+#include "../Rendering/EntitySprites.h"
 
 // Forward declaration of State classes.
 class State;
 class GameplayState;
+class RenderThread;
 
 /**
  * @brief The CubeGame class is the central class for the CubeShooter game.
@@ -41,7 +50,7 @@ public:
     //--------------------------------------------------------------------------
     // Public Helper Functions
     //--------------------------------------------------------------------------
-    std::string FormatPlayerUpdate(const Player& p);
+    Wire::PlayerUpdate MakePlayerUpdate(const Player& p);
     void ResetPlayerState(Player& p);
 
     // Allow NetworkManager direct access to private members.
@@ -87,11 +96,17 @@ public:
     // Accessor Methods
     //--------------------------------------------------------------------------
     HUD& GetHUD() { return hud; }
+    PersonaNameCache& GetPersonaNames() { return personaNames; }
+    LobbyMembershipCache& GetLobbyMembers() { return lobbyMembers; }
+    LobbyBrowser& GetLobbyBrowser() { return lobbyBrowser; }
+    RenderQueue& GetRenderQueue() { return renderQueue; }
+    RenderStats& GetRenderStats() { return renderStats; }
+    FrameScheduler& GetFrameScheduler() { return scheduler; }
+    const EntitySprites& GetSprites() const { return sprites; }
+    const TextureAtlas& GetAtlas() const { return atlas; }
     sf::RenderWindow& GetWindow() { return window; }
     sf::Font& GetFont() { return font; }
     sf::View& GetView() { return view; }
-    const std::vector<std::pair<CSteamID, std::string>>& GetLobbyList() const { return lobbyList; }
-    bool IsLobbyListUpdated() const { return lobbyListUpdated; }
     std::unordered_map<CSteamID, Player, CSteamIDHash>& GetPlayers() { return entityManager->getPlayers(); }
     std::unordered_map<uint64_t, Enemy>& GetEnemies() { return entityManager->getEnemies(); }
     std::unordered_map<uint64_t, Bullet>& GetBullets() { return entityManager->getBullets(); }
@@ -113,7 +128,6 @@ public:
     int& GetCurrentLevel() { return currentLevel; }
     int& GetEnemiesPerWave() { return enemiesPerWave; }
     float& GetShootCooldown() { return shootCooldown; }
-    std::vector<std::pair<CSteamID, std::string>>& GetLobbyList() { return lobbyList; }
     std::string& GetLobbyNameInput() { return lobbyNameInput; }
     bool IsDebugMode() const { return debugMode; }
     void SetDebugMode(bool debug) { debugMode = debug; }
@@ -147,11 +161,9 @@ public:
     //--------------------------------------------------------------------------
     // Manager Accessors
     //--------------------------------------------------------------------------
-    void SyncEnemies();
     NetworkManager* GetNetworkManager() { return networkManager; }
     EntityManager* GetEntityManager() { return entityManager; }
     bool AllPlayersReady();
-    bool lobbyListUpdated = false; // Flag for lobby list update.
     CSteamID GetCurrentLobby() const { return m_currentLobby; }
     float GetDeltaTime() const;
 
@@ -160,6 +172,23 @@ public:
     //--------------------------------------------------------------------------
     void AdjustViewToWindow();
 
+    /**
+     * @brief Checks whether the render thread currently owns the window.
+     *
+     * While true, simulation code must not draw to the window or change its view.
+     * @return true if gameplay is being rendered on the render thread.
+     */
+    bool IsRenderThreadActive() const;
+
+    /// The render thread (nullptr before the window exists); read-only counters.
+    const RenderThread* GetRenderThread() const { return renderThread.get(); }
+
+    /**
+     * @brief Enables or disables the dedicated render thread for gameplay.
+     * @param enabled When false, gameplay renders on the main thread.
+     */
+    void SetThreadedRendering(bool enabled) { threadedRendering = enabled; }
+
     //--------------------------------------------------------------------------
     // Game Identifier Constant
     //--------------------------------------------------------------------------
@@ -181,8 +210,6 @@ private:
     int nextBulletId = 0;
     bool debugMode = false;
     float shootCooldown = 0.0f;
-    float enemySyncTimer = 0.0f;
-    const float ENEMY_SYNC_INTERVAL = 3.0f;
 
     //--------------------------------------------------------------------------
     // Steam & Lobby Related Variables
@@ -190,7 +217,6 @@ private:
     CSteamID m_currentLobby = k_steamIDNil;
     CSteamID m_hostID = k_steamIDNil;
     int m_joinAttempts = 0;
-    std::vector<std::pair<CSteamID, std::string>> lobbyList;
     std::string lobbyNameInput;
     std::unique_ptr<State> state;
    
@@ -198,9 +224,19 @@ private:
     // HUD, Rendering and View Management
     //--------------------------------------------------------------------------
     HUD hud;
+    PersonaNameCache personaNames; ///< Steam names, refreshed on PersonaStateChange_t.
+    LobbyMembershipCache lobbyMembers; ///< Lobby members and ready flags, maintained by callbacks.
+    LobbyBrowser lobbyBrowser; ///< Background-refreshed lobby list with measured host latency.
+    RenderQueue renderQueue; ///< Main-thread draw queue shared by all states.
     sf::View view;
     sf::RenderWindow window;
+    RenderStats renderStats; ///< Instrumented window wrapper every Render() draws through.
     sf::Font font;
+    TextureAtlas atlas;      ///< Entity sprites packed into one texture, built at startup.
+    EntitySprites sprites;   ///< Resolved atlas rectangles for entity visuals.
+    bool threadedRendering = true;              ///< Render gameplay on a dedicated thread (the default path).
+    FrameScheduler scheduler;                   ///< On-demand rendering, focus throttling and network poll rate.
+    std::unique_ptr<RenderThread> renderThread; ///< Declared after window so it is joined first.
 
     //--------------------------------------------------------------------------
     // Local Player & Processed Messages
@@ -0,0 +1,64 @@
+#include "FrameScheduler.h"
+#include <algorithm>
+
+//-------------------------------------------------------------------------
+// Mode & Input
+//-------------------------------------------------------------------------
+void FrameScheduler::setContinuous(bool continuous) {
+    if (m_continuous != continuous) {
+        m_continuous = continuous;
+        m_redrawRequested = true;
+    }
+}
+
+void FrameScheduler::onEvent(const sf::Event& event) {
+    switch (event.type) {
+        case sf::Event::LostFocus:
+            m_focused = false;
+            break;
+        case sf::Event::GainedFocus:
+            m_focused = true;
+            break;
+        default:
+            break;
+    }
+    // Any event (input, resize, focus) can change what is on screen, e.g. hover colours.
+    m_redrawRequested = true;
+}
+
+//-------------------------------------------------------------------------
+// Scheduling
+//-------------------------------------------------------------------------
+bool FrameScheduler::shouldPollNetwork(sf::Time now) {
+    if (m_networkPolled && now - m_lastNetworkPoll < m_config.networkInterval)
+        return false;
+    m_networkPolled = true;
+    m_lastNetworkPoll = now;
+    return true;
+}
+
+sf::Time FrameScheduler::nextRenderTime() const {
+    if (m_continuous)
+        return m_focused ? m_lastRender : m_lastRender + m_config.unfocusedFrameInterval;
+    if (m_redrawRequested)
+        return m_lastRender;
+    return m_lastRender + (m_focused ? m_config.idleRedrawInterval : m_config.unfocusedRedrawInterval);
+}
+
+bool FrameScheduler::shouldRender(sf::Time now) const {
+    if (m_renderedFrames == 0)
+        return true;
+    return now >= nextRenderTime();
+}
+
+void FrameScheduler::onRendered(sf::Time now) {
+    m_lastRender = now;
+    m_redrawRequested = false;
+    ++m_renderedFrames;
+}
+
+sf::Time FrameScheduler::timeUntilNextWork(sf::Time now) const {
+    sf::Time nextNetwork = m_lastNetworkPoll + m_config.networkInterval;
+    sf::Time next = std::min(nextNetwork, nextRenderTime());
+    return next > now ? next - now : sf::Time::Zero;
+}
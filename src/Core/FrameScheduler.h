@@ -0,0 +1,91 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/System/Time.hpp>
+
+/**
+ * @brief Decides when the main loop renders, polls the network and sleeps.
+ *
+ * Gameplay renders continuously. Static screens (menus, lobby, game over)
+ * render on demand: after input, after a network message or HUD change, when
+ * the state changes, and on a slow heartbeat that catches anything not
+ * signalled. While the window is unfocused, continuous rendering is throttled
+ * and the heartbeat slows down. Network polling keeps its own fixed rate
+ * regardless of either, so peers never see the idle client lag.
+ *
+ * All times are absolute, from the caller's clock.
+ */
+class FrameScheduler {
+public:
+    /**
+     * @brief Tunables.
+     */
+    struct Config {
+        sf::Time networkInterval = sf::seconds(1.f / 60.f);      ///< Network poll period (focused or not).
+        sf::Time idleRedrawInterval = sf::seconds(0.5f);         ///< Heartbeat for on-demand screens.
+        sf::Time unfocusedFrameInterval = sf::seconds(0.1f);     ///< Continuous rendering cap when unfocused.
+        sf::Time unfocusedRedrawInterval = sf::seconds(2.f);     ///< Heartbeat for on-demand screens when unfocused.
+    };
+
+    FrameScheduler() = default;
+    explicit FrameScheduler(const Config& config) : m_config(config) {}
+
+    /**
+     * @brief Selects continuous (gameplay) or on-demand (static screen) rendering.
+     */
+    void setContinuous(bool continuous);
+
+    /**
+     * @brief Tracks focus and turns user input into redraw requests.
+     */
+    void onEvent(const sf::Event& event);
+
+    /// Forces the next frame to render (state change, network update, HUD change...).
+    void requestRedraw() { m_redrawRequested = true; }
+
+    /**
+     * @brief True once per network interval.
+     * @param now Current time.
+     */
+    bool shouldPollNetwork(sf::Time now);
+
+    /**
+     * @brief True if a frame should be rendered now. Call onRendered() after drawing.
+     * @param now Current time.
+     */
+    bool shouldRender(sf::Time now) const;
+
+    /**
+     * @brief Records a rendered frame and clears the pending request.
+     */
+    void onRendered(sf::Time now);
+
+    /**
+     * @brief Time the loop may sleep before anything (other than the next tick) is due.
+     * @param now Current time.
+     */
+    sf::Time timeUntilNextWork(sf::Time now) const;
+
+    const Config& getConfig() const { return m_config; }
+    bool isFocused() const { return m_focused; }
+    bool isContinuous() const { return m_continuous; }
+    unsigned long long getRenderedFrames() const { return m_renderedFrames; }
+    unsigned long long getSkippedFrames() const { return m_skippedFrames; }  ///< Loop passes that did not render.
+    void countSkippedFrame() { ++m_skippedFrames; }
+
+private:
+    sf::Time nextRenderTime() const;
+
+    Config m_config;
+    bool m_continuous = false;
+    bool m_focused = true;
+    bool m_redrawRequested = true;
+    sf::Time m_lastRender;
+    sf::Time m_lastNetworkPoll;
+    bool m_networkPolled = false;
+    unsigned long long m_renderedFrames = 0;
+    unsigned long long m_skippedFrames = 0;
+};
+
+#endif // FRAMESCHEDULER_H
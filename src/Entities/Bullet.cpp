@@ -28,7 +28,7 @@ void Bullet::initialize(float startX, float startY, float targetX, float targetY
     }
 
     // Set up the bullet's shape.
-    shape.setSize(sf::Vector2f(5.f, 5.f));
+    shape.setSize(sf::Vector2f(BULLET_SIZE, BULLET_SIZE));
     shape.setFillColor(sf::Color::Yellow);
     shape.setPosition(renderedX, renderedY);
 
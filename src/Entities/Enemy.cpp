@@ -1,4 +1,5 @@
 #include "Enemy.h"
+#include "../Utils/FastHash.h"
 #include <cmath>
 #include <iostream>
 
@@ -72,7 +73,8 @@ void Enemy::update(float dt) {
 /**
  * @brief Special update routine for Splitter enemies.
  *
- * Handles the shake effect prior to splitting by randomly offsetting the shape's position.
+ * Handles the shake effect prior to splitting by offsetting the shape's position
+ * with a deterministic per-enemy jitter.
  *
  * @param dt Delta time (time elapsed since the last update).
  */
@@ -90,8 +92,9 @@ void Enemy::updateSplitter(float dt) {
     if (isSplitting) {
         shakeTimer -= dt;
         if (shakeTimer > 0) {
-            float shakeX = (rand() % 10 - 5) * (shakeTimer / shakeDuration);
-            float shakeY = (rand() % 10 - 5) * (shakeTimer / shakeDuration);
+            uint32_t shakeTick = static_cast<uint32_t>(shakeTimer * 60.f);
+            float shakeX = hashJitter(id, shakeTick, 0) * (shakeTimer / shakeDuration);
+            float shakeY = hashJitter(id, shakeTick, 1) * (shakeTimer / shakeDuration);
             shape.setPosition(renderedX + shakeX, renderedY + shakeY);
         } else {
             isSplitting = false;
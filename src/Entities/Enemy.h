@@ -19,7 +19,6 @@ struct Enemy {
     // --- Position and Movement Data ---
     float x, y;                  // Logical position
     float renderedX, renderedY;  // Interpolated (rendered) position
-    float lastSentX, lastSentY;  // Last position sent over the network
     float velocityX, velocityY;  // Current velocity components
     float lastX, lastY;          // Previous position (for interpolation)
     float interpolationTime;     // Time accumulator for interpolation
@@ -28,6 +27,8 @@ struct Enemy {
     int health;                  // Health value of the enemy
     uint64_t id;                 // Unique identifier
     float spawnDelay;            // Delay before the enemy becomes active
+    uint16_t netTick = 0;        // Host tick (Wire::Tick) of the last network update applied to it
+    bool hasNetTick = false;     // False until a network update has been applied
 
     // --- Splitting/Shake Mechanics ---
     float splitTimer = 0.f;      // Timer for when to split or trigger shake effect
@@ -41,6 +42,7 @@ struct Enemy {
 
     // --- Enemy Behavior Specifics ---
     enum Type { Swarmlet, Sniper, Bomber, Brute, GravityWell, Default, Splitter } type;
+    static_assert(Splitter + 1 == ENEMY_TYPE_COUNT, "ENEMY_TYPE_COUNT must match Enemy::Type");
     float attackCooldown;        // Cooldown for special attacks (e.g., Sniper shooting)
     bool exploded;               // For tracking explosion state (e.g., Bomber)
     float pullRadius;            // Effective radius for gravitational pull (GravityWell)
@@ -1,4 +1,5 @@
 #include "EntityManager.h"
+#include "../Utils/Arena.h"
 #include <cmath>
 #include <random>
 #include <limits>
@@ -9,7 +10,7 @@
 //-------------------------------------------------------------------------
 // Constructor & Destructor
 //-------------------------------------------------------------------------
-EntityManager::EntityManager() : lastEnemyUpdateTime(0.0f), enemyUpdateInterval(0.5f) {}
+EntityManager::EntityManager() {}
 
 EntityManager::~EntityManager() {}
 
@@ -39,6 +40,8 @@ Player& EntityManager::getLocalPlayer(CubeGame* game) {
 //-------------------------------------------------------------------------
 
 void EntityManager::updateEntities(float dt) {
+    ++m_simTick;
+
     // Update each bullet and remove it if its lifetime has expired.
     for (auto it = m_bullets.begin(); it != m_bullets.end();) {
         it->second.update(dt);
@@ -52,9 +55,6 @@ void EntityManager::updateEntities(float dt) {
     // Refresh the collision grid for the current frame.
     updateCollisionGrid();
 
-    // Increment the enemy update timer.
-    lastEnemyUpdateTime += dt;
-    bool shouldSendUpdate = lastEnemyUpdateTime >= enemyUpdateInterval;
     std::vector<uint64_t> enemiesToRemove;
 
     for (const auto& [playerId, player] : m_players) {
@@ -98,34 +98,18 @@ void EntityManager::updateEntities(float dt) {
                             newEnemy.color = enemy.color;
                             newEnemy.x = enemy.renderedX + 20.f; // Offset slightly
                             newEnemy.y = enemy.renderedY + 20.f;
+                            clampToArena(newEnemy.x, newEnemy.y);
                             newEnemy.renderedX = newEnemy.x;
                             newEnemy.renderedY = newEnemy.y;
                             newEnemy.lastX = newEnemy.x;
                             newEnemy.lastY = newEnemy.y;
-                            newEnemy.lastSentX = newEnemy.x;
-                            newEnemy.lastSentY = newEnemy.y;
                             newEnemy.interpolationTime = 0.f;
                             newEnemy.spawnDelay = 0.1f; // Small delay for spawn effect
+                            if (onEnemySplit)
+                                onEnemySplit(enemy);
 
                             std::cout << "Splitter " << enemy.id << " split at (" << enemy.renderedX << ", " << enemy.renderedY << ")\n";
                             std::cout << "NewEnemy ID " << newId << " spawned at (" << newEnemy.x << ", " << newEnemy.y << ")\n";
-
-                            // Network update for the new enemy
-                            uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                std::chrono::system_clock::now().time_since_epoch()).count();
-                                char buffer[128];
-                                int bytes = snprintf(buffer, sizeof(buffer), "E|SPAWN|%llu|%.1f|%.1f|%d|%.2f|%d|%llu",
-                                                    newId, newEnemy.x, newEnemy.y, newEnemy.health, newEnemy.spawnDelay,
-                                                    static_cast<int>(newEnemy.type), timestamp);
-                                if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer) && onEnemyUpdate)
-                                    onEnemyUpdate(std::string(buffer));
-                            
-                                char origBuffer[128];
-                                int origBytes = snprintf(origBuffer, sizeof(origBuffer), "E|UPDATE|%llu|%.1f|%.1f|%d|%.2f|%d|%llu",
-                                                         enemy.id, enemy.x, enemy.y, enemy.health, enemy.spawnDelay,
-                                                         static_cast<int>(enemy.type), timestamp); // Added type
-                                if (origBytes > 0 && static_cast<size_t>(origBytes) < sizeof(origBuffer) && onEnemyUpdate)
-                                    onEnemyUpdate(std::string(origBuffer));
                         }
 
                         // Move enemy toward nearest player
@@ -172,22 +156,8 @@ void EntityManager::updateEntities(float dt) {
                         float separationStrength = 100.0f;
                         enemy.x += separationForce.x * separationStrength * dt;
                         enemy.y += separationForce.y * separationStrength * dt;
+                        clampToArena(enemy.x, enemy.y);
 
-                        // Network synchronization
-                        float posDeltaX = enemy.x - enemy.lastSentX;
-                        float posDeltaY = enemy.y - enemy.lastSentY;
-                        bool positionChanged = std::abs(posDeltaX) > 10.0f || std::abs(posDeltaY) > 10.0f;
-                        if (shouldSendUpdate && positionChanged && onEnemyUpdate) {
-                            enemy.lastSentX = enemy.x;
-                            enemy.lastSentY = enemy.y;
-                            uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                std::chrono::system_clock::now().time_since_epoch()).count();
-                            char buffer[128];
-                            int bytes = snprintf(buffer, sizeof(buffer), "E|UPDATE|%llu|%.1f|%.1f|%d|%.2f|%llu",
-                                                 enemy.id, enemy.x, enemy.y, enemy.health, enemy.spawnDelay, timestamp);
-                            if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer))
-                                onEnemyUpdate(std::string(buffer));
-                        }
                         ++it;
                     }
                 }
@@ -201,10 +171,6 @@ void EntityManager::updateEntities(float dt) {
             std::cout << "[DEBUG] Deferred removal of enemy " << id << "\n";
         }
     }
-
-    if (shouldSendUpdate) {
-        lastEnemyUpdateTime = 0.0f;
-    }
 }
 
 
@@ -246,12 +212,11 @@ void EntityManager::spawnEnemies(int enemiesPerWave, const std::unordered_map<CS
         float dist = distDist(gen);
         e.x = avgPos.x + std::cos(angle) * dist;
         e.y = avgPos.y + std::sin(angle) * dist;
+        clampToArena(e.x, e.y);
         e.renderedX = e.x;
         e.renderedY = e.y;
         e.lastX = e.x;
         e.lastY = e.y;
-        e.lastSentX = e.x;
-        e.lastSentY = e.y;
         e.shape.setPosition(e.x, e.y);
         // Generate enemy ID based on hostID and enemy index.
         e.id = ((hostID & 0xFFFF) << 16) | (i & 0xFFFF);
@@ -263,10 +228,8 @@ void EntityManager::spawnEnemies(int enemiesPerWave, const std::unordered_map<CS
 // Interpolate Entities
 //-------------------------------------------------------------------------
 void EntityManager::interpolateEntities(float alpha) {
-    const float fixedDt = 1.0f / 60.0f; // Match the fixed timestep
-    updateEntities(fixedDt); // Update logic with fixed timestep
-
-    // Interpolate for rendering
+    // Simulation runs in GameplayState::Update at the fixed timestep; this only
+    // blends the last two simulated positions.
     for (auto& [id, player] : m_players) {
         player.renderedX = player.lastX + (player.x - player.lastX) * alpha;
         player.renderedY = player.lastY + (player.y - player.lastY) * alpha;
@@ -288,20 +251,71 @@ void EntityManager::interpolateEntities(float alpha) {
 //-------------------------------------------------------------------------
 void EntityManager::updateCollisionGrid() {
     collisionGrid.clear();
-    const float cellSize = 100.f;
     // Populate the grid with enemy positions.
     for (const auto& [id, enemy] : m_enemies) {
         if (enemy.health <= 0) continue;
-        int key = (int(enemy.renderedX / cellSize)) * 1000 + (int(enemy.renderedY / cellSize));
+        int key = cellKey(cellCoord(enemy.renderedX), cellCoord(enemy.renderedY));
         collisionGrid[key].enemyIds.push_back(id);
     }
     // Populate the grid with bullet positions.
     for (const auto& [id, bullet] : m_bullets) {
-        int key = (int(bullet.renderedX / cellSize)) * 1000 + (int(bullet.renderedY / cellSize));
+        int key = cellKey(cellCoord(bullet.renderedX), cellCoord(bullet.renderedY));
         collisionGrid[key].bulletIds.push_back(id);
     }
 }
 
+//-------------------------------------------------------------------------
+// Spatial Queries
+//-------------------------------------------------------------------------
+std::size_t EntityManager::enemyCountInCell(int cx, int cy) const {
+    auto it = collisionGrid.find(cellKey(cx, cy));
+    return it == collisionGrid.end() ? 0 : it->second.enemyIds.size();
+}
+
+void EntityManager::queryRegion(const sf::FloatRect& region,
+                                std::vector<uint64_t>& enemyIds,
+                                std::vector<uint64_t>& bulletIds) const {
+    auto collectCell = [&](const GridCell& cell) {
+        for (uint64_t id : cell.enemyIds) {
+            auto it = m_enemies.find(id);
+            if (it != m_enemies.end() && it->second.health > 0 &&
+                region.intersects(it->second.getBounds()))
+                enemyIds.push_back(id);
+        }
+        for (uint64_t id : cell.bulletIds) {
+            auto it = m_bullets.find(id);
+            if (it != m_bullets.end() &&
+                region.intersects(sf::FloatRect(it->second.renderedX, it->second.renderedY, BULLET_SIZE, BULLET_SIZE)))
+                bulletIds.push_back(id);
+        }
+    };
+
+    // Entities are binned by their top-left corner, so widen the cell range by
+    // one on the low side to catch entities that overhang into the region.
+    int minX = cellCoord(region.left) - 1;
+    int maxX = cellCoord(region.left + region.width);
+    int minY = cellCoord(region.top) - 1;
+    int maxY = cellCoord(region.top + region.height);
+    long long cellsCovered = static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1);
+
+    // For very large regions (e.g. zoomed far out) walking the occupied cells is
+    // cheaper than walking every covered cell. Keys alias beyond 1000 rows, so
+    // the per-cell walk is only used for regions shorter than that.
+    if (cellsCovered > static_cast<long long>(collisionGrid.size()) || (maxY - minY) >= 1000) {
+        for (const auto& [key, cell] : collisionGrid)
+            collectCell(cell);
+        return;
+    }
+
+    for (int cx = minX; cx <= maxX; ++cx) {
+        for (int cy = minY; cy <= maxY; ++cy) {
+            auto it = collisionGrid.find(cellKey(cx, cy));
+            if (it != collisionGrid.end())
+                collectCell(it->second);
+        }
+    }
+}
+
 //-------------------------------------------------------------------------
 // Collision Detection
 //-------------------------------------------------------------------------
@@ -373,10 +387,10 @@ void EntityManager::checkCollisions(
 }
 
 //-------------------------------------------------------------------------
-// Set Enemy Update Callback
+// Set Enemy Split Callback
 //-------------------------------------------------------------------------
-void EntityManager::setEnemyUpdateCallback(std::function<void(const std::string&)> callback) {
-    onEnemyUpdate = callback;
+void EntityManager::setEnemySplitCallback(std::function<void(const Enemy&)> callback) {
+    onEnemySplit = callback;
 }
 
 //-------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <vector>
 #include "Player.h"
 #include "Bullet.h"
 #include "Enemy.h"
@@ -37,8 +38,10 @@ public:
     // Accessor Methods
     //-------------------------------------------------------------------------
     std::unordered_map<CSteamID, Player, CSteamIDHash>& getPlayers(); ///< Returns reference to the players map.
+    const std::unordered_map<CSteamID, Player, CSteamIDHash>& getPlayers() const { return m_players; } ///< Read-only players map.
     std::unordered_map<uint64_t, Bullet>& getBullets();                 ///< Returns reference to the bullets map.
     std::unordered_map<uint64_t, Enemy>& getEnemies();                    ///< Returns reference to the enemies map.
+    const std::unordered_map<uint64_t, Enemy>& getEnemies() const { return m_enemies; } ///< Read-only enemies map.
     Player& getLocalPlayer(CubeGame* game);                               ///< Returns the local player.
 
     //-------------------------------------------------------------------------
@@ -58,9 +61,41 @@ public:
     //-------------------------------------------------------------------------
     // Callback & Interpolation Methods
     //-------------------------------------------------------------------------
-    void setEnemyUpdateCallback(std::function<void(const std::string&)> callback); ///< Sets the enemy update callback.
+    void setEnemySplitCallback(std::function<void(const Enemy&)> callback);         ///< Sets the callback fired when a Splitter divides.
     bool areEntitiesInitialized() const; ///< Returns true if there is at least one player.
-    void interpolateEntities(float dt);  ///< Interpolates positions for smooth rendering.
+    uint32_t getSimTick() const { return m_simTick; } ///< Number of updateEntities() steps so far; stamps network messages.
+    void interpolateEntities(float alpha); ///< Blends previous/current positions into rendered positions.
+
+    //-------------------------------------------------------------------------
+    // Spatial Queries
+    //-------------------------------------------------------------------------
+    /**
+     * @brief Collects the enemies and bullets whose bounds intersect a region.
+     *
+     * Uses the collision grid, so the cost depends on the number of cells the
+     * region covers and the entities inside them, not on the total entity count.
+     *
+     * @param region World-space rectangle to query.
+     * @param enemyIds Receives the IDs of intersecting live enemies (appended).
+     * @param bulletIds Receives the IDs of intersecting bullets (appended).
+     */
+    void queryRegion(const sf::FloatRect& region,
+                     std::vector<uint64_t>& enemyIds,
+                     std::vector<uint64_t>& bulletIds) const;
+
+    /**
+     * @brief Number of live enemies in one collision grid cell (as of the last grid rebuild).
+     * @param cx Cell x coordinate.
+     * @param cy Cell y coordinate.
+     */
+    std::size_t enemyCountInCell(int cx, int cy) const;
+
+    static constexpr float COLLISION_CELL_SIZE = 100.f; ///< Side length of a collision grid cell.
+
+    /// Grid cell coordinate containing a world coordinate.
+    static int cellCoord(float v) { return int(v / COLLISION_CELL_SIZE); }
+    /// Collision grid key of a cell: (x/100)*1000 + (y/100).
+    static int cellKey(int cx, int cy) { return cx * 1000 + cy; }
 
 private:
     //-------------------------------------------------------------------------
@@ -79,12 +114,11 @@ private:
     //-------------------------------------------------------------------------
     // Private Data Members
     //-------------------------------------------------------------------------
-    float enemyUpdateInterval = 0.5f; ///< Interval for enemy network updates.
     std::unordered_map<CSteamID, Player, CSteamIDHash> m_players; ///< Container for players.
     std::unordered_map<uint64_t, Bullet> m_bullets;                 ///< Container for bullets.
     std::unordered_map<uint64_t, Enemy> m_enemies;                    ///< Container for enemies.
-    float lastEnemyUpdateTime;                                      ///< Accumulator for enemy updates.
-    std::function<void(const std::string&)> onEnemyUpdate;          ///< Callback for enemy update messages.
+    uint32_t m_simTick = 0;                                         ///< Simulation step counter.
+    std::function<void(const Enemy&)> onEnemySplit;                 ///< Callback for Splitter divisions (visual effects).
 };
 
 #endif // ENTITYMANAGER_H
@@ -1,6 +1,7 @@
 #include "Player.h"
 #include <cmath>
 #include "../Core/CubeGame.h" // For access to game functions and context
+#include "../Utils/Arena.h"
 
 /**
  * @brief Initializes the player with default values.
@@ -9,7 +10,7 @@
  * currency, and ready status.
  */
 void Player::initialize() {
-    shape.setSize(sf::Vector2f(20.0f, 20.0f));
+    shape.setSize(sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE));
     shape.setFillColor(sf::Color::Blue);
     x = SCREEN_WIDTH / 2.f;
     y = SCREEN_HEIGHT / 2.f;
@@ -25,7 +26,7 @@ void Player::initialize() {
 /**
  * @brief Handles movement based on keyboard input.
  *
- * Updates the player's position using WASD keys and sets the shape's position.
+ * Updates the player's position using WASD keys, kept inside the arena.
  *
  * @param dt Delta time since last update.
  * @return True if movement occurred, false otherwise.
@@ -39,6 +40,7 @@ bool Player::move(float dt) {
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) { y += effectiveSpeed * dt; moved = true; }
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) { x -= effectiveSpeed * dt; moved = true; }
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) { x += effectiveSpeed * dt; moved = true; }
+    clampToArena(x, y);
     return moved;
 }
 
@@ -120,12 +122,15 @@ void Player::ShootBullet(CubeGame* game) {
     // In multiplayer, broadcast the bullet fire message.
     if (game->GetPlayers().size() > 1) {
         static uint32_t localMessageCounter = 0;
-        uint32_t messageID = (static_cast<uint32_t>(shooterSteamID & 0xFFFF) << 16) | (localMessageCounter++ & 0xFFFF);
-        char buffer[128];
-        int bytes = snprintf(buffer, sizeof(buffer), "B|fire|%u|%llu|%d|%.1f|%.1f|%.1f|%.1f|%.1f",
-                             messageID, shooterSteamID, bulletIdx, b.x, b.y, targetX, targetY, b.lifetime);
-        if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-            game->GetNetworkManager()->SendGameplayMessage(std::string(buffer));
-        }
+        Wire::BulletFire fire;
+        fire.messageId = (static_cast<uint32_t>(shooterSteamID & 0xFFFF) << 16) | (localMessageCounter++ & 0xFFFF);
+        fire.shooter = steamID;
+        fire.bulletIndex = static_cast<uint32_t>(bulletIdx);
+        fire.startX = b.x;
+        fire.startY = b.y;
+        fire.targetX = targetX;
+        fire.targetY = targetY;
+        fire.lifetime = b.lifetime;
+        game->GetNetworkManager()->SendGameplayMessage(fire, sf::Vector2f(b.x, b.y));
     }
 }
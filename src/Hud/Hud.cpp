@@ -1,110 +1,188 @@
 #include "HUD.h"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 //-------------------------------------------------------------------------
 // Constructor
 //-------------------------------------------------------------------------
 HUD::HUD(sf::Font& font)
-    : m_font(font)
+    : m_font(font),
+      m_screenText(font),
+      m_viewText(font)
 {
 }
 
 //-------------------------------------------------------------------------
 // HUD Element Management
 //-------------------------------------------------------------------------
-void HUD::addElement(const std::string& id,
-                     const std::string& content,
-                     unsigned int size,
-                     sf::Vector2f pos,
-                     GameState visibleState,
-                     RenderMode mode,
-                     bool hoverable)
+HUD::Handle HUD::addElement(const std::string& id,
+                            const std::string& content,
+                            unsigned int size,
+                            sf::Vector2f pos,
+                            GameState visibleState,
+                            RenderMode mode,
+                            bool hoverable)
 {
-    sf::Text text;
-    text.setFont(m_font);
-    text.setString(content);
-    text.setCharacterSize(size);
-    text.setFillColor(sf::Color::Black);
-    text.setStyle(sf::Text::Regular);
-
     HUDElement element;
-    element.text         = text;
+    element.string       = content;
+    element.characterSize = size;
+    element.layoutDirty  = true;
     element.pos          = pos;
     element.visibleState = visibleState;
     element.mode         = mode;
     element.hoverable    = hoverable;
     element.baseColor    = sf::Color::Black;
     element.hoverColor   = sf::Color(60, 60, 60);
+    element.keyHash      = key(id).hash;
+    element.name         = id;
+
+    auto it = m_byKey.find(element.keyHash);
+    if (it != m_byKey.end()) {
+        if (m_elements[it->second].name != id)
+            std::cerr << "[ERROR] HUD name hash collision: " << id << " vs " << m_elements[it->second].name << std::endl;
+        m_elements[it->second] = std::move(element);
+        m_drawOrderDirty = true; // Visible state or mode may have changed.
+        m_changed = true;
+        return it->second;
+    }
+
+    m_changed = true;
+    Handle handle = static_cast<Handle>(m_elements.size());
+    m_elements.push_back(std::move(element));
+    m_byKey.emplace(m_elements.back().keyHash, handle);
+    m_drawOrder.push_back(handle);
+    m_drawOrderDirty = true;
+    return handle;
+}
 
-    m_elements[id] = element;
+HUD::Handle HUD::find(Key id) const
+{
+    auto it = m_byKey.find(id.hash);
+    return it != m_byKey.end() ? it->second : InvalidHandle;
 }
 
-void HUD::updateText(const std::string& id, const std::string& content)
+void HUD::updateText(Handle handle, const sf::String& content)
 {
-    auto it = m_elements.find(id);
-    if (it != m_elements.end()) {
-        it->second.text.setString(content);
+    if (handle < m_elements.size() && m_elements[handle].string != content) {
+        m_elements[handle].string = content;
+        m_elements[handle].layoutDirty = true;
+        m_changed = true;
     }
 }
 
-void HUD::updateBaseColor(const std::string& id, const sf::Color& color)
+void HUD::updateBaseColor(Handle handle, const sf::Color& color)
 {
-    auto it = m_elements.find(id);
-    if (it != m_elements.end()) {
-        it->second.baseColor = color;
-        it->second.text.setFillColor(color);
+    if (handle < m_elements.size() && m_elements[handle].baseColor != color) {
+        m_elements[handle].baseColor = color;
+        m_changed = true;
     }
 }
 
-void HUD::updateElementPosition(const std::string& id, const sf::Vector2f& pos)
+void HUD::updateElementPosition(Handle handle, const sf::Vector2f& pos)
 {
-    auto it = m_elements.find(id);
-    if (it != m_elements.end()) {
-        it->second.pos = pos;
+    if (handle < m_elements.size() && m_elements[handle].pos != pos) {
+        m_elements[handle].pos = pos;
+        m_changed = true;
     }
 }
 
+void HUD::sortDrawOrder()
+{
+    std::stable_sort(m_drawOrder.begin(), m_drawOrder.end(), [this](Handle a, Handle b) {
+        const HUDElement& ea = m_elements[a];
+        const HUDElement& eb = m_elements[b];
+        if (ea.visibleState != eb.visibleState)
+            return ea.visibleState < eb.visibleState;
+        return ea.mode < eb.mode;
+    });
+    m_drawOrderDirty = false;
+}
+
+std::pair<const HUD::Handle*, const HUD::Handle*> HUD::visibleRange(GameState state)
+{
+    if (m_drawOrderDirty)
+        sortDrawOrder();
+    auto first = std::partition_point(m_drawOrder.begin(), m_drawOrder.end(),
+        [&](Handle h) { return m_elements[h].visibleState < state; });
+    auto last = std::partition_point(first, m_drawOrder.end(),
+        [&](Handle h) { return m_elements[h].visibleState == state; });
+    const Handle* base = m_drawOrder.data();
+    return { base + (first - m_drawOrder.begin()), base + (last - m_drawOrder.begin()) };
+}
+
 //-------------------------------------------------------------------------
 // Rendering Methods
 //-------------------------------------------------------------------------
-void HUD::render(sf::RenderWindow& window, const sf::View& view, GameState currentState) {
-    sf::View originalView = window.getView();
+void HUD::submit(RenderQueue& queue, const sf::RenderWindow& window, const sf::View& view, GameState currentState) {
+    const RenderQueue::ViewId screenView = queue.registerView(window.getDefaultView());
+    const RenderQueue::ViewId gameView = queue.registerView(view);
     sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() * 0.5f);
 
-    for (auto& [id, element] : m_elements) {
-        if (element.visibleState == currentState) {
-            sf::Text& text = element.text;
-            if (element.mode == RenderMode::ScreenSpace) {
-                window.setView(window.getDefaultView());
-                text.setPosition(element.pos);
-            } else {
-                window.setView(view);
-                text.setPosition(viewTopLeft + element.pos);
-            }
-            if (element.hoverable && isMouseOverText(window, text))
-                text.setFillColor(element.hoverColor);
-            else
-                text.setFillColor(element.baseColor);
-            window.draw(text);
+    m_screenText.begin();
+    m_viewText.begin();
+    auto [first, last] = visibleRange(currentState);
+    for (const Handle* h = first; h != last; ++h) {
+        HUDElement& element = m_elements[*h];
+        ensureLayout(element);
+        if (element.layout.vertices.empty())
+            continue;
+        if (element.mode == RenderMode::ScreenSpace) {
+            const bool hovered = element.hoverable && isMouseOverText(window, element);
+            m_screenText.append(element.layout, element.pos, hovered ? element.hoverColor : element.baseColor);
+        } else {
+            m_viewText.append(element.layout, viewTopLeft + element.pos, element.baseColor);
         }
     }
-    window.setView(originalView);
+    m_screenText.submit(queue, RenderQueue::Layer::ScreenUI, screenView);
+    m_viewText.submit(queue, RenderQueue::Layer::WorldUI, gameView);
+}
+
+void HUD::collectTexts(const sf::RenderWindow& window, GameState currentState, std::vector<RenderSnapshot::Text>& out) {
+    auto [first, last] = visibleRange(currentState);
+    for (const Handle* h = first; h != last; ++h) {
+        HUDElement& element = m_elements[*h];
+        if (element.string.isEmpty())
+            continue;
+
+        RenderSnapshot::Text t;
+        t.content = element.string.toAnsiString();
+        t.size = element.characterSize;
+        t.pos = element.pos;
+        t.viewSpace = (element.mode == RenderMode::ViewSpace);
+        t.color = element.baseColor;
+        if (element.hoverable && !t.viewSpace && isMouseOverText(window, element))
+            t.color = element.hoverColor;
+        out.push_back(std::move(t));
+    }
 }
 
-void HUD::drawWhiteBackground(sf::RenderWindow& window)
+sf::FloatRect HUD::getElementBounds(Handle handle)
 {
-    sf::RectangleShape bg(sf::Vector2f(static_cast<float>(window.getSize().x), 
-                                         static_cast<float>(window.getSize().y)));
-    bg.setFillColor(sf::Color::White);
-    bg.setPosition(0.f, 0.f);
-    window.draw(bg);
+    HUDElement& element = m_elements[handle];
+    ensureLayout(element);
+    sf::FloatRect bounds = element.layout.bounds;
+    bounds.left += element.pos.x;
+    bounds.top += element.pos.y;
+    return bounds;
 }
 
-bool HUD::isMouseOverText(const sf::RenderWindow& window, const sf::Text& text)
+void HUD::ensureLayout(HUDElement& element)
 {
+    if (!element.layoutDirty)
+        return;
+    m_screenText.layout(element.string, element.characterSize, element.layout);
+    element.layoutDirty = false;
+}
+
+bool HUD::isMouseOverText(const sf::RenderWindow& window, HUDElement& element)
+{
+    ensureLayout(element);
     sf::Vector2i mousePos = sf::Mouse::getPosition(window);
     sf::Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
-    sf::FloatRect bounds = text.getGlobalBounds();
+    sf::FloatRect bounds = element.layout.bounds;
+    bounds.left += element.pos.x;
+    bounds.top += element.pos.y;
     return bounds.contains(mousePosF);
 }
 
@@ -117,138 +195,118 @@ bool HUD::isFullyLoaded() const {
 //-------------------------------------------------------------------------
 void HUD::configureGameplayHUD(const sf::Vector2u& winSize) {
     // Game status element
-    addElement("gameStatus", "Playing", 16,
+    m_gameStatus = addElement("gameStatus", "Playing", 16,
                sf::Vector2f(10.f, 10.f),
                GameState::Playing, RenderMode::ViewSpace, false);
-    updateBaseColor("gameStatus", sf::Color::White);
+    updateBaseColor(m_gameStatus, sf::Color::White);
 
     // Level display element
-    addElement("level", "Level: 0\nEnemies: 0\nHP: 100", 16,
+    m_level = addElement("level", "Level: 0\nEnemies: 0\nHP: 100", 16,
                sf::Vector2f(10.f, 50.f),
                GameState::Playing, RenderMode::ViewSpace, false);
-    updateBaseColor("level", sf::Color::White);
+    updateBaseColor(m_level, sf::Color::White);
 
     // Scoreboard element
-    addElement("scoreboard", "Scoreboard:\n", 16,
+    m_scoreboard = addElement("scoreboard", "Scoreboard:\n", 16,
                sf::Vector2f(SCREEN_WIDTH - 200.f, 10.f),
                GameState::Playing, RenderMode::ViewSpace, false);
-    updateBaseColor("scoreboard", sf::Color::White);
+    updateBaseColor(m_scoreboard, sf::Color::White);
 
     // Next level timer element
-    addElement("nextLevelTimer", "", 16,
+    m_nextLevelTimer = addElement("nextLevelTimer", "", 16,
                sf::Vector2f(0.5f * winSize.x - 50.f, 0.10f * winSize.y),
                GameState::Playing, RenderMode::ViewSpace, false);
-    updateBaseColor("nextLevelTimer", sf::Color::White);
+    updateBaseColor(m_nextLevelTimer, sf::Color::White);
 
     // Pause menu element
-    addElement("pauseMenu", "Paused\nPress M to Return to Main Menu\nPress ESC to Resume", 24,
+    m_pauseMenu = addElement("pauseMenu", "Paused\nPress M to Return to Main Menu\nPress ESC to Resume", 24,
                sf::Vector2f(0.5f * winSize.x - 150.f, 0.3f * winSize.y),
                GameState::Playing, RenderMode::ScreenSpace, false);
-    updateBaseColor("pauseMenu", sf::Color::White);
+    updateBaseColor(m_pauseMenu, sf::Color::White);
 }
 
 void HUD::configureStoreHUD(const sf::Vector2u& winSize) {
     // Store title element
-    addElement("storeTitle", "Store (Press B to Close)", 24,
+    m_storeTitle = addElement("storeTitle", "Store (Press B to Close)", 24,
                sf::Vector2f(0.5f * winSize.x - 100.f, 0.05f * winSize.y),
                GameState::Playing, RenderMode::ScreenSpace, false);
-    updateBaseColor("storeTitle", sf::Color::White);
+    updateBaseColor(m_storeTitle, sf::Color::White);
 
     // Store money element
-    addElement("storeMoney", "Money: 0", 20,
+    m_storeMoney = addElement("storeMoney", "Money: 0", 20,
                sf::Vector2f(0.5f * winSize.x - 80.f, 0.15f * winSize.y),
                GameState::Playing, RenderMode::ScreenSpace, false);
-    updateBaseColor("storeMoney", sf::Color::Yellow);
+    updateBaseColor(m_storeMoney, sf::Color::Yellow);
 
     // Speed boost button element
-    addElement("speedBoostButton", "Speed Boost (+50) - 50", 20,
+    m_speedBoostButton = addElement("speedBoostButton", "Speed Boost (+50) - 50", 20,
                sf::Vector2f(0.5f * winSize.x - 80.f, 0.25f * winSize.y),
                GameState::Playing, RenderMode::ScreenSpace, true);
-    updateBaseColor("speedBoostButton", sf::Color::White);
+    updateBaseColor(m_speedBoostButton, sf::Color::White);
 }
 
 //-------------------------------------------------------------------------
 // HUD Refresh Methods
 //-------------------------------------------------------------------------
-void HUD::refreshHUDContent(GameState currentState, bool menuVisible, bool shopOpen, const sf::Vector2u& winSize, const Player& localPlayer) {
-    // Update store elements if shop is open.
-    if (shopOpen) {
-        updateElementPosition("storeTitle", sf::Vector2f(0.5f * winSize.x - 100.f, 0.05f * winSize.y));
-        updateElementPosition("storeMoney", sf::Vector2f(0.5f * winSize.x - 80.f, 0.15f * winSize.y));
-        updateElementPosition("speedBoostButton", sf::Vector2f(0.5f * winSize.x - 80.f, 0.25f * winSize.y));
-        updateText("storeMoney", "Money: " + std::to_string(localPlayer.money));
-        updateText("storeTitle", "Store (Press B to Close)");
-        updateText("speedBoostButton", "Speed Boost (+50) - 50");
-    } else {
-        updateText("storeTitle", "");
-        updateText("storeMoney", "");
-        updateText("speedBoostButton", "");
+void HUD::applyModel(HUDModel& model, PersonaNameCache& names) {
+    const uint32_t dirty = model.takeDirty();
+    if (dirty == 0)
+        return;
+    const sf::Vector2u& winSize = model.getWindowSize();
+
+    if (dirty & HUDModel::Layout) {
+        updateElementPosition(m_level, sf::Vector2f(0.05f * winSize.x, 0.10f * winSize.y));
+        updateElementPosition(m_gameStatus, sf::Vector2f(0.05f * winSize.x, 0.05f * winSize.y));
+        updateElementPosition(m_nextLevelTimer, sf::Vector2f(0.5f * winSize.x - 50.f, 0.10f * winSize.y));
+        updateElementPosition(m_scoreboard, sf::Vector2f(0.75f * winSize.x, 0.05f * winSize.y));
+        updateElementPosition(m_storeTitle, sf::Vector2f(0.5f * winSize.x - 100.f, 0.05f * winSize.y));
+        updateElementPosition(m_storeMoney, sf::Vector2f(0.5f * winSize.x - 80.f, 0.15f * winSize.y));
+        updateElementPosition(m_speedBoostButton, sf::Vector2f(0.5f * winSize.x - 80.f, 0.25f * winSize.y));
     }
-    
-    // Update pause menu element.
-    if (currentState == GameState::Playing)
-        updateText("pauseMenu", menuVisible ? "Paused\nPress M to Return to Main Menu\nPress ESC to Resume" : "");
-    else
-        updateText("pauseMenu", "");
-}
-
-void HUD::refreshGameInfo(const sf::Vector2u& winSize,
-                          int currentLevel,
-                          size_t enemyCount,
-                          const Player& localPlayer,
-                          float nextLevelTimer,
-                          const std::unordered_map<CSteamID, Player, CSteamIDHash>& players)
-{
-    // Update level display.
-    updateElementPosition("level", sf::Vector2f(0.05f * winSize.x, 0.10f * winSize.y));
-    updateText("level",
-        "Level: " + std::to_string(currentLevel) +
-        "\nEnemies: " + std::to_string(enemyCount) +
-        "\nHP: " + std::to_string(localPlayer.health) +
-        "\nKills: " + std::to_string(localPlayer.kills) +
-        "\nMoney: " + std::to_string(localPlayer.money)
-    );
-
-    // Update game status.
-    updateElementPosition("gameStatus", sf::Vector2f(0.05f * winSize.x, 0.05f * winSize.y));
-    updateText("gameStatus",
-        (nextLevelTimer > 0) ?
-            "Next Wave in: " + std::to_string(static_cast<int>(nextLevelTimer + 0.5f)) + "s"
-          : "Playing"
-    );
-
-    // Update next level timer element.
-    updateElementPosition("nextLevelTimer", sf::Vector2f(0.5f * winSize.x - 50.f, 0.10f * winSize.y));
-    if (nextLevelTimer > 0)
-        updateText("nextLevelTimer", "Next Wave: " + std::to_string(static_cast<int>(nextLevelTimer + 0.5f)) + "s");
-    else
-        updateText("nextLevelTimer", "");
-
-    // Update scoreboard.
-    updateElementPosition("scoreboard", sf::Vector2f(0.75f * winSize.x, 0.05f * winSize.y));
-    std::string scoreboard = "Scoreboard:\n";
-    for (const auto& playerPair : players) {
-        const Player& player = playerPair.second;
-        const char* steamName = SteamFriends() ? SteamFriends()->GetFriendPersonaName(player.steamID) : "Unknown";
-        if (!steamName || steamName[0] == '\0')
-            steamName = "Unknown";
-        scoreboard += std::string(steamName) +
-                      ": Kills=" + std::to_string(player.kills) +
-                      ", HP=" + std::to_string(player.health) + "\n";
+
+    if (dirty & HUDModel::LevelInfo) {
+        updateText(m_level,
+            "Level: " + std::to_string(model.getLevel()) +
+            "\nEnemies: " + std::to_string(model.getEnemyCount()) +
+            "\nHP: " + std::to_string(model.getHealth()) +
+            "\nKills: " + std::to_string(model.getKills()) +
+            "\nMoney: " + std::to_string(model.getMoney())
+        );
     }
-    updateText("scoreboard", scoreboard);
-}
-
-void HUD::updateScoreboard(const std::unordered_map<CSteamID, Player, CSteamIDHash>& players) {
-    std::string scoreboard = "Scoreboard:\n";
-    for (const auto& playerPair : players) {
-        const Player& player = playerPair.second;
-        const char* steamName = SteamFriends() ? SteamFriends()->GetFriendPersonaName(player.steamID) : "Unknown";
-        if (!steamName || steamName[0] == '\0')
-            steamName = "Unknown";
-        scoreboard += std::string(steamName) +
-                      ": Kills=" + std::to_string(player.kills) +
-                      ", HP=" + std::to_string(player.health) + "\n";
+
+    if (dirty & HUDModel::Timer) {
+        const int seconds = model.getTimerSeconds();
+        if (seconds >= 0) {
+            updateText(m_gameStatus, "Next Wave in: " + std::to_string(seconds) + "s");
+            updateText(m_nextLevelTimer, "Next Wave: " + std::to_string(seconds) + "s");
+        } else {
+            updateText(m_gameStatus, "Playing");
+            updateText(m_nextLevelTimer, "");
+        }
     }
-    updateText("scoreboard", scoreboard);
+
+    if (dirty & HUDModel::Scoreboard) {
+        std::string scoreboard = "Scoreboard:\n";
+        for (const HUDModel::ScoreRow& row : model.getScoreRows()) {
+            scoreboard += names.get(row.id) +
+                          ": Kills=" + std::to_string(row.kills) +
+                          ", HP=" + std::to_string(row.health) + "\n";
+        }
+        updateText(m_scoreboard, scoreboard);
+    }
+
+    if (dirty & HUDModel::Store) {
+        if (model.isShopOpen()) {
+            updateText(m_storeMoney, "Money: " + std::to_string(model.getMoney()));
+            updateText(m_storeTitle, "Store (Press B to Close)");
+            updateText(m_speedBoostButton, "Speed Boost (+50) - 50");
+        } else {
+            updateText(m_storeTitle, "");
+            updateText(m_storeMoney, "");
+            updateText(m_speedBoostButton, "");
+        }
+    }
+
+    if (dirty & HUDModel::PauseMenu)
+        updateText(m_pauseMenu, model.isMenuVisible() ? "Paused\nPress M to Return to Main Menu\nPress ESC to Resume" : "");
 }
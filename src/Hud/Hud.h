@@ -4,15 +4,27 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <cstdint>
 #include "../States/GameState.h"
 #include "../Utils/Config.h"
 #include "../Entities/Player.h"
 #include "../Utils/SteamHelpers.h"
+#include "../Utils/FastHash.h"
+#include "../Rendering/RenderSnapshot.h"
+#include "../Rendering/RenderQueue.h"
+#include "../Rendering/TextBatcher.h"
+#include "../Networking/PersonaNameCache.h"
+#include "HudModel.h"
 
 /**
  * @brief Class for managing Heads-Up Display (HUD) elements.
  *
  * Provides functionality to add, update, and render HUD elements on screen.
+ * Elements live in a dense vector and are addressed by Handle (an index
+ * returned by addElement) or by Key (a name hashed at compile time with the
+ * _hud literal), so hot paths never hash strings. Lookup by std::string is
+ * kept only as a debug path.
  */
 class HUD
 {
@@ -25,17 +37,36 @@ public:
         ViewSpace    ///< Render relative to the game view.
     };
 
+    /// Dense element index; stable for the lifetime of the HUD.
+    using Handle = uint16_t;
+    static constexpr Handle InvalidHandle = 0xFFFF;
+
+    /**
+     * @brief Hashed element name. Build with "name"_hud or HUD::key().
+     */
+    struct Key {
+        uint32_t hash;
+    };
+
+    /// Hashes a runtime name (e.g. "playerNameSlot" + index); same hash as the _hud literal.
+    static Key key(const std::string& name) { return Key{ fnv1a32(name.data(), name.size()) }; }
+
     /**
      * @brief Structure representing a single HUD element.
      */
     struct HUDElement {
-        sf::Text text;          ///< Text for the HUD element.
+        sf::String string;      ///< Displayed text.
+        unsigned int characterSize; ///< Character size in pixels.
+        TextBatcher::TextLayout layout; ///< Cached glyph geometry for string/characterSize.
+        bool layoutDirty;       ///< Set when string or size changed since the last layout.
         sf::Vector2f pos;       ///< Position of the element.
         GameState visibleState; ///< Game state in which the element is visible.
         RenderMode mode;        ///< Rendering mode.
         bool hoverable;         ///< Whether the element responds to mouse hover.
         sf::Color baseColor;    ///< Default text color.
         sf::Color hoverColor;   ///< Text color when hovered.
+        uint32_t keyHash;       ///< Hashed name (Key::hash).
+        std::string name;       ///< Original name, for debugging and collision checks.
     };
 
     /**
@@ -51,13 +82,7 @@ public:
     bool isFullyLoaded() const;
 
     /**
-     * @brief Updates the scoreboard with current player stats.
-     * @param players Map of players.
-     */
-    void updateScoreboard(const std::unordered_map<CSteamID, Player, CSteamIDHash>& players);
-
-    /**
-     * @brief Adds a HUD element.
+     * @brief Adds a HUD element, or replaces the element registered under the same name.
      * @param id Unique identifier for the element.
      * @param content Text content.
      * @param size Character size.
@@ -65,8 +90,9 @@ public:
      * @param visibleState Game state when visible.
      * @param mode Render mode.
      * @param hoverable Whether it is hoverable.
+     * @return Handle of the element (unchanged when an existing element is replaced).
      */
-    void addElement(const std::string& id,
+    Handle addElement(const std::string& id,
                     const std::string& content,
                     unsigned int size,
                     sf::Vector2f pos,
@@ -75,55 +101,87 @@ public:
                     bool hoverable = false);
 
     /**
-     * @brief Refreshes game info on the HUD.
-     * @param winSize Window size.
-     * @param currentLevel Current level.
-     * @param enemyCount Number of enemies.
-     * @param localPlayer Reference to local player.
-     * @param nextLevelTimer Timer for next wave.
-     * @param players Map of players.
+     * @brief Resolves a key to a handle (integer hash lookup).
+     * @return InvalidHandle if no element has that name.
      */
-    void refreshGameInfo(const sf::Vector2u& winSize,
-                         int currentLevel,
-                         size_t enemyCount,
-                         const Player& localPlayer,
-                         float nextLevelTimer,
-                         const std::unordered_map<CSteamID, Player, CSteamIDHash>& players);
+    Handle find(Key key) const;
+
+    /**
+     * @brief Debug-only lookup by name; hashes the string on every call.
+     */
+    Handle findByName(const std::string& name) const { return find(key(name)); }
 
     /**
      * @brief Updates the text content of a HUD element.
-     * @param id Element ID.
+     * @param handle Element handle (InvalidHandle is ignored).
      * @param content New text content.
      */
-    void updateText(const std::string& id, const std::string& content);
+    void updateText(Handle handle, const sf::String& content);
+    void updateText(Key id, const sf::String& content) { updateText(find(id), content); }
 
     /**
      * @brief Updates the base color of a HUD element.
-     * @param id Element ID.
+     * @param handle Element handle (InvalidHandle is ignored).
      * @param color New base color.
      */
-    void updateBaseColor(const std::string& id, const sf::Color& color);
+    void updateBaseColor(Handle handle, const sf::Color& color);
+    void updateBaseColor(Key id, const sf::Color& color) { updateBaseColor(find(id), color); }
 
     /**
      * @brief Updates the position of a HUD element.
-     * @param id Element ID.
+     * @param handle Element handle (InvalidHandle is ignored).
      * @param pos New position.
      */
-    void updateElementPosition(const std::string& id, const sf::Vector2f& pos);
+    void updateElementPosition(Handle handle, const sf::Vector2f& pos);
+    void updateElementPosition(Key id, const sf::Vector2f& pos) { updateElementPosition(find(id), pos); }
 
     /**
-     * @brief Renders HUD elements on the window.
-     * @param window Render window.
+     * @brief Returns and clears the "something visible changed" flag.
+     *
+     * Set by addElement() and by any update* call that actually changed a value;
+     * used to request a redraw of on-demand screens.
+     */
+    bool consumeChanged() { bool changed = m_changed; m_changed = false; return changed; }
+
+    /// Element by handle (must be valid).
+    const HUDElement& getElement(Handle handle) const { return m_elements[handle]; }
+
+    /**
+     * @brief Bounds of an element's text at its current position (screen or view space).
+     * @param handle Element handle (must be valid).
+     */
+    sf::FloatRect getElementBounds(Handle handle);
+
+    /**
+     * @brief Queues the visible HUD elements.
+     *
+     * ScreenSpace elements are batched into the ScreenUI layer with the window's
+     * default view, ViewSpace elements into the WorldUI layer with the game view.
+     * Text of one character size shares a glyph page, so each layer costs one
+     * draw per distinct size in use.
+     * @param queue Render queue for this frame.
+     * @param window Render window (default view and mouse hover tests).
      * @param view Current game view.
      * @param currentState Current game state.
      */
-    void render(sf::RenderWindow& window, const sf::View& view, GameState currentState);
+    void submit(RenderQueue& queue, const sf::RenderWindow& window, const sf::View& view, GameState currentState);
+
+    /**
+     * @brief Copies the visible HUD strings into a render snapshot.
+     *
+     * Hover colours are resolved here, on the simulation thread, so the render
+     * thread only needs the final text, position and colour.
+     * @param window Window used for mouse hover tests.
+     * @param currentState Current game state.
+     * @param out Destination list (appended to).
+     */
+    void collectTexts(const sf::RenderWindow& window, GameState currentState, std::vector<RenderSnapshot::Text>& out);
 
     /**
      * @brief Returns a constant reference to the HUD elements.
-     * @return Map of HUD elements.
+     * @return Elements indexed by Handle.
      */
-    const std::unordered_map<std::string, HUDElement>& getElements() const { return m_elements; }
+    const std::vector<HUDElement>& getElements() const { return m_elements; }
 
     /**
      * @brief Configures HUD elements for gameplay.
@@ -138,32 +196,64 @@ public:
     void configureStoreHUD(const sf::Vector2u& winSize);
 
     /**
-     * @brief Refreshes HUD content based on the current state.
-     * @param currentState Current game state.
-     * @param menuVisible Whether the pause menu is visible.
-     * @param shopOpen Whether the store is open.
-     * @param winSize Window size.
-     * @param localPlayer Reference to local player.
+     * @brief Pushes changed view-model fields into the gameplay and store elements.
+     *
+     * Only groups flagged dirty since the last call are formatted, so a tick in
+     * which nothing visible changed costs no string work or glyph re-layout.
+     * @param model Gameplay HUD view model (its dirty mask is consumed).
+     * @param names Persona name cache used for the scoreboard.
      */
-    void refreshHUDContent(GameState currentState, bool menuVisible, bool shopOpen, const sf::Vector2u& winSize, const Player& localPlayer);
+    void applyModel(HUDModel& model, PersonaNameCache& names);
 
 private:
     sf::Font& m_font; ///< Reference to the font used for HUD elements.
-    std::unordered_map<std::string, HUDElement> m_elements; ///< Map of HUD elements.
+    std::vector<HUDElement> m_elements;             ///< Elements indexed by Handle.
+    std::unordered_map<uint32_t, Handle> m_byKey;   ///< Key hash -> handle.
+    std::vector<Handle> m_drawOrder;                ///< Handles sorted by visible state, then render mode.
+    bool m_drawOrderDirty = false;                  ///< Set when elements were added.
+    bool m_changed = true;                          ///< See consumeChanged().
+    TextBatcher m_screenText;                       ///< ScreenSpace text stream.
+    TextBatcher m_viewText;                         ///< ViewSpace text stream.
+
+    // Gameplay and store elements touched by applyModel().
+    Handle m_level = InvalidHandle;
+    Handle m_gameStatus = InvalidHandle;
+    Handle m_scoreboard = InvalidHandle;
+    Handle m_nextLevelTimer = InvalidHandle;
+    Handle m_pauseMenu = InvalidHandle;
+    Handle m_storeTitle = InvalidHandle;
+    Handle m_storeMoney = InvalidHandle;
+    Handle m_speedBoostButton = InvalidHandle;
 
     /**
-     * @brief Draws a white background on the window.
-     * @param window Render window.
+     * @brief Re-sorts m_drawOrder after elements were added.
      */
-    void drawWhiteBackground(sf::RenderWindow& window);
+    void sortDrawOrder();
 
     /**
-     * @brief Checks if the mouse is over the given text.
+     * @brief Range of m_drawOrder visible in a game state.
+     */
+    std::pair<const Handle*, const Handle*> visibleRange(GameState state);
+
+    /**
+     * @brief Re-lays out an element if its string or size changed.
+     */
+    void ensureLayout(HUDElement& element);
+
+    /**
+     * @brief Checks if the mouse is over a ScreenSpace element.
      * @param window Render window.
-     * @param text SFML text object.
+     * @param element Element to test.
      * @return True if the mouse is over the text.
      */
-    bool isMouseOverText(const sf::RenderWindow& window, const sf::Text& text);
+    bool isMouseOverText(const sf::RenderWindow& window, HUDElement& element);
 };
 
+/**
+ * @brief Compile-time hashed HUD element name, e.g. hud.updateText("status"_hud, ...).
+ */
+constexpr HUD::Key operator"" _hud(const char* name, std::size_t length) {
+    return HUD::Key{ fnv1a32(name, length) };
+}
+
 #endif // HUD_H
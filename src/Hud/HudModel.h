@@ -0,0 +1,122 @@
+#ifndef HUDMODEL_H
+#define HUDMODEL_H
+
+#include <SFML/System/Vector2.hpp>
+#include <steam/steam_api.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../Entities/Player.h"
+#include "../Utils/SteamHelpers.h"
+
+/**
+ * @brief Gameplay values shown by the HUD, with per-field dirty tracking.
+ *
+ * Setters compare against the stored value and only flag the HUD groups that
+ * actually changed, so HUD::applyModel() formats strings (and SFML re-lays out
+ * glyphs) only when the displayed text would differ. The timer is tracked in
+ * whole displayed seconds rather than as a float for the same reason.
+ */
+class HUDModel {
+public:
+    /**
+     * @brief HUD groups that can be invalidated independently.
+     */
+    enum Field : uint32_t {
+        Layout     = 1u << 0, ///< Window size changed; element positions need updating.
+        LevelInfo  = 1u << 1, ///< Level, enemy count and local player stats.
+        Timer      = 1u << 2, ///< Next wave countdown.
+        Scoreboard = 1u << 3, ///< Per-player kills/health or names.
+        Store      = 1u << 4, ///< Store visibility or money.
+        PauseMenu  = 1u << 5, ///< Pause menu visibility.
+        All        = (1u << 6) - 1
+    };
+
+    /**
+     * @brief One scoreboard line.
+     */
+    struct ScoreRow {
+        CSteamID id;
+        int kills = 0;
+        int health = 0;
+        bool operator==(const ScoreRow& o) const { return id == o.id && kills == o.kills && health == o.health; }
+    };
+
+    void setWindowSize(const sf::Vector2u& size)  { assign(m_winSize, size, Layout); }
+    void setLevel(int level)                      { assign(m_level, level, LevelInfo); }
+    void setEnemyCount(std::size_t count)         { assign(m_enemyCount, count, LevelInfo); }
+    void setMenuVisible(bool visible)             { assign(m_menuVisible, visible, PauseMenu); }
+    void setShopOpen(bool open)                   { assign(m_shopOpen, open, Store | Layout); }
+
+    void setLocalStats(int health, int kills, int money) {
+        assign(m_health, health, LevelInfo);
+        assign(m_kills, kills, LevelInfo);
+        assign(m_money, money, LevelInfo | Store);
+    }
+
+    /**
+     * @brief Sets the next wave countdown; only whole-second changes mark it dirty.
+     * @param seconds Remaining time, or <= 0 when no wave is pending.
+     */
+    void setNextWaveTimer(float seconds) {
+        assign(m_timerSeconds, seconds > 0.f ? static_cast<int>(seconds + 0.5f) : -1, Timer);
+    }
+
+    /**
+     * @brief Rebuilds the scoreboard rows and flags them if anything shown changed.
+     * @param players Current players.
+     * @param namesVersion PersonaNameCache::getVersion(), so name changes refresh the board.
+     */
+    void setScoreboard(const std::unordered_map<CSteamID, Player, CSteamIDHash>& players, uint32_t namesVersion) {
+        m_scratchRows.clear();
+        for (const auto& pair : players)
+            m_scratchRows.push_back({ pair.first, pair.second.kills, pair.second.health });
+        if (m_scratchRows != m_rows || namesVersion != m_namesVersion) {
+            m_rows.swap(m_scratchRows);
+            m_namesVersion = namesVersion;
+            m_dirty |= Scoreboard;
+        }
+    }
+
+    /// Returns and clears the dirty mask.
+    uint32_t takeDirty() { uint32_t d = m_dirty; m_dirty = 0; return d; }
+
+    /// Forces every group to be reformatted (e.g. after HUD elements were re-added).
+    void invalidate() { m_dirty = All; }
+
+    const sf::Vector2u& getWindowSize() const { return m_winSize; }
+    int getLevel() const { return m_level; }
+    std::size_t getEnemyCount() const { return m_enemyCount; }
+    int getHealth() const { return m_health; }
+    int getKills() const { return m_kills; }
+    int getMoney() const { return m_money; }
+    int getTimerSeconds() const { return m_timerSeconds; } ///< -1 when no wave is pending.
+    bool isMenuVisible() const { return m_menuVisible; }
+    bool isShopOpen() const { return m_shopOpen; }
+    const std::vector<ScoreRow>& getScoreRows() const { return m_rows; }
+
+private:
+    template <typename T>
+    void assign(T& field, const T& value, uint32_t flags) {
+        if (field != value) {
+            field = value;
+            m_dirty |= flags;
+        }
+    }
+
+    sf::Vector2u m_winSize;
+    int m_level = 0;
+    std::size_t m_enemyCount = 0;
+    int m_health = 0;
+    int m_kills = 0;
+    int m_money = 0;
+    int m_timerSeconds = -1;
+    bool m_menuVisible = false;
+    bool m_shopOpen = false;
+    std::vector<ScoreRow> m_rows;
+    std::vector<ScoreRow> m_scratchRows; ///< Reused to avoid per-tick allocation.
+    uint32_t m_namesVersion = 0;
+    uint32_t m_dirty = All;
+};
+
+#endif // HUDMODEL_H
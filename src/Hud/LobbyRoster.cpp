@@ -0,0 +1,104 @@
+#include "LobbyRoster.h"
+#include "../Utils/Config.h"
+#include <algorithm>
+#include <string>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+LobbyRoster::LobbyRoster(HUD& hud, UIScene& scene, const sf::FloatRect& area, float rowHeight)
+    : m_hud(hud),
+      m_scene(scene)
+{
+    const std::size_t rowCount = std::max<std::size_t>(1, static_cast<std::size_t>(area.height / rowHeight));
+    const float panelHeight = rowHeight - 6.f;
+    m_rows.reserve(rowCount);
+    for (std::size_t i = 0; i < rowCount; ++i) {
+        const float y = area.top + i * rowHeight;
+        Row row;
+        // CornflowerBlue panel with a black frame, as the old fixed slots.
+        row.panel = scene.addRect(sf::FloatRect(area.left, y, area.width, panelHeight),
+                                  sf::Color(100, 149, 237), sf::Color::Black, 2.f);
+        scene.setVisible(row.panel, false);
+        row.name = hud.addElement("rosterName" + std::to_string(i), "", 20,
+                                  sf::Vector2f(area.left + 16.f, y + 6.f),
+                                  GameState::Lobby, HUD::RenderMode::ScreenSpace, false);
+        row.ready = hud.addElement("rosterReady" + std::to_string(i), "", 20,
+                                   sf::Vector2f(area.left + area.width - 140.f, y + 6.f),
+                                   GameState::Lobby, HUD::RenderMode::ScreenSpace, false);
+        hud.updateBaseColor(row.name, sf::Color::Black);
+        hud.updateBaseColor(row.ready, sf::Color::Black);
+        m_rows.push_back(row);
+    }
+
+    m_summary = hud.addElement("rosterSummary", "", 18,
+                               sf::Vector2f(area.left, area.top - 28.f),
+                               GameState::Lobby, HUD::RenderMode::ScreenSpace, false);
+    hud.updateBaseColor(m_summary, sf::Color::Black);
+}
+
+//-------------------------------------------------------------------------
+// Input
+//-------------------------------------------------------------------------
+void LobbyRoster::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::MouseWheelScrolled) {
+        scroll(event.mouseWheelScroll.delta > 0.f ? -1 : 1);
+    } else if (event.type == sf::Event::KeyPressed) {
+        const int page = static_cast<int>(m_rows.size());
+        switch (event.key.code) {
+            case sf::Keyboard::Up:       scroll(-1); break;
+            case sf::Keyboard::Down:     scroll(1); break;
+            case sf::Keyboard::PageUp:   scroll(-page); break;
+            case sf::Keyboard::PageDown: scroll(page); break;
+            default: break;
+        }
+    }
+}
+
+void LobbyRoster::scroll(int rows) {
+    m_pendingScroll += rows;
+}
+
+//-------------------------------------------------------------------------
+// Binding
+//-------------------------------------------------------------------------
+void LobbyRoster::sync(const LobbyMembershipCache& members, PersonaNameCache& names) {
+    const std::vector<LobbyMembershipCache::Member>& list = members.getMembers();
+    const std::size_t maxFirst = list.size() > m_rows.size() ? list.size() - m_rows.size() : 0;
+    const long long wanted = static_cast<long long>(m_first) + m_pendingScroll;
+    const std::size_t first = static_cast<std::size_t>(std::clamp<long long>(wanted, 0, static_cast<long long>(maxFirst)));
+    m_pendingScroll = 0;
+
+    if (first == m_first && members.getVersion() == m_boundMembersVersion &&
+        names.getVersion() == m_boundNamesVersion)
+        return;
+
+    m_first = first;
+    m_memberCount = list.size();
+    m_boundMembersVersion = members.getVersion();
+    m_boundNamesVersion = names.getVersion();
+    ++m_rebinds;
+
+    for (std::size_t i = 0; i < m_rows.size(); ++i) {
+        const Row& row = m_rows[i];
+        const std::size_t index = m_first + i;
+        if (index < list.size()) {
+            const LobbyMembershipCache::Member& member = list[index];
+            m_scene.setVisible(row.panel, true);
+            m_hud.updateText(row.name, std::to_string(index + 1) + ". " + names.get(member.id));
+            m_hud.updateText(row.ready, member.ready ? "Ready" : "Not Ready");
+        } else {
+            m_scene.setVisible(row.panel, false);
+            m_hud.updateText(row.name, "");
+            m_hud.updateText(row.ready, "");
+        }
+    }
+
+    std::string summary = "Players " + std::to_string(list.size()) + "/" + std::to_string(MAX_LOBBY_MEMBERS);
+    if (list.size() > m_rows.size()) {
+        summary += "   showing " + std::to_string(m_first + 1) + "-" +
+                   std::to_string(std::min(list.size(), m_first + m_rows.size())) +
+                   " (scroll or Up/Down)";
+    }
+    m_hud.updateText(m_summary, summary);
+}
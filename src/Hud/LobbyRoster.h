@@ -0,0 +1,73 @@
+#ifndef LOBBYROSTER_H
+#define LOBBYROSTER_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Hud.h"
+#include "../Rendering/UIScene.h"
+#include "../Networking/LobbyMembershipCache.h"
+#include "../Networking/PersonaNameCache.h"
+
+/**
+ * @brief Virtualised, scrollable list of lobby members.
+ *
+ * Only as many rows as fit in the list area exist (a fixed pool of scene
+ * panels and HUD texts). Rows are re-bound to members only when the
+ * membership cache version, the persona name version or the scroll offset
+ * changes, so a 64-player lobby costs the same per frame as a 4-player one.
+ */
+class LobbyRoster {
+public:
+    /**
+     * @brief Constructor; creates the row pool.
+     * @param hud HUD that owns the row texts.
+     * @param scene Scene that owns the row panels.
+     * @param area List area in screen coordinates.
+     * @param rowHeight Height of one row including spacing.
+     */
+    LobbyRoster(HUD& hud, UIScene& scene, const sf::FloatRect& area, float rowHeight = 44.f);
+
+    /**
+     * @brief Re-binds visible rows if the members, names or scroll offset changed.
+     */
+    void sync(const LobbyMembershipCache& members, PersonaNameCache& names);
+
+    /**
+     * @brief Scrolls with the mouse wheel, Up/Down and PageUp/PageDown.
+     */
+    void handleEvent(const sf::Event& event);
+
+    /**
+     * @brief Scrolls by a number of rows (clamped on the next sync).
+     */
+    void scroll(int rows);
+
+    std::size_t getFirstVisible() const { return m_first; }
+    std::size_t getRowCapacity() const { return m_rows.size(); }
+    unsigned int getRebindCount() const { return m_rebinds; }  ///< Times the pool was re-bound.
+
+private:
+    /**
+     * @brief One pooled row.
+     */
+    struct Row {
+        UIScene::NodeId panel;
+        HUD::Handle name;
+        HUD::Handle ready;
+    };
+
+    HUD& m_hud;
+    UIScene& m_scene;
+    std::vector<Row> m_rows;
+    HUD::Handle m_summary = HUD::InvalidHandle;  ///< "Players n/max" and scroll range.
+
+    std::size_t m_memberCount = 0;
+    std::size_t m_first = 0;         ///< Member index shown in the first row.
+    int m_pendingScroll = 0;
+    uint32_t m_boundMembersVersion = ~0u;
+    uint32_t m_boundNamesVersion = ~0u;
+    unsigned int m_rebinds = 0;
+};
+
+#endif // LOBBYROSTER_H
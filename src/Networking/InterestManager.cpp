@@ -0,0 +1,94 @@
+#include "InterestManager.h"
+#include "../Entities/EntityManager.h"
+#include <algorithm>
+
+namespace {
+    sf::FloatRect around(sf::Vector2f center, sf::Vector2f viewSize, float margin) {
+        const sf::Vector2f half = viewSize * 0.5f + sf::Vector2f(margin, margin);
+        return sf::FloatRect(center - half, half * 2.f);
+    }
+}
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+InterestManager::InterestManager()
+    : InterestManager(Config())
+{
+}
+
+InterestManager::InterestManager(const Config& config)
+    : m_config(config)
+{
+}
+
+//-------------------------------------------------------------------------
+// Update
+//-------------------------------------------------------------------------
+void InterestManager::update(const EntityManager& entities,
+                             const std::unordered_map<CSteamID, bool, CSteamIDHash>& clients,
+                             CSteamID self) {
+    // Forget clients that are gone or have no player to centre on.
+    for (auto it = m_interests.begin(); it != m_interests.end();) {
+        if (!clients.count(it->first) || !entities.getPlayers().count(it->first))
+            it = m_interests.erase(it);
+        else
+            ++it;
+    }
+
+    const auto& enemies = entities.getEnemies();
+    for (const auto& client : clients) {
+        if (client.first == self) continue;
+        auto player = entities.getPlayers().find(client.first);
+        if (player == entities.getPlayers().end()) continue;
+
+        Interest& interest = m_interests[client.first];
+        const sf::Vector2f center(player->second.x, player->second.y);
+        interest.center = center;
+        interest.enter = around(center, m_config.viewSize, m_config.enterMargin);
+        interest.leave = around(center, m_config.viewSize, m_config.leaveMargin);
+
+        // Everything in the leave rectangle stays if it was already in; only
+        // what is also in the enter rectangle may join.
+        m_found.clear();
+        m_bullets.clear();
+        entities.queryRegion(interest.leave, m_found, m_bullets);
+        m_next.clear();
+        std::size_t entered = 0;
+        for (uint64_t id : m_found) {
+            if (std::binary_search(interest.enemies.begin(), interest.enemies.end(), id)) {
+                m_next.push_back(id);
+            } else if (interest.enter.intersects(enemies.at(id).getBounds())) {
+                m_next.push_back(id);
+                ++entered;
+            }
+        }
+        std::sort(m_next.begin(), m_next.end());
+
+        // Whatever was in and did not stay has left (or died).
+        m_stats.enters += entered;
+        m_stats.leaves += interest.enemies.size() - (m_next.size() - entered);
+        interest.enemies.swap(m_next);
+
+        ++m_stats.updates;
+        m_stats.relevant += interest.enemies.size();
+        m_stats.total += enemies.size();
+    }
+}
+
+//-------------------------------------------------------------------------
+// Queries
+//-------------------------------------------------------------------------
+const InterestManager::Interest* InterestManager::find(CSteamID peer) const {
+    auto it = m_interests.find(peer);
+    return it == m_interests.end() ? nullptr : &it->second;
+}
+
+bool InterestManager::isInterested(CSteamID peer, sf::Vector2f position) const {
+    const Interest* interest = find(peer);
+    return !interest || interest->leave.contains(position);
+}
+
+void InterestManager::clear() {
+    m_interests.clear();
+}
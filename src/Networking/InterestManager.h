@@ -0,0 +1,83 @@
+#ifndef INTERESTMANAGER_H
+#define INTERESTMANAGER_H
+
+#include <steam/steam_api.h>
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../Utils/SteamHelpers.h"
+#include "../Utils/Config.h"
+
+class EntityManager;
+
+/**
+ * @brief Host-side area of interest (AOI) per client.
+ *
+ * Each client's area is a rectangle around its player the size of a default
+ * view plus a margin. An enemy enters a client's interest set when it comes
+ * within the inner (enter) rectangle and only leaves once it is outside the
+ * larger outer (leave) rectangle, so entities near the border do not flicker
+ * in and out. Both tests go through EntityManager::queryRegion(), so the cost
+ * follows the number of enemies near each player rather than the total.
+ *
+ * Players are not filtered; there are few of them and the HUD shows them all.
+ */
+class InterestManager {
+public:
+    struct Config {
+        sf::Vector2f viewSize = sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT); ///< Assumed client view.
+        float enterMargin = 150.f;  ///< Enemies within this distance of the view enter the set.
+        float leaveMargin = 450.f;  ///< Enemies leave once farther than this from the view.
+    };
+
+    /// One client's area and the enemies currently inside it.
+    struct Interest {
+        sf::Vector2f center;              ///< The client's player.
+        sf::FloatRect enter;              ///< Enter rectangle (view + enterMargin).
+        sf::FloatRect leave;              ///< Leave rectangle (view + leaveMargin).
+        std::vector<uint64_t> enemies;    ///< Sorted enemy ids in the interest set.
+    };
+
+    struct Stats {
+        std::size_t updates = 0;          ///< Per-client interest updates.
+        std::size_t relevant = 0;         ///< Sum of interest set sizes over all updates.
+        std::size_t total = 0;            ///< Sum of live enemy counts over all updates.
+        std::size_t enters = 0;
+        std::size_t leaves = 0;
+    };
+
+    InterestManager();
+    explicit InterestManager(const Config& config);
+
+    /**
+     * @brief Recomputes every client's interest set from its player's position.
+     *
+     * Clients without a known player keep no entry and are not filtered.
+     * @param self The host itself, which needs no interest set.
+     */
+    void update(const EntityManager& entities,
+                const std::unordered_map<CSteamID, bool, CSteamIDHash>& clients,
+                CSteamID self);
+
+    /// Interest of a client, or nullptr if it is not filtered.
+    const Interest* find(CSteamID peer) const;
+
+    /// True if a world position lies in the client's leave rectangle (or it is not filtered).
+    bool isInterested(CSteamID peer, sf::Vector2f position) const;
+
+    void clear();
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    Config m_config;
+    std::unordered_map<CSteamID, Interest, CSteamIDHash> m_interests;
+    std::vector<uint64_t> m_found;    ///< Scratch: enemies in the leave rectangle.
+    std::vector<uint64_t> m_bullets;  ///< Scratch: queryRegion output, unused.
+    std::vector<uint64_t> m_next;     ///< Scratch: the new interest set.
+    Stats m_stats;
+};
+
+#endif // INTERESTMANAGER_H
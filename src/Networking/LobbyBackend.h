@@ -0,0 +1,94 @@
+#ifndef LOBBYBACKEND_H
+#define LOBBYBACKEND_H
+
+#include <steam/steam_api.h>
+
+/**
+ * @brief The few lobby queries LobbyMembershipCache needs, behind an interface.
+ *
+ * The game uses SteamLobbyBackend; tests can substitute an in-process fake
+ * and drive the cache's onChatUpdate()/onDataUpdate() handlers directly.
+ */
+class LobbyBackend {
+public:
+    virtual ~LobbyBackend() = default;
+
+    virtual int getNumMembers(CSteamID lobby) = 0;
+    virtual CSteamID getMemberByIndex(CSteamID lobby, int index) = 0;
+    virtual CSteamID getLobbyOwner(CSteamID lobby) = 0;
+
+    /**
+     * @brief Reads a member data value.
+     * @return Value, or nullptr/"" if unset.
+     */
+    virtual const char* getMemberData(CSteamID lobby, CSteamID member, const char* key) = 0;
+};
+
+/**
+ * @brief LobbyBackend backed by ISteamMatchmaking.
+ */
+class SteamLobbyBackend : public LobbyBackend {
+public:
+    int getNumMembers(CSteamID lobby) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetNumLobbyMembers(lobby) : 0;
+    }
+    CSteamID getMemberByIndex(CSteamID lobby, int index) override {
+        return SteamMatchmaking()->GetLobbyMemberByIndex(lobby, index);
+    }
+    CSteamID getLobbyOwner(CSteamID lobby) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetLobbyOwner(lobby) : k_steamIDNil;
+    }
+    const char* getMemberData(CSteamID lobby, CSteamID member, const char* key) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetLobbyMemberData(lobby, member, key) : nullptr;
+    }
+};
+
+/**
+ * @brief Lobby list queries LobbyBrowser needs, behind an interface.
+ *
+ * The game uses SteamLobbyListBackend; tests can substitute a fake
+ * matchmaking service and feed results through LobbyBrowser::onListReceived().
+ */
+class LobbyListBackend {
+public:
+    virtual ~LobbyListBackend() = default;
+
+    /**
+     * @brief Starts an asynchronous lobby list request for this game.
+     * @param gameId Value of the "game_id" lobby data to filter on.
+     * @return false if the request could not be issued.
+     */
+    virtual bool requestList(const char* gameId) = 0;
+
+    virtual CSteamID getLobbyByIndex(int index) = 0;
+    virtual const char* getLobbyData(CSteamID lobby, const char* key) = 0;
+    virtual int getNumMembers(CSteamID lobby) = 0;
+    virtual int getMemberLimit(CSteamID lobby) = 0;
+};
+
+/**
+ * @brief LobbyListBackend backed by ISteamMatchmaking.
+ */
+class SteamLobbyListBackend : public LobbyListBackend {
+public:
+    bool requestList(const char* gameId) override {
+        if (!SteamMatchmaking()) return false;
+        SteamMatchmaking()->AddRequestLobbyListStringFilter("game_id", gameId, k_ELobbyComparisonEqual);
+        SteamMatchmaking()->AddRequestLobbyListStringFilter("name", "", k_ELobbyComparisonNotEqual);
+        return SteamMatchmaking()->RequestLobbyList() != k_uAPICallInvalid;
+    }
+    CSteamID getLobbyByIndex(int index) override {
+        return SteamMatchmaking()->GetLobbyByIndex(index);
+    }
+    const char* getLobbyData(CSteamID lobby, const char* key) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetLobbyData(lobby, key) : nullptr;
+    }
+    int getNumMembers(CSteamID lobby) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetNumLobbyMembers(lobby) : 0;
+    }
+    int getMemberLimit(CSteamID lobby) override {
+        return SteamMatchmaking() ? SteamMatchmaking()->GetLobbyMemberLimit(lobby) : 0;
+    }
+};
+
+#endif // LOBBYBACKEND_H
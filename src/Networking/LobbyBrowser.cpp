@@ -0,0 +1,261 @@
+#include "LobbyBrowser.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    /// A list request without a LobbyMatchList_t after this long is abandoned.
+    constexpr double kRequestTimeout = 10.0;
+
+    /// Weight of a new sample in the smoothed ping.
+    constexpr float kPingSmoothing = 0.3f;
+}
+
+//-------------------------------------------------------------------------
+// Constructors
+//-------------------------------------------------------------------------
+LobbyBrowser::LobbyBrowser()
+    : LobbyBrowser(std::make_unique<SteamLobbyListBackend>())
+{
+}
+
+LobbyBrowser::LobbyBrowser(std::unique_ptr<LobbyListBackend> backend)
+    : LobbyBrowser(std::move(backend), Config())
+{
+}
+
+LobbyBrowser::LobbyBrowser(std::unique_ptr<LobbyListBackend> backend, const Config& config)
+    : m_cbLobbyMatchList(this, &LobbyBrowser::OnLobbyMatchList),
+      m_backend(std::move(backend)),
+      m_config(config)
+{
+}
+
+double LobbyBrowser::clockSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//-------------------------------------------------------------------------
+// Lifecycle
+//-------------------------------------------------------------------------
+void LobbyBrowser::start(const std::string& gameId, double now) {
+    m_gameId = gameId;
+    m_active = true;
+    m_page = 0;
+    requestRefresh(now);
+}
+
+void LobbyBrowser::stop() {
+    m_active = false;
+    // Outstanding probes are forgotten; late replies no longer match.
+    for (Entry& entry : m_entries)
+        entry.pendingNonce = 0;
+}
+
+void LobbyBrowser::update(double now) {
+    if (!m_active) return;
+
+    if (m_requestInFlight && now - m_requestSentAt > kRequestTimeout)
+        m_requestInFlight = false;
+    if (!m_requestInFlight && now >= m_nextRefreshAt)
+        requestRefresh(now);
+
+    // Expire lost probes.
+    bool changed = false;
+    for (Entry& entry : m_entries) {
+        if (entry.pendingNonce != 0 && now - entry.pingSentAt > m_config.pingTimeout) {
+            entry.pendingNonce = 0;
+            entry.lastPingAt = now;
+            ++entry.failedPings;
+            changed = true;
+        }
+    }
+    if (changed)
+        ++m_version; // Re-sorted with the next list.
+
+    sendProbes(now);
+}
+
+void LobbyBrowser::requestRefresh(double now) {
+    m_nextRefreshAt = now + m_config.refreshInterval;
+    if (m_backend->requestList(m_gameId.c_str())) {
+        m_requestInFlight = true;
+        m_requestSentAt = now;
+    } else {
+        std::cerr << "[LOBBY] RequestLobbyList failed.\n";
+    }
+}
+
+//-------------------------------------------------------------------------
+// Results
+//-------------------------------------------------------------------------
+void LobbyBrowser::OnLobbyMatchList(LobbyMatchList_t* pParam) {
+    onListReceived(pParam->m_nLobbiesMatching, clockSeconds());
+}
+
+void LobbyBrowser::onListReceived(uint32_t count, double now) {
+    m_requestInFlight = false;
+    m_hasResults = true;
+    m_nextRefreshAt = now + m_config.refreshInterval;
+
+    Diff diff;
+    std::vector<Entry> next;
+    next.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const CSteamID id = m_backend->getLobbyByIndex(static_cast<int>(i));
+        const char* name = m_backend->getLobbyData(id, "name");
+        if (!name || !*name) continue;
+
+        const CSteamID host = parseSteamID(m_backend->getLobbyData(id, "host_steam_id"));
+        const int members = m_backend->getNumMembers(id);
+        const int limit = m_backend->getMemberLimit(id);
+
+        auto it = m_index.find(id);
+        if (it == m_index.end()) {
+            Entry entry;
+            entry.id = id;
+            entry.host = host;
+            entry.name = name;
+            entry.members = members;
+            entry.memberLimit = limit;
+            next.push_back(std::move(entry));
+            ++diff.added;
+            continue;
+        }
+
+        // Known lobby: keep its latency history, refresh the listed values.
+        Entry entry = std::move(m_entries[it->second]);
+        bool changed = false;
+        if (entry.host != host) {
+            // A new host invalidates the measured latency.
+            entry.host = host;
+            entry.pingMs = -1.f;
+            entry.failedPings = 0;
+            entry.pendingNonce = 0;
+            entry.lastPingAt = -1.0;
+            changed = true;
+        }
+        if (entry.name != name || entry.members != members || entry.memberLimit != limit) {
+            entry.name = name;
+            entry.members = members;
+            entry.memberLimit = limit;
+            changed = true;
+        }
+        if (changed) ++diff.changed;
+        m_index.erase(it);
+        next.push_back(std::move(entry));
+    }
+    // Whatever is left in the index did not come back.
+    diff.removed = m_index.size();
+
+    m_entries = std::move(next);
+    sortEntries();
+    m_lastDiff = diff;
+    m_page = std::min(m_page, getPageCount() - 1);
+    if (diff.added || diff.removed || diff.changed)
+        ++m_version;
+
+    sendProbes(now);
+}
+
+//-------------------------------------------------------------------------
+// Latency Probes
+//-------------------------------------------------------------------------
+void LobbyBrowser::sendProbes(double now) {
+    if (!m_active || !m_sendPing) return;
+
+    std::size_t candidates = 0;
+    for (Entry& entry : m_entries) {
+        if (candidates >= m_config.pingCandidates) break;
+        if (entry.isFull() || entry.host == k_steamIDNil || entry.failedPings >= m_config.maxFailedPings)
+            continue;
+        ++candidates;
+
+        if (entry.pendingNonce != 0) continue;
+        const bool due = entry.lastPingAt < 0.0 ||
+                         now - entry.lastPingAt >= (entry.pingMs < 0.f ? m_config.pingTimeout : m_config.repingInterval);
+        if (!due) continue;
+
+        const uint32_t nonce = m_nextNonce++;
+        if (m_nextNonce == 0) m_nextNonce = 1;
+        if (m_sendPing(entry.host, nonce)) {
+            entry.pendingNonce = nonce;
+            entry.pingSentAt = now;
+        }
+        entry.lastPingAt = now;
+    }
+}
+
+bool LobbyBrowser::onPong(CSteamID from, uint32_t nonce, double now) {
+    Entry* entry = findByHost(from);
+    if (!entry || nonce == 0 || entry->pendingNonce != nonce)
+        return false;
+
+    const float sample = static_cast<float>((now - entry->pingSentAt) * 1000.0);
+    entry->pingMs = entry->pingMs < 0.f ? sample : entry->pingMs + (sample - entry->pingMs) * kPingSmoothing;
+    entry->pendingNonce = 0;
+    entry->failedPings = 0;
+    entry->lastPingAt = now;
+
+    // Not re-sorted here: rows must not move under the player's cursor.
+    ++m_version;
+    return true;
+}
+
+LobbyBrowser::Entry* LobbyBrowser::findByHost(CSteamID host) {
+    for (Entry& entry : m_entries) {
+        if (entry.host == host)
+            return &entry;
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------
+// Ordering & Pagination
+//-------------------------------------------------------------------------
+void LobbyBrowser::sortEntries() {
+    const int maxFailed = m_config.maxFailedPings;
+    // Joinable before full, reachable before unreachable, measured before
+    // unmeasured (lowest ping first), then by name for a stable order.
+    auto rank = [maxFailed](const Entry& e) {
+        if (e.isFull()) return 3;
+        if (e.failedPings >= maxFailed) return 2;
+        return e.pingMs < 0.f ? 1 : 0;
+    };
+    std::stable_sort(m_entries.begin(), m_entries.end(), [&rank](const Entry& a, const Entry& b) {
+        const int ra = rank(a), rb = rank(b);
+        if (ra != rb) return ra < rb;
+        if (ra == 0 && a.pingMs != b.pingMs) return a.pingMs < b.pingMs;
+        return a.name < b.name;
+    });
+
+    m_index.clear();
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+        m_index.emplace(m_entries[i].id, i);
+}
+
+const LobbyBrowser::Entry* LobbyBrowser::getEntry(std::size_t pageIndex) const {
+    if (pageIndex >= m_config.pageSize) return nullptr;
+    const std::size_t index = m_page * m_config.pageSize + pageIndex;
+    return index < m_entries.size() ? &m_entries[index] : nullptr;
+}
+
+std::size_t LobbyBrowser::getPageCount() const {
+    const std::size_t pageSize = std::max<std::size_t>(1, m_config.pageSize);
+    return std::max<std::size_t>(1, (m_entries.size() + pageSize - 1) / pageSize);
+}
+
+void LobbyBrowser::nextPage() {
+    if (m_page + 1 < getPageCount()) {
+        ++m_page;
+        ++m_version;
+    }
+}
+
+void LobbyBrowser::prevPage() {
+    if (m_page > 0) {
+        --m_page;
+        ++m_version;
+    }
+}
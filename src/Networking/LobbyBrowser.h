@@ -0,0 +1,155 @@
+#ifndef LOBBYBROWSER_H
+#define LOBBYBROWSER_H
+
+#include <steam/steam_api.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LobbyBackend.h"
+#include "../Utils/SteamHelpers.h"
+
+/**
+ * @brief Cached lobby list that refreshes in the background and measures host latency.
+ *
+ * While active, the browser re-requests the lobby list every refreshInterval
+ * seconds and diffs the result against the previous one: known lobbies keep
+ * their entry (and measured ping), new ones are added and vanished ones are
+ * dropped. The hosts of the best few candidates are probed with a small
+ * Ping P2P message; the Pong echoing its nonce gives a round-trip time. Entries are sorted by expected connection quality and
+ * exposed a page at a time. The order only changes when a new list arrives,
+ * so replies in between update pings without moving rows. Every visible
+ * change bumps getVersion().
+ *
+ * All timestamps are seconds from an arbitrary origin (see clockSeconds()),
+ * so a fake backend can drive the browser with a synthetic clock.
+ */
+class LobbyBrowser {
+public:
+    /**
+     * @brief A lobby as shown in the browser.
+     */
+    struct Entry {
+        CSteamID id;
+        CSteamID host;               ///< From the "host_steam_id" lobby data (nil if unset).
+        std::string name;
+        int members = 0;
+        int memberLimit = 0;
+        float pingMs = -1.f;         ///< Smoothed round-trip time; negative while unknown.
+        int failedPings = 0;         ///< Consecutive probes without a reply.
+        uint32_t pendingNonce = 0;   ///< Nonce of the probe in flight (0 if none).
+        double pingSentAt = 0.0;
+        double lastPingAt = -1.0;    ///< When the last probe was sent or answered.
+
+        bool isFull() const { return memberLimit > 0 && members >= memberLimit; }
+    };
+
+    /**
+     * @brief Tuning values.
+     */
+    struct Config {
+        float refreshInterval = 5.f;   ///< Seconds between list requests while active.
+        std::size_t pageSize = 10;     ///< Entries per page (number keys 0-9).
+        std::size_t pingCandidates = 8; ///< How many of the best entries are probed.
+        float pingTimeout = 2.f;       ///< Seconds before a probe counts as lost.
+        float repingInterval = 15.f;   ///< Seconds before a measured host is probed again.
+        int maxFailedPings = 3;        ///< Hosts failing this often are treated as unreachable.
+    };
+
+    /**
+     * @brief Counts from the last diff.
+     */
+    struct Diff {
+        std::size_t added = 0;
+        std::size_t removed = 0;
+        std::size_t changed = 0;
+    };
+
+    /// Sends a Ping with the given nonce to a host; returns false if it could not be sent.
+    using PingSender = std::function<bool(CSteamID host, uint32_t nonce)>;
+
+    LobbyBrowser();                                            ///< Uses SteamLobbyListBackend.
+    explicit LobbyBrowser(std::unique_ptr<LobbyListBackend> backend);
+    LobbyBrowser(std::unique_ptr<LobbyListBackend> backend, const Config& config);
+
+    /// Sets the function used to send Ping messages.
+    void setPingSender(PingSender sender) { m_sendPing = std::move(sender); }
+
+    /**
+     * @brief Starts background refreshing; the first request is issued immediately.
+     * @param gameId Only lobbies whose "game_id" data matches are listed.
+     */
+    void start(const std::string& gameId, double now);
+
+    /**
+     * @brief Stops refreshing and probing; cached entries are kept.
+     */
+    void stop();
+
+    /**
+     * @brief Issues due list requests and latency probes, and expires lost probes.
+     */
+    void update(double now);
+
+    /**
+     * @brief Reads and diffs the results of the last list request.
+     * @param count Number of lobbies reported by the backend.
+     */
+    void onListReceived(uint32_t count, double now);
+
+    /**
+     * @brief Records a probe reply.
+     * @return true if the reply matched a probe in flight.
+     */
+    bool onPong(CSteamID from, uint32_t nonce, double now);
+
+    //--------------------------------------------------------------------------
+    // Pagination
+    //--------------------------------------------------------------------------
+    const std::vector<Entry>& getEntries() const { return m_entries; } ///< Sorted, all pages.
+    const Entry* getEntry(std::size_t pageIndex) const;                ///< Entry on the current page.
+    std::size_t getPage() const { return m_page; }
+    std::size_t getPageCount() const;
+    void nextPage();
+    void prevPage();
+
+    bool isActive() const { return m_active; }
+    bool isRefreshing() const { return m_requestInFlight; }
+    bool hasResults() const { return m_hasResults; }
+    const Diff& getLastDiff() const { return m_lastDiff; }
+    uint32_t getVersion() const { return m_version; }
+    const Config& getConfig() const { return m_config; }
+
+    /// Monotonic seconds, suitable for the `now` arguments.
+    static double clockSeconds();
+
+private:
+    STEAM_CALLBACK(LobbyBrowser, OnLobbyMatchList, LobbyMatchList_t, m_cbLobbyMatchList);
+
+    void requestRefresh(double now);
+    void sendProbes(double now);
+    void sortEntries();
+    Entry* findByHost(CSteamID host);
+
+    std::unique_ptr<LobbyListBackend> m_backend;
+    Config m_config;
+    PingSender m_sendPing;
+    std::string m_gameId;
+
+    std::vector<Entry> m_entries;                                      ///< Sorted by expected quality.
+    std::unordered_map<CSteamID, std::size_t, CSteamIDHash> m_index;   ///< Lobby id -> index in m_entries.
+    Diff m_lastDiff;
+    std::size_t m_page = 0;
+
+    bool m_active = false;
+    bool m_requestInFlight = false;
+    bool m_hasResults = false;
+    double m_nextRefreshAt = 0.0;
+    double m_requestSentAt = 0.0;
+    uint32_t m_nextNonce = 1;
+    uint32_t m_version = 0;
+};
+
+#endif // LOBBYBROWSER_H
@@ -0,0 +1,140 @@
+#include "LobbyMembershipCache.h"
+#include <algorithm>
+#include <cstring>
+
+//-------------------------------------------------------------------------
+// Constructors
+//-------------------------------------------------------------------------
+LobbyMembershipCache::LobbyMembershipCache()
+    : LobbyMembershipCache(std::make_unique<SteamLobbyBackend>())
+{
+}
+
+LobbyMembershipCache::LobbyMembershipCache(std::unique_ptr<LobbyBackend> backend)
+    : m_cbLobbyChatUpdate(this, &LobbyMembershipCache::OnLobbyChatUpdate),
+      m_cbLobbyDataUpdate(this, &LobbyMembershipCache::OnLobbyDataUpdate),
+      m_backend(std::move(backend))
+{
+}
+
+//-------------------------------------------------------------------------
+// Lifecycle
+//-------------------------------------------------------------------------
+void LobbyMembershipCache::reset(CSteamID lobby) {
+    m_lobby = lobby;
+    m_members.clear();
+    m_index.clear();
+    const int count = m_backend->getNumMembers(lobby);
+    for (int i = 0; i < count; ++i)
+        addMember(m_backend->getMemberByIndex(lobby, i));
+    m_owner = m_backend->getLobbyOwner(lobby);
+    ++m_version;
+}
+
+void LobbyMembershipCache::clear() {
+    m_lobby = k_steamIDNil;
+    m_owner = k_steamIDNil;
+    m_members.clear();
+    m_index.clear();
+    ++m_version;
+}
+
+void LobbyMembershipCache::refreshMember(CSteamID member) {
+    onDataUpdate(m_lobby, member);
+}
+
+//-------------------------------------------------------------------------
+// Event Handlers
+//-------------------------------------------------------------------------
+void LobbyMembershipCache::onChatUpdate(CSteamID lobby, CSteamID user, uint32_t stateChange) {
+    if (lobby != m_lobby || m_lobby == k_steamIDNil)
+        return;
+    const uint32_t leftMask = k_EChatMemberStateChangeLeft | k_EChatMemberStateChangeDisconnected |
+                              k_EChatMemberStateChangeKicked | k_EChatMemberStateChangeBanned;
+    if (stateChange & k_EChatMemberStateChangeEntered) {
+        if (!contains(user)) {
+            addMember(user);
+            ++m_version;
+        }
+    } else if (stateChange & leftMask) {
+        const bool removed = contains(user);
+        if (removed)
+            removeMember(user);
+        // Steam hands ownership to another member when the owner leaves.
+        if (refreshOwner() || removed)
+            ++m_version;
+    }
+}
+
+void LobbyMembershipCache::onDataUpdate(CSteamID lobby, CSteamID member) {
+    if (lobby != m_lobby || m_lobby == k_steamIDNil)
+        return;
+    // member == lobby means lobby-wide data changed, which includes the owner.
+    if (member == lobby) {
+        if (refreshOwner())
+            ++m_version;
+        return;
+    }
+    auto it = m_index.find(member);
+    if (it == m_index.end())
+        return;
+    bool ready = readReady(member);
+    if (m_members[it->second].ready != ready) {
+        m_members[it->second].ready = ready;
+        ++m_version;
+    }
+}
+
+void LobbyMembershipCache::OnLobbyChatUpdate(LobbyChatUpdate_t* pParam) {
+    onChatUpdate(CSteamID(pParam->m_ulSteamIDLobby), CSteamID(pParam->m_ulSteamIDUserChanged),
+                 pParam->m_rgfChatMemberStateChange);
+}
+
+void LobbyMembershipCache::OnLobbyDataUpdate(LobbyDataUpdate_t* pParam) {
+    if (!pParam->m_bSuccess)
+        return;
+    onDataUpdate(CSteamID(pParam->m_ulSteamIDLobby), CSteamID(pParam->m_ulSteamIDMember));
+}
+
+//-------------------------------------------------------------------------
+// Queries
+//-------------------------------------------------------------------------
+bool LobbyMembershipCache::isReady(CSteamID id) const {
+    auto it = m_index.find(id);
+    return it != m_index.end() && m_members[it->second].ready;
+}
+
+bool LobbyMembershipCache::allReady() const {
+    return std::all_of(m_members.begin(), m_members.end(), [](const Member& m) { return m.ready; });
+}
+
+//-------------------------------------------------------------------------
+// Internal Helpers
+//-------------------------------------------------------------------------
+void LobbyMembershipCache::addMember(CSteamID id) {
+    m_index[id] = m_members.size();
+    m_members.push_back({ id, readReady(id) });
+}
+
+void LobbyMembershipCache::removeMember(CSteamID id) {
+    // Erase in place so the list keeps join order (LobbyRoster numbers rows by it).
+    auto it = m_index.find(id);
+    const std::size_t slot = it->second;
+    m_index.erase(it);
+    m_members.erase(m_members.begin() + static_cast<std::ptrdiff_t>(slot));
+    for (std::size_t i = slot; i < m_members.size(); ++i)
+        m_index[m_members[i].id] = i;
+}
+
+bool LobbyMembershipCache::refreshOwner() {
+    const CSteamID owner = m_backend->getLobbyOwner(m_lobby);
+    if (owner == m_owner)
+        return false;
+    m_owner = owner;
+    return true;
+}
+
+bool LobbyMembershipCache::readReady(CSteamID id) {
+    const char* value = m_backend->getMemberData(m_lobby, id, "ready");
+    return value && std::strcmp(value, "1") == 0;
+}
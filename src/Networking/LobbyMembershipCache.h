@@ -0,0 +1,86 @@
+#ifndef LOBBYMEMBERSHIPCACHE_H
+#define LOBBYMEMBERSHIPCACHE_H
+
+#include <steam/steam_api.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "LobbyBackend.h"
+#include "../Utils/SteamHelpers.h"
+
+/**
+ * @brief Members of the current lobby, their ready flags and the lobby owner, kept up to date by callbacks.
+ *
+ * reset() reads the member list and owner once when a lobby is entered. After
+ * that, LobbyChatUpdate_t adds and removes members, LobbyDataUpdate_t re-reads
+ * the changed member's "ready" value, and both re-read the owner when it can
+ * have moved (a member left, or lobby-wide data changed), so readers issue no
+ * Steam calls in steady state. Every change bumps getVersion(); consumers compare it with
+ * the version they last synced to decide whether there is anything to do.
+ */
+class LobbyMembershipCache {
+public:
+    /**
+     * @brief A lobby member.
+     */
+    struct Member {
+        CSteamID id;
+        bool ready = false;
+    };
+
+    LobbyMembershipCache();                                       ///< Uses SteamLobbyBackend.
+    explicit LobbyMembershipCache(std::unique_ptr<LobbyBackend> backend);
+
+    /**
+     * @brief Starts tracking a lobby and loads its member list.
+     * @param lobby Lobby that was just entered or created.
+     */
+    void reset(CSteamID lobby);
+
+    /**
+     * @brief Stops tracking (after leaving the lobby).
+     */
+    void clear();
+
+    /**
+     * @brief Re-reads one member's data, e.g. right after setting the local member's data.
+     */
+    void refreshMember(CSteamID member);
+
+    //--------------------------------------------------------------------------
+    // Callback handlers (public so a fake backend can drive them)
+    //--------------------------------------------------------------------------
+    void onChatUpdate(CSteamID lobby, CSteamID user, uint32_t stateChange);
+    void onDataUpdate(CSteamID lobby, CSteamID member);
+
+    //--------------------------------------------------------------------------
+    // Queries (no Steam calls)
+    //--------------------------------------------------------------------------
+    const std::vector<Member>& getMembers() const { return m_members; } ///< In join order.
+    bool contains(CSteamID id) const { return m_index.count(id) != 0; }
+    bool isReady(CSteamID id) const;
+    bool allReady() const;
+    CSteamID getLobby() const { return m_lobby; }
+    CSteamID getOwner() const { return m_owner; } ///< Nil when not in a lobby.
+    bool isOwner(CSteamID id) const { return m_owner != k_steamIDNil && id == m_owner; }
+    uint32_t getVersion() const { return m_version; }
+
+private:
+    STEAM_CALLBACK(LobbyMembershipCache, OnLobbyChatUpdate, LobbyChatUpdate_t, m_cbLobbyChatUpdate);
+    STEAM_CALLBACK(LobbyMembershipCache, OnLobbyDataUpdate, LobbyDataUpdate_t, m_cbLobbyDataUpdate);
+
+    void addMember(CSteamID id);
+    void removeMember(CSteamID id);
+    bool readReady(CSteamID id);
+    bool refreshOwner(); ///< Returns true if the owner changed.
+
+    std::unique_ptr<LobbyBackend> m_backend;
+    CSteamID m_lobby = k_steamIDNil;
+    CSteamID m_owner = k_steamIDNil;
+    std::vector<Member> m_members;                                   ///< Dense member list, in join order.
+    std::unordered_map<CSteamID, std::size_t, CSteamIDHash> m_index; ///< Member id -> index in m_members.
+    uint32_t m_version = 0;
+};
+
+#endif // LOBBYMEMBERSHIPCACHE_H
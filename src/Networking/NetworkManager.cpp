@@ -2,22 +2,35 @@
 #include "../Core/CubeGame.h"
 #include "../States/GameplayState.h"
 #include <steam/steam_api.h>
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 #include <sstream>
 #include <vector>
 #include <chrono>
 
+//-------------------------------------------------------------------------
+// Dispatch Table
+//-------------------------------------------------------------------------
+namespace {
+    // Generated from Wire::Messages: decodes by schema, then calls the matching HandleMessage.
+    constexpr auto kHandlers = Wire::makeDispatchTable<NetworkManager>();
 
+    // Ping/Pong come from players browsing lobbies, not from members.
+    constexpr bool isLatencyProbe(uint8_t id) {
+        return id == static_cast<uint8_t>(Wire::MsgId::Ping) || id == static_cast<uint8_t>(Wire::MsgId::Pong);
+    }
+}
 
 NetworkManager::NetworkManager(bool debugMode, CubeGame* gameInstance)
     : debugMode(debugMode), m_networking(nullptr), isConnectedToHost(false), game(gameInstance),
       m_cbLobbyCreated(this, &NetworkManager::OnLobbyCreated),
       m_cbGameLobbyJoinRequested(this, &NetworkManager::OnGameLobbyJoinRequested),
       m_cbLobbyEnter(this, &NetworkManager::OnLobbyEnter),
+      m_cbLobbyDataUpdate(this, &NetworkManager::OnLobbyDataUpdate),
       m_cbP2PSessionRequest(this, &NetworkManager::OnP2PSessionRequest),
-      m_cbP2PSessionConnectFail(this, &NetworkManager::OnP2PSessionConnectFail),
-      m_cbLobbyMatchList(this, &NetworkManager::OnLobbyMatchList)
+      m_cbP2PSessionConnectFail(this, &NetworkManager::OnP2PSessionConnectFail)
 {
     if (!debugMode) {
         if (!SteamAPI_Init()) {
@@ -33,8 +46,8 @@ NetworkManager::NetworkManager(bool debugMode, CubeGame* gameInstance)
         std::cout << "[NetworkManager] Running in debug mode, Steam not initialized." << std::endl;
     }
     
-    setMessageHandler([this](const std::string &msg, CSteamID sender) {
-        this->ProcessNetworkMessages(msg, sender);
+    setMessageHandler([this](const uint8_t* data, std::size_t size, CSteamID sender) {
+        this->ProcessNetworkMessages(data, size, sender);
     });
 
     usageClock.restart();
@@ -48,27 +61,49 @@ bool NetworkManager::isInitialized() const {
     return debugMode || (SteamUser() && SteamUser()->BLoggedOn());
 }
 
-bool NetworkManager::sendMessage(CSteamID target, const std::string &msg) {
-    if (!m_networking || !SteamUser()) return false;
-    uint32 msgSize = static_cast<uint32>(msg.size() + 1);
-    if (m_networking->SendP2PPacket(target, msg.c_str(), msgSize, k_EP2PSendReliable)) {
-        std::string msgType = msg.substr(0, msg.find('|'));
-        if (msgType.empty()) msgType = msg;
-        networkUsage[msgType].bytesSent += msgSize;
-        networkUsage[msgType].messageCountSent++;
-        return true;
-    }
-    return false;
+bool NetworkManager::sendMessage(CSteamID target, const Wire::ByteWriter &msg) {
+    if (!m_networking || !SteamUser() || msg.empty()) return false;
+    m_outgoing.queue(target, msg);
+    NetworkStats& stats = usageFor(msg.data()[0]);
+    stats.bytesSent += msg.size();
+    stats.messageCountSent++;
+    return true;
 }
 
-bool NetworkManager::broadcastMessage(const std::string &msg) {
-    bool success = true;
-    for (const auto &client : m_connectedClients) {
-        if (!sendMessage(client.first, msg)) {
-            success = false;
-        }
+bool NetworkManager::broadcastMessage(const Wire::ByteWriter &msg, CSteamID exclude) {
+    if (!m_networking || !SteamUser() || msg.empty()) return false;
+    // Encoded once; every peer's queue refers to the same bytes.
+    m_outgoing.queueBroadcast(m_connectedClients, msg, exclude);
+    std::size_t recipients = m_connectedClients.size() - m_connectedClients.count(exclude);
+    NetworkStats& stats = usageFor(msg.data()[0]);
+    stats.bytesSent += msg.size() * recipients;
+    stats.messageCountSent += recipients;
+    return true;
+}
+
+std::size_t NetworkManager::flushOutgoing() {
+    if (m_outgoing.empty() && m_unreliableOut.empty()) return 0;
+    if (!m_networking) {
+        discardOutgoing();
+        return 0;
     }
-    return success;
+    std::size_t sent = m_outgoing.flush([this](CSteamID peer, const uint8_t* data, std::size_t size) {
+        return m_networking->SendP2PPacket(peer, data, static_cast<uint32>(size), k_EP2PSendReliable);
+    });
+    sent += m_unreliableOut.flush([this](CSteamID peer, const uint8_t* data, std::size_t size) {
+        return m_networking->SendP2PPacket(peer, data, static_cast<uint32>(size), k_EP2PSendUnreliable);
+    });
+    return sent;
+}
+
+void NetworkManager::discardOutgoing() {
+    m_outgoing.clear();
+    m_unreliableOut.clear();
+}
+
+void NetworkManager::leftLobby() {
+    discardOutgoing();
+    m_lobbyHost = k_steamIDNil;
 }
 
 void NetworkManager::processCallbacks() {
@@ -95,43 +130,93 @@ void NetworkManager::processCallbacks() {
     }
 }
 
-void NetworkManager::receiveMessages() {
-    if (!m_networking || !SteamUser()) return;
+std::size_t NetworkManager::receiveMessages() {
+    if (!m_networking || !SteamUser()) return 0;
     
+    std::size_t handled = 0;
     uint32 msgSize;
     while (m_networking->IsP2PPacketAvailable(&msgSize)) {
-        char buffer[1024];
+        // Oversized packets are still read, truncated to the buffer, so they
+        // cannot stall the queue; they are then dropped without parsing.
+        const bool oversized = msgSize > m_recvBuffer.size();
         CSteamID sender;
-        if (msgSize > sizeof(buffer) - 1) continue;
-        
-        if (m_networking->ReadP2PPacket(buffer, sizeof(buffer), &msgSize, &sender)) {
-            buffer[msgSize] = '\0';
-            std::string msg(buffer);
-            
-            if (m_connectedClients.find(sender) == m_connectedClients.end()) {
-                acceptSession(sender);
-                m_connectedClients[sender] = true;
+        if (!m_networking->ReadP2PPacket(m_recvBuffer.data(), static_cast<uint32>(m_recvBuffer.size()), &msgSize, &sender))
+            break;
+        if (oversized || msgSize > m_recvBuffer.size()) {
+            ++m_oversizedPackets;
+            if (debugMode)
+                std::cerr << "[ERROR] Dropped an oversized packet from " << sender.ConvertToUint64() << std::endl;
+            continue;
+        }
+
+        const uint8_t* data = m_recvBuffer.data();
+        if (msgSize < 2 || data[0] != Wire::kVersion) {
+            // A peer on another build: drop everything it sends, log once.
+            if (m_incompatiblePeers.insert(sender).second) {
+                std::cerr << "[ERROR] Ignoring packets from " << sender.ConvertToUint64()
+                          << ": wire protocol version " << (msgSize ? static_cast<int>(data[0]) : -1)
+                          << ", expected " << static_cast<int>(Wire::kVersion) << std::endl;
             }
-            
-            if (!game->m_isHost) {
-                const char* hostStr = SteamMatchmaking()->GetLobbyData(game->m_currentLobby, "host_steam_id");
-                if (hostStr && *hostStr && CSteamID(std::stoull(hostStr)) == sender) {
+            continue;
+        }
+
+        bool wellFormed = PacketCoalescer::forEachFrame(data, msgSize, [&](const uint8_t* frame, std::size_t frameSize) {
+            NetworkStats& stats = usageFor(frame[0]);
+            stats.bytesReceived += frameSize;
+            stats.messageCountReceived++;
+            ++handled;
+
+            // Latency probes must not register the sender as a client, and
+            // only lobby members may send anything else.
+            if (!isLatencyProbe(frame[0])) {
+                if (!game->lobbyMembers.contains(sender)) {
+                    ++m_nonMemberFrames;
+                    return;
+                }
+                if (m_connectedClients.find(sender) == m_connectedClients.end()) {
+                    acceptSession(sender);
+                    m_connectedClients[sender] = true;
+                }
+                if (!game->m_isHost && !isConnectedToHost && sender == lobbyHost()) {
                     isConnectedToHost = true;
                 }
             }
-            
-            std::string msgType = msg.substr(0, msg.find('|'));
-            if (msgType.empty()) msgType = msg;
-            networkUsage[msgType].bytesReceived += msgSize;
-            networkUsage[msgType].messageCountReceived++;
+
             if (messageHandler) {
-                messageHandler(msg, sender);
+                messageHandler(frame, frameSize, sender);
             }
+        });
+        if (!wellFormed) {
+            ++m_malformedPackets;
+            if (debugMode)
+                std::cerr << "[ERROR] Dropped the rest of a malformed packet from " << sender.ConvertToUint64() << std::endl;
         }
     }
+    return handled;
+}
+
+void NetworkManager::refreshLobbyHost() {
+    m_lobbyHost = game->m_currentLobby.IsValid()
+        ? parseSteamID(SteamMatchmaking()->GetLobbyData(game->m_currentLobby, "host_steam_id"))
+        : k_steamIDNil;
 }
 
-void NetworkManager::setMessageHandler(std::function<void(const std::string&, CSteamID)> handler) {
+NetworkManager::NetworkStats& NetworkManager::usageFor(uint8_t msgId) {
+    return networkUsage[msgId < networkUsage.size() ? msgId : 0];
+}
+
+Wire::Tick NetworkManager::currentTick() const {
+    // Clients stamp with the newest host tick they have seen, so every
+    // timestamp compared on the host comes from the same clock.
+    return game->m_isHost ? static_cast<Wire::Tick>(game->entityManager->getSimTick()) : m_lastHostTick;
+}
+
+void NetworkManager::observeHostTick(Wire::Tick tick) {
+    if (!game->m_isHost && Wire::tickBefore(m_lastHostTick, tick))
+        m_lastHostTick = tick;
+}
+
+void NetworkManager::setMessageHandler(std::function<void(const uint8_t*, std::size_t, CSteamID)> handler) {
     messageHandler = handler;
 }
 
@@ -160,53 +245,35 @@ void NetworkManager::setIsConnectedToHost(bool b) {
     isConnectedToHost = b;
 }
 
-void NetworkManager::ProcessNetworkMessages(const std::string& msg, CSteamID sender) {
-    if (msg.empty()) return;
+void NetworkManager::ProcessNetworkMessages(const uint8_t* data, std::size_t size, CSteamID sender) {
+    if (size < 1) return;
 
-    if (msg.find("PLAYER_LOADED") == 0) HandlePlayerLoaded(msg);
-    else if (msg[0] == 'P') HandlePlayerUpdate(msg);
-    else if (msg.find("E|SPAWN") == 0) HandleEnemySpawn(msg);
-    else if (msg.find("E|UPDATE") == 0) HandleEnemyUpdate(msg);
-    else if (msg.find("E|DEATH") == 0) HandleEnemyDeath(msg);
-    else if (msg.find("B|fire") == 0) HandleBulletFire(msg, sender);
-    else if (msg[0] == 'H') HandleHit(msg, sender);
-    else if (msg.find("E|REMOVE") == 0) HandleEnemyRemove(msg);
-    else if (msg.find("S|START") == 0) HandleStart(msg);
-    else if (msg.find("S|NEXT") == 0) HandleNextLevel(msg);
-    else if (msg.find("S|TIMER") == 0) HandleTimer(msg);
-    else if (msg.find("S|PLAY") == 0) HandlePlay(msg);
-    else if (msg.find("S|GAMEOVER") == 0) HandleGameOver(msg);
-    else if (msg.find("S|LOBBY") == 0) HandleLobbyReturn(msg);
-    else {
-        std::cout << "[NetworkManager] Unhandled message: " << msg << std::endl;
+    // The reader views the receive buffer in place; handlers decode straight from it.
+    const uint8_t id = data[0];
+    const auto handler = id < kHandlers.size() ? kHandlers[id] : nullptr;
+    Wire::ByteReader reader(data + 1, size - 1);
+    if (!handler) {
+        ++usageFor(id).messageCountMalformed;
+        if (debugMode)
+            std::cout << "[NetworkManager] Unhandled message id " << static_cast<int>(id) << std::endl;
+    } else if (!handler(*this, reader, sender)) {
+        ++usageFor(id).messageCountMalformed;
+        if (debugMode)
+            std::cout << "[NetworkManager] Malformed " << Wire::name(static_cast<Wire::MsgId>(id))
+                      << " from " << sender.ConvertToUint64() << std::endl;
     }
 }
 
-void NetworkManager::HandlePlayerLoaded(const std::string& msg) {
-    uint64_t steamID;
-    if (sscanf(msg.c_str(), "PLAYER_LOADED|%llu", &steamID) == 1) {
-        game->playerLoadedStatus[CSteamID(steamID)] = true;
-    }
+void NetworkManager::HandleMessage(const Wire::Welcome& /*msg*/, CSteamID /*sender*/) {
+    // Only opens the channel; receiveMessages() marks the host connected.
 }
 
-void NetworkManager::HandlePlayerUpdate(const std::string& msg) {
-    std::vector<std::string> parts;
-    std::stringstream ss(msg);
-    std::string part;
-    while (std::getline(ss, part, '|')) parts.push_back(part);
-
-    if (parts[0] != "P" || parts.size() < 3) return;
-
-    CSteamID id;
-    size_t startIdx = 1;
-    if (parts[1] == "D") {
-        id = CSteamID(std::stoull(parts[2]));
-        startIdx = 3;
-    } else {
-        id = CSteamID(std::stoull(parts[1]));
-        startIdx = 2;
-    }
+void NetworkManager::HandleMessage(const Wire::PlayerLoaded& msg, CSteamID /*sender*/) {
+    game->playerLoadedStatus[msg.player] = true;
+}
 
+void NetworkManager::HandleMessage(const Wire::PlayerUpdate& msg, CSteamID /*sender*/) {
+    CSteamID id = msg.player;
     if (game->entityManager->getPlayers().count(id) == 0) {
         Player newPlayer;
         newPlayer.initialize();
@@ -219,185 +286,141 @@ void NetworkManager::HandlePlayerUpdate(const std::string& msg) {
         PlayerState& state = m_playerStates[id];
         state.lastX = p.renderedX;
         state.lastY = p.renderedY;
+        state.targetX = msg.renderedX;
+        state.targetY = msg.renderedY;
         state.interpolationClock.restart();
     }
 
-    for (size_t i = startIdx; i < parts.size(); i += (startIdx == 2 ? 1 : 2)) {
-        if (startIdx == 2) { // Full format: "P|<steamID>|x|...|k|<kills>|..."
-            if (i == 1) continue; // Skip steamID
-            if (i == 2) p.x = std::stof(parts[i]);
-            else if (i == 3) p.y = std::stof(parts[i]);
-            else if (i == 4) p.renderedX = std::stof(parts[i]);
-            else if (i == 5) p.renderedY = std::stof(parts[i]);
-            else if (i == 6) p.health = std::stoi(parts[i]);
-            else if (i == 7) p.kills = std::stoi(parts[i]);
-            else if (i == 8) p.ready = std::stoi(parts[i]) != 0;
-            else if (i == 9) p.money = std::stoi(parts[i]);
-            else if (i == 10) p.speed = std::stof(parts[i]);
-            else if (i == 11) p.isAlive = std::stoi(parts[i]) != 0;
-        } else { // Key-value format: "P|D|<steamID>|k|<kills>|m|<money>|..."
-            if (i + 1 >= parts.size()) break;
-            if (parts[i] == "x") p.x = std::stof(parts[i + 1]);
-            else if (parts[i] == "y") p.y = std::stof(parts[i + 1]);
-            else if (parts[i] == "rx") {
-                p.renderedX = std::stof(parts[i + 1]);
-                if (id != game->localSteamID) m_playerStates[id].targetX = p.renderedX;
-            }
-            else if (parts[i] == "ry") {
-                p.renderedY = std::stof(parts[i + 1]);
-                if (id != game->localSteamID) m_playerStates[id].targetY = p.renderedY;
-            }
-            else if (parts[i] == "h") p.health = std::stoi(parts[i + 1]);
-            else if (parts[i] == "k") p.kills = std::stoi(parts[i + 1]);
-            else if (parts[i] == "r") p.ready = std::stoi(parts[i + 1]) != 0;
-            else if (parts[i] == "m") p.money = std::stoi(parts[i + 1]);
-            else if (parts[i] == "s") p.speed = std::stof(parts[i + 1]);
-            else if (parts[i] == "a") p.isAlive = std::stoi(parts[i + 1]) != 0;
-        }
-    }
-}
-void NetworkManager::HandleEnemySpawn(const std::string& msg) {
-    uint64_t enemyID, timestamp;
-    float x, y, spawnDelay;
-    int health, type;
-    int parsed = sscanf(msg.c_str(), "E|SPAWN|%llu|%f|%f|%d|%f|%d|%llu", 
-                        &enemyID, &x, &y, &health, &spawnDelay, &type, &timestamp);
-    if (parsed == 7) { // Now expecting 7 parameters
-        if (game->entityManager->getEnemies().count(enemyID) == 0 || 
-            (m_lastEnemyUpdateTime.count(enemyID) && m_lastEnemyUpdateTime[enemyID] < timestamp)) {
-            auto& newEnemy = game->entityManager->getEnemies().emplace(enemyID, Enemy()).first->second;
-            newEnemy.initialize(static_cast<Enemy::Type>(type)); // Use the received type
-            newEnemy.id = enemyID;
-            newEnemy.x = x;
-            newEnemy.y = y;
-            newEnemy.health = health;
-            newEnemy.spawnDelay = spawnDelay;
-            newEnemy.renderedX = x;
-            newEnemy.renderedY = y;
-            newEnemy.lastSentX = x;
-            newEnemy.lastSentY = y;
-            newEnemy.interpolationTime = INTERPOLATION_TIME;
-            m_lastEnemyUpdateTime[enemyID] = timestamp;
-        }
-    }
-}
-
-void NetworkManager::HandleEnemyUpdate(const std::string& msg) {
-    uint64_t enemyID, timestamp;
-    float x, y, spawnDelay;
-    int health;
-    if (sscanf(msg.c_str(), "E|UPDATE|%llu|%f|%f|%d|%f|%llu", &enemyID, &x, &y, &health, &spawnDelay, &timestamp) == 6) {
-        if (game->entityManager->getEnemies().count(enemyID) > 0) {
-            if (!m_lastEnemyUpdateTime.count(enemyID) || m_lastEnemyUpdateTime[enemyID] < timestamp) {
-                Enemy& e = game->entityManager->getEnemies()[enemyID];
-                e.lastX = e.renderedX;
-                e.lastY = e.renderedY;
-                e.x = x;
-                e.y = y;
-                e.health = health;
-                e.spawnDelay = spawnDelay;
-                e.interpolationTime = INTERPOLATION_TIME;
-                m_lastEnemyUpdateTime[enemyID] = timestamp;
-            }
-        }
+    p.x = msg.x;
+    p.y = msg.y;
+    p.renderedX = msg.renderedX;
+    p.renderedY = msg.renderedY;
+    p.health = msg.health;
+    p.kills = msg.kills;
+    p.ready = msg.ready;
+    p.money = msg.money;
+    p.speed = msg.speed;
+    p.isAlive = msg.alive;
+}
+
+void NetworkManager::HandleMessage(const Wire::EnemySpawn& msg, CSteamID /*sender*/) {
+    observeHostTick(msg.tick);
+
+    auto& enemies = game->entityManager->getEnemies();
+    auto existing = enemies.find(msg.id);
+    if (existing == enemies.end() ||
+        (existing->second.hasNetTick && Wire::tickBefore(existing->second.netTick, msg.tick))) {
+        auto& newEnemy = enemies.emplace(msg.id, Enemy()).first->second;
+        newEnemy.initialize(static_cast<Enemy::Type>(msg.type)); // Use the received type
+        newEnemy.id = msg.id;
+        newEnemy.x = msg.x;
+        newEnemy.y = msg.y;
+        newEnemy.health = msg.health;
+        newEnemy.spawnDelay = msg.spawnDelay;
+        newEnemy.renderedX = msg.x;
+        newEnemy.renderedY = msg.y;
+        newEnemy.interpolationTime = INTERPOLATION_TIME;
+        newEnemy.netTick = msg.tick;
+        newEnemy.hasNetTick = true;
+    }
+}
+
+void NetworkManager::HandleMessage(const Wire::EnemyUpdate& msg, CSteamID /*sender*/) {
+    observeHostTick(msg.tick);
+
+    auto it = game->entityManager->getEnemies().find(msg.id);
+    if (it == game->entityManager->getEnemies().end()) return;
+    // The channel is ordered, so an update stamped with the same tick is the newer one.
+    Enemy& e = it->second;
+    if (!e.hasNetTick || !Wire::tickBefore(msg.tick, e.netTick)) {
+        e.lastX = e.renderedX;
+        e.lastY = e.renderedY;
+        e.x = msg.x;
+        e.y = msg.y;
+        e.health = msg.health;
+        e.spawnDelay = msg.spawnDelay;
+        e.interpolationTime = INTERPOLATION_TIME;
+        e.netTick = msg.tick;
+        e.hasNetTick = true;
+    }
+}
+
+void NetworkManager::HandleMessage(const Wire::EnemyDeath& msg, CSteamID /*sender*/) {
+    observeHostTick(msg.tick);
+
+    auto it = game->entityManager->getEnemies().find(msg.id);
+    if (it == game->entityManager->getEnemies().end()) return;
+    if (!it->second.hasNetTick || !Wire::tickBefore(msg.tick, it->second.netTick)) {
+        if (GameplayState* gameplayState = game->GetGameplayState())
+            gameplayState->SpawnEnemyEffect(ParticleEffect::Death, it->second);
+        game->entityManager->getEnemies().erase(it);
+        std::cout << "[DEBUG] Enemy " << msg.id << " marked as dead by killer " << msg.killer.ConvertToUint64() << std::endl;
+    }
+}
+
+void NetworkManager::HandleMessage(const Wire::BulletFire& msg, CSteamID sender) {
+    if (game->processedBulletMessages.find(msg.messageId) != game->processedBulletMessages.end()) {
+        return;
     }
-}
+    game->processedBulletMessages.insert(msg.messageId);
 
-void NetworkManager::HandleEnemyDeath(const std::string& msg) {
-    uint64_t enemyID, timestamp, killerID;
-    if (sscanf(msg.c_str(), "E|DEATH|%llu|%llu|%llu", &enemyID, &timestamp, &killerID) == 3) {
-        if (!m_lastEnemyUpdateTime.count(enemyID) || m_lastEnemyUpdateTime[enemyID] < timestamp) {
-            game->entityManager->getEnemies().erase(enemyID);
-            m_lastEnemyUpdateTime[enemyID] = timestamp;
-            std::cout << "[DEBUG] Enemy " << enemyID << " marked as dead by killer " << killerID << std::endl;
-        }
+    uint64_t uniqueBulletId = (msg.shooter.ConvertToUint64() << 32) | msg.bulletIndex;
+    if (game->entityManager->getBullets().find(uniqueBulletId) == game->entityManager->getBullets().end()) {
+        Bullet newBullet;
+        newBullet.initialize(msg.startX, msg.startY, msg.targetX, msg.targetY);
+        newBullet.id = uniqueBulletId;
+        newBullet.lifetime = msg.lifetime;
+        newBullet.renderedX = msg.startX;
+        newBullet.renderedY = msg.startY;
+        game->entityManager->getBullets()[uniqueBulletId] = newBullet;
     }
-}
-
-void NetworkManager::HandleBulletFire(const std::string& msg, CSteamID sender) {
-    uint32_t messageID;
-    uint64_t shooterSteamID;
-    int bulletIdx;
-    float startX, startY, targetX, targetY, lifetime;
-    int parsed = sscanf(msg.c_str(), "B|fire|%u|%llu|%d|%f|%f|%f|%f|%f", &messageID, &shooterSteamID, &bulletIdx,
-                        &startX, &startY, &targetX, &targetY, &lifetime);
-    if (parsed == 8) {
-        if (game->processedBulletMessages.find(messageID) != game->processedBulletMessages.end()) {
-            return;
-        }
-        game->processedBulletMessages.insert(messageID);
-
-        uint64_t uniqueBulletId = (shooterSteamID << 32) | static_cast<uint32_t>(bulletIdx);
-        if (game->entityManager->getBullets().find(uniqueBulletId) == game->entityManager->getBullets().end()) {
-            Bullet newBullet;
-            newBullet.initialize(startX, startY, targetX, targetY);
-            newBullet.id = uniqueBulletId;
-            newBullet.lifetime = lifetime;
-            newBullet.renderedX = startX;
-            newBullet.renderedY = startY;
-            game->entityManager->getBullets()[uniqueBulletId] = newBullet;
-        }
-        if (game->m_isHost) {
-            broadcastMessage(msg);
-        }
+    // Relay a client's bullet to everyone else near it; the shooter already
+    // has it, and the host's own bullets were sent directly.
+    if (game->m_isHost && sender != game->localSteamID) {
+        Wire::encode(m_writer, msg);
+        broadcastNear(m_writer, sf::Vector2f(msg.startX, msg.startY), sender);
     }
 }
 
-void NetworkManager::HandleEnemyRemove(const std::string& msg) {
-    uint64_t enemyID;
-    if (sscanf(msg.c_str(), "E|REMOVE|%llu", &enemyID) == 1) {
-        if (game->entityManager->getEnemies().count(enemyID)) {
-            game->entityManager->getEnemies().erase(enemyID);
-            std::cout << "[DEBUG] Removed enemy " << enemyID << " from client" << std::endl;
-        }
+void NetworkManager::HandleMessage(const Wire::EnemyRemove& msg, CSteamID /*sender*/) {
+    if (game->entityManager->getEnemies().count(msg.id)) {
+        if (GameplayState* gameplayState = game->GetGameplayState())
+            gameplayState->SpawnEnemyEffect(ParticleEffect::Death, game->entityManager->getEnemies()[msg.id]);
+        game->entityManager->getEnemies().erase(msg.id);
+        std::cout << "[DEBUG] Removed enemy " << msg.id << " from client" << std::endl;
     }
 }
 
-void NetworkManager::HandleHit(const std::string& msg, CSteamID sender) {
-    uint64_t bulletId, enemyId, shooterSteamID, timestamp;
-    int damage;
-    if (sscanf(msg.c_str(), "H|%llu|%llu|%llu|%d|%llu", &bulletId, &enemyId, &shooterSteamID, &damage, &timestamp) != 5) {
-        return;
-    }
+void NetworkManager::HandleMessage(const Wire::Hit& msg, CSteamID /*sender*/) {
+    const uint64_t enemyId = msg.enemyId;
 
     if (game->m_isHost) {
         if (game->entityManager->getEnemies().count(enemyId) > 0) {
             Enemy& e = game->entityManager->getEnemies()[enemyId];
-            if (!m_lastEnemyUpdateTime.count(enemyId) || m_lastEnemyUpdateTime[enemyId] < timestamp) {
-                e.health -= damage;
-                m_lastEnemyUpdateTime[enemyId] = timestamp;
+            // Hits stamped with the same host tick are distinct bullets; only older ones are stale.
+            if (!e.hasNetTick || !Wire::tickBefore(msg.tick, e.netTick)) {
+                e.health -= msg.damage;
+                e.netTick = msg.tick;
+                e.hasNetTick = true;
                 
-                CSteamID shooterID(shooterSteamID);
+                CSteamID shooterID = msg.shooter;
                 if (e.health <= 0) {
                     // Update player stats
                     if (game->entityManager->getPlayers().count(shooterID) > 0) {
                         Player& p = game->entityManager->getPlayers()[shooterID];
                         p.kills++;
                         p.money += 10;
-                        // Broadcast updated player state
-                        std::string playerUpdateMsg = game->FormatPlayerUpdate(p);
-                        if (!playerUpdateMsg.empty()) {
-                            broadcastMessage(playerUpdateMsg);
-                        }
-                    }
-                    // Broadcast enemy removal
-                    char buffer[64];
-                    int bytes = snprintf(buffer, sizeof(buffer), "E|REMOVE|%llu", enemyId);
-                    if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                        broadcastMessage(std::string(buffer));
                     }
+                    // Clients see the kill and the removal in the next snapshot.
+                    if (GameplayState* gameplayState = game->GetGameplayState())
+                        gameplayState->SpawnEnemyEffect(ParticleEffect::Death, e);
                     game->entityManager->getEnemies().erase(enemyId);
                 } else {
-                    // Broadcast updated enemy state
-                    char buffer[128];
-                    int bytes = snprintf(buffer, sizeof(buffer), "E|UPDATE|%llu|%.1f|%.1f|%d|%.2f|%llu",
-                                        enemyId, e.x, e.y, e.health, e.spawnDelay, timestamp);
-                    if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                        broadcastMessage(std::string(buffer));
-                    }
+                    if (GameplayState* gameplayState = game->GetGameplayState())
+                        gameplayState->SpawnEnemyEffect(ParticleEffect::Hit, e);
                 }
                 // Remove bullet on hit
-                game->entityManager->getBullets().erase(bulletId);
+                game->entityManager->getBullets().erase(msg.bulletId());
             }
         }
     } else {
@@ -405,127 +428,186 @@ void NetworkManager::HandleHit(const std::string& msg, CSteamID sender) {
         if (!game->entityManager->getEnemies().count(enemyId)) {
             GameplayState* gameplayState = game->GetGameplayState();
             if (gameplayState) {
-                gameplayState->pendingHits.push_back({bulletId, enemyId, shooterSteamID, 0.5f});
+                gameplayState->pendingHits.push_back({msg.bulletId(), enemyId, msg.shooter.ConvertToUint64(), 0.5f});
                 std::cout << "[DEBUG] Client queued hit for enemy " << enemyId << " (not found yet)" << std::endl;
             }
         }
     }
 }
 
-void NetworkManager::HandleStart(const std::string& msg) {
+void NetworkManager::HandleMessage(const Wire::Start& /*msg*/, CSteamID /*sender*/) {
     if (game->currentState != GameState::Playing) {
         game->StartGame();
         game->currentState = GameState::Playing;
     }
 }
 
-void NetworkManager::HandleNextLevel(const std::string& msg) {
-    float duration;
-    if (sscanf(msg.c_str(), "S|NEXT|%f", &duration) == 1) {
-        auto gameplayState = game->GetGameplayState();
-        if (gameplayState) {
-            gameplayState->StartNextLevelTimer(duration);
-        }
+void NetworkManager::HandleMessage(const Wire::NextLevel& msg, CSteamID /*sender*/) {
+    auto gameplayState = game->GetGameplayState();
+    if (gameplayState) {
+        gameplayState->StartNextLevelTimer(msg.duration);
     }
 }
 
-void NetworkManager::HandleTimer(const std::string& msg) {
-    float timerValue;
-    if (sscanf(msg.c_str(), "S|TIMER|%f", &timerValue) == 1) {
-        auto gameplayState = game->GetGameplayState();
-        if (gameplayState) {
-            gameplayState->nextLevelTimer = timerValue;
-            gameplayState->timerActive = (timerValue > 0);
-        }
+void NetworkManager::HandleMessage(const Wire::Timer& msg, CSteamID /*sender*/) {
+    auto gameplayState = game->GetGameplayState();
+    if (gameplayState) {
+        gameplayState->nextLevelTimer = msg.remaining;
+        gameplayState->timerActive = (msg.remaining > 0);
     }
 }
 
-void NetworkManager::HandlePlay(const std::string& msg) {
+void NetworkManager::HandleMessage(const Wire::Play& /*msg*/, CSteamID /*sender*/) {
     game->currentState = GameState::Playing;
 }
 
-void NetworkManager::HandleGameOver(const std::string& msg) {
+void NetworkManager::HandleMessage(const Wire::GameOver& /*msg*/, CSteamID /*sender*/) {
     game->currentState = GameState::GameOver;
 }
 
-void NetworkManager::HandleLobbyReturn(const std::string& msg) {
+void NetworkManager::HandleMessage(const Wire::LobbyReturn& /*msg*/, CSteamID /*sender*/) {
     game->ReturnToLobby();
 }
 
+void NetworkManager::HandleMessage(const Wire::Ping& msg, CSteamID sender) {
+    // Echo the nonce so the browser can match the reply to its probe.
+    Wire::Pong pong;
+    pong.nonce = msg.nonce;
+    sendMessage(sender, pong);
+}
+
+void NetworkManager::HandleMessage(const Wire::Pong& msg, CSteamID sender) {
+    game->lobbyBrowser.onPong(sender, msg.nonce, LobbyBrowser::clockSeconds());
+}
+
 void NetworkManager::ReportNetworkUsage() const {
     std::cout << "\n[Network Usage Report] Period: " << usageReportInterval << " seconds\n";
     std::cout << "--------------------------------------------------\n";
-    std::cout << "Message Type | Bytes Sent | Bytes Received | Sent Count | Received Count\n";
+    std::cout << "Message Type | Bytes Sent | Bytes Received | Sent Count | Received Count | Malformed\n";
     std::cout << "--------------------------------------------------\n";
 
     size_t totalBytesSent = 0, totalBytesReceived = 0;
-    size_t totalSentCount = 0, totalReceivedCount = 0;
+    size_t totalSentCount = 0, totalReceivedCount = 0, totalMalformed = 0;
 
-    for (const auto& [msgType, stats] : networkUsage) {
-        std::cout << msgType << " | "
+    for (std::size_t i = 0; i < networkUsage.size(); ++i) {
+        const NetworkStats& stats = networkUsage[i];
+        if (stats.messageCountSent == 0 && stats.messageCountReceived == 0) continue;
+        std::cout << Wire::name(static_cast<Wire::MsgId>(i)) << " | "
                   << stats.bytesSent << " | "
                   << stats.bytesReceived << " | "
                   << stats.messageCountSent << " | "
-                  << stats.messageCountReceived << "\n";
+                  << stats.messageCountReceived << " | "
+                  << stats.messageCountMalformed << "\n";
         totalBytesSent += stats.bytesSent;
         totalBytesReceived += stats.bytesReceived;
         totalSentCount += stats.messageCountSent;
         totalReceivedCount += stats.messageCountReceived;
+        totalMalformed += stats.messageCountMalformed;
     }
 
     std::cout << "--------------------------------------------------\n";
     std::cout << "Total | " << totalBytesSent << " | " << totalBytesReceived << " | "
-              << totalSentCount << " | " << totalReceivedCount << "\n";
+              << totalSentCount << " | " << totalReceivedCount << " | " << totalMalformed << "\n";
+    if (m_malformedPackets > 0)
+        std::cout << "Malformed packets (bad framing): " << m_malformedPackets << "\n";
+    if (m_oversizedPackets > 0)
+        std::cout << "Oversized packets: " << m_oversizedPackets << "\n";
+    if (m_nonMemberFrames > 0)
+        std::cout << "Dropped messages from non-members: " << m_nonMemberFrames << "\n";
     std::cout << "Bandwidth (KB/s): Sent = " << (totalBytesSent / 1024.0f) / usageReportInterval
               << ", Received = " << (totalBytesReceived / 1024.0f) / usageReportInterval << "\n";
+
+    // Outbound packets versus one packet per message per peer (the previous scheme).
+    const PacketCoalescer::Stats& out = m_outgoing.getStats();
+    if (out.frames > 0) {
+        std::cout << "Packets/s: coalesced = " << out.packets / usageReportInterval
+                  << ", uncoalesced = " << out.uncoalescedPackets / usageReportInterval
+                  << " (" << static_cast<float>(out.frames) / std::max<std::size_t>(out.packets, 1) << " msgs/packet, "
+                  << out.sharedPackets << " packets reused across peers)\n";
+        std::cout << "Overhead/packet (bytes): coalesced = "
+                  << static_cast<float>(out.overheadBytes) / std::max<std::size_t>(out.packets, 1)
+                  << " of " << static_cast<float>(out.overheadBytes + out.payloadBytes) / std::max<std::size_t>(out.packets, 1)
+                  << ", uncoalesced = " << static_cast<float>(out.uncoalescedOverhead) / out.uncoalescedPackets
+                  << " of " << static_cast<float>(out.uncoalescedOverhead + out.payloadBytes) / out.uncoalescedPackets << "\n";
+        if (out.failedPackets > 0)
+            std::cout << "Failed packets: " << out.failedPackets << "\n";
+    }
+
+    const SnapshotReplicator::Stats& snap = m_snapshots.getStats();
+    if (snap.snapshots > 0) {
+        std::cout << "Snapshots: " << snap.snapshots << (game->m_isHost ? " captured" : " applied");
+        if (game->m_isHost) {
+            const std::size_t sends = snap.fullSends + snap.deltaSends;
+            std::cout << ", " << snap.deltaSends << " deltas / " << snap.fullSends << " full sends, "
+                      << static_cast<float>(snap.bodyBytes) / std::max<std::size_t>(sends, 1) << " bytes/send, "
+                      << snap.parts << " parts in " << m_unreliableOut.getStats().packets << " unreliable packets";
+        }
+        std::cout << ", " << snap.resyncs << " resyncs\n";
+    }
+
+    const InterestManager::Stats& aoi = m_interest.getStats();
+    if (aoi.updates > 0) {
+        std::cout << "Interest: " << static_cast<float>(aoi.relevant) / aoi.updates << " of "
+                  << static_cast<float>(aoi.total) / aoi.updates << " enemies per client, "
+                  << aoi.enters << " enters, " << aoi.leaves << " leaves\n";
+    }
+
+    // Per-client send budget (area-of-interest clients only).
+    for (const auto& client : m_connectedClients) {
+        const SendScheduler* scheduler = game->m_isHost ? m_snapshots.scheduler(client.first) : nullptr;
+        if (!scheduler || scheduler->getStats().bytes == 0) continue;
+        const SendScheduler::Stats& s = scheduler->getStats();
+        std::cout << "Client " << client.first.GetAccountID() << ": " << scheduler->rate() / 1024.f << " KB/s budget, "
+                  << s.bytes / usageReportInterval / 1024.f << " KB/s sent, RTT " << scheduler->rttSeconds() * 1000.f
+                  << " ms, loss " << scheduler->lossRate() * 100.f << "%, " << s.decreases << " rate cuts, "
+                  << s.deferred << " updates deferred\n";
+    }
 }
 
 void NetworkManager::ResetNetworkUsage() {
-    networkUsage.clear();
+    networkUsage.fill(NetworkStats());
+    m_malformedPackets = 0;
+    m_oversizedPackets = 0;
+    m_nonMemberFrames = 0;
+    m_outgoing.resetStats();
+    m_unreliableOut.resetStats();
+    m_snapshots.resetStats();
+    m_interest.resetStats();
 }
 
 void NetworkManager::SendPlayerUpdate() {
     Player& p = game->entityManager->getPlayers()[game->localSteamID];
     if (std::isnan(p.x) || std::isnan(p.y)) p.x = p.y = 0.0f;
+    SendGameplayMessage(game->MakePlayerUpdate(p));
+}
 
-    std::ostringstream oss;
-    oss << "P|D|" << p.steamID.ConvertToUint64()
-        << "|x|" << p.x
-        << "|y|" << p.y
-        << "|rx|" << p.renderedX
-        << "|ry|" << p.renderedY
-        << "|h|" << p.health
-        << "|k|" << p.kills
-        << "|r|" << (p.ready ? 1 : 0)
-        << "|m|" << p.money
-        << "|s|" << p.speed
-        << "|a|" << (p.isAlive ? 1 : 0);
-
-    std::string msg = oss.str();
+void NetworkManager::SendGameplayMessage(const Wire::ByteWriter& msg) {
     if (game->m_isHost) {
         broadcastMessage(msg);
     } else {
-        const char* hostStr = SteamMatchmaking()->GetLobbyData(game->m_currentLobby, "host_steam_id");
-        if (hostStr && *hostStr) {
-            CSteamID hostID(std::stoull(hostStr));
+        CSteamID hostID = lobbyHost();
+        if (hostID.IsValid()) {
             sendMessage(hostID, msg);
         }
     }
 }
 
-void NetworkManager::SendGameplayMessage(const std::string& msg) {
-    if (game->m_isHost) {
-        broadcastMessage(msg);
-    } else {
-        const char* hostStr = SteamMatchmaking()->GetLobbyData(game->m_currentLobby, "host_steam_id");
-        if (hostStr && *hostStr) {
-            CSteamID hostID(std::stoull(hostStr));
-            sendMessage(hostID, msg);
-        }
+void NetworkManager::SendGameplayMessage(const Wire::ByteWriter& msg, sf::Vector2f position) {
+    if (game->m_isHost)
+        broadcastNear(msg, position);
+    else
+        SendGameplayMessage(msg);
+}
+
+void NetworkManager::broadcastNear(const Wire::ByteWriter& msg, sf::Vector2f position, CSteamID exclude) {
+    for (const auto& client : m_connectedClients) {
+        if (client.first != exclude && m_interest.isInterested(client.first, position))
+            sendMessage(client.first, msg);
     }
 }
 
 void NetworkManager::ThrottledSendPlayerUpdate() {
+    if (game->m_isHost) return; // The host's player travels in snapshots.
     const float playerUpdateRate = 0.016f; // ~62.5 Hz
     if (m_playerUpdateClock.getElapsedTime().asSeconds() >= playerUpdateRate) {
         SendPlayerUpdate();
@@ -533,7 +615,7 @@ void NetworkManager::ThrottledSendPlayerUpdate() {
     }
 }
 
-void NetworkManager::SpawnEnemiesAndBroadcast() {
+void NetworkManager::SpawnEnemyWave() {
     if (!game->m_isHost) return;
 
     game->GetEntityManager()->spawnEnemies(
@@ -541,85 +623,191 @@ void NetworkManager::SpawnEnemiesAndBroadcast() {
         game->GetPlayers(),
         game->GetLocalPlayer().steamID.ConvertToUint64()
     );
-
-    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-
-    for (const auto& pair : game->GetEntityManager()->getEnemies()) {
-        const Enemy& enemy = pair.second;
-        char buffer[128];
-        int bytes = snprintf(buffer, sizeof(buffer), "E|SPAWN|%llu|%.1f|%.1f|%d|%.2f|%d|%llu",
-                             enemy.id, enemy.x, enemy.y, enemy.health, enemy.spawnDelay,
-                             static_cast<int>(enemy.type), timestamp);
-        if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-            broadcastMessage(std::string(buffer));
-            m_lastEnemyUpdateTime[enemy.id] = timestamp;
-        }
-    }
 }
 
-void NetworkManager::SyncEnemies() {
-    if (!game->m_isHost) return;
-    
-    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    
-    for (auto it = game->entityManager->getEnemies().begin(); it != game->entityManager->getEnemies().end();) {
-        Enemy& enemy = it->second;
-        if (enemy.health <= 0) {
-            char buffer[64];
-            int bytes = snprintf(buffer, sizeof(buffer), "E|REMOVE|%llu", enemy.id);
-            if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                broadcastMessage(std::string(buffer));
-            }
-            it = game->entityManager->getEnemies().erase(it);
-        } else {
-            char buffer[128];
-            int bytes = snprintf(buffer, sizeof(buffer), "E|UPDATE|%llu|%.1f|%.1f|%d|%.2f|%llu",
-                                enemy.id, enemy.x, enemy.y, enemy.health, enemy.spawnDelay, timestamp);
-            if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                broadcastMessage(std::string(buffer));
-                m_lastEnemyUpdateTime[enemy.id] = timestamp;
-            }
-            ++it;
+//-------------------------------------------------------------------------
+// Snapshot Replication
+//-------------------------------------------------------------------------
+
+/**
+ * @brief Applies snapshot differences through the regular message handlers,
+ *        so replicated entities get the same interpolation and effects.
+ */
+struct NetworkManager::SnapshotApplier : SnapshotVisitor {
+    SnapshotApplier(NetworkManager& net, Wire::Tick tick) : net(net), tick(tick) {}
+
+    void enemyAdded(const EnemyNetState& now) override {
+        Wire::EnemySpawn spawn;
+        spawn.id = now.id;
+        spawn.x = Wire::dequantizePosition(now.x, Wire::Codec::PosX::origin());
+        spawn.y = Wire::dequantizePosition(now.y, Wire::Codec::PosY::origin());
+        spawn.health = now.health;
+        spawn.spawnDelay = Wire::dequantizeTimer(now.spawnDelay);
+        spawn.type = now.type;
+        spawn.tick = tick;
+        net.HandleMessage(spawn, CSteamID());
+    }
+
+    void enemyChanged(const EnemyNetState& before, const EnemyNetState& now) override {
+        // A predicted kill erases the enemy locally; if the host rejected the
+        // hit it is still alive there and comes back here.
+        if (before.type != now.type || !net.game->entityManager->getEnemies().count(now.id)) {
+            enemyAdded(now);
+            return;
         }
-    }
-}
-
-void NetworkManager::SyncEnemiesFull() {
-    if (!game->m_isHost) return;
-    
-    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    
-    for (const auto& pair : game->entityManager->getEnemies()) {
-        const Enemy& enemy = pair.second;
-        if (enemy.health > 0) {
-            char buffer[128];
-            int bytes = snprintf(buffer, sizeof(buffer), "E|SPAWN|%llu|%.1f|%.1f|%d|%.2f|%llu",
-                                enemy.id, enemy.x, enemy.y, enemy.health, enemy.spawnDelay, timestamp);
-            if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                broadcastMessage(std::string(buffer));
-                m_lastEnemyUpdateTime[enemy.id] = timestamp;
-            }
+        Wire::EnemyUpdate update;
+        update.id = now.id;
+        update.x = Wire::dequantizePosition(now.x, Wire::Codec::PosX::origin());
+        update.y = Wire::dequantizePosition(now.y, Wire::Codec::PosY::origin());
+        update.health = now.health;
+        update.spawnDelay = Wire::dequantizeTimer(now.spawnDelay);
+        update.tick = tick;
+        net.HandleMessage(update, CSteamID());
+    }
+
+    void enemyRemoved(uint64_t id) override {
+        Wire::EnemyRemove remove;
+        remove.id = id;
+        net.HandleMessage(remove, CSteamID());
+    }
+
+    void enemyLeft(uint64_t id) override {
+        // Out of range, not dead: no death effect. It re-enters as a fresh spawn.
+        net.game->entityManager->getEnemies().erase(id);
+    }
+
+    void playerAdded(const PlayerNetState& now) override { apply(now); }
+    void playerChanged(const PlayerNetState& /*before*/, const PlayerNetState& now) override { apply(now); }
+    // Players leave through the lobby, not through snapshots.
+
+    void apply(const PlayerNetState& s) {
+        CSteamID id = playerFor(s.account);
+        auto& players = net.game->entityManager->getPlayers();
+        if (id == net.game->localSteamID) {
+            // Movement is predicted locally; take only the host's verdicts.
+            auto it = players.find(id);
+            if (it == players.end()) return;
+            it->second.health = s.health;
+            it->second.kills = s.kills;
+            it->second.money = s.money;
+            it->second.isAlive = (s.flags & PlayerNetState::Alive) != 0;
+            return;
+        }
+        Wire::PlayerUpdate update;
+        update.player = id;
+        update.x = update.renderedX = Wire::dequantizePosition(s.x, Wire::Codec::PosX::origin());
+        update.y = update.renderedY = Wire::dequantizePosition(s.y, Wire::Codec::PosY::origin());
+        update.health = s.health;
+        update.kills = s.kills;
+        update.money = s.money;
+        update.speed = Wire::dequantizeSpeed(s.speed);
+        update.ready = (s.flags & PlayerNetState::Ready) != 0;
+        update.alive = (s.flags & PlayerNetState::Alive) != 0;
+        net.HandleMessage(update, CSteamID());
+    }
+
+    CSteamID playerFor(uint32_t account) const {
+        for (const auto& pair : net.game->entityManager->getPlayers())
+            if (pair.first.GetAccountID() == account) return pair.first;
+        return CSteamID(account, k_EUniversePublic, k_EAccountTypeIndividual);
+    }
+
+    NetworkManager& net;
+    Wire::Tick tick;
+};
+
+void NetworkManager::HandleMessage(const Wire::SnapshotPart& msg, CSteamID sender) {
+    // Only the host's snapshots count, and only once the game is running here.
+    if (game->m_isHost || sender != lobbyHost() || game->currentState != GameState::Playing) return;
+    observeHostTick(msg.tick);
+
+    SnapshotApplier applier(*this, msg.tick);
+    switch (m_snapshots.onPart(msg, applier)) {
+        case SnapshotReplicator::PartResult::Applied: {
+            Wire::SnapshotAck ack;
+            ack.seq = msg.seq;
+            sendMessage(sender, ack);
+            break;
+        }
+        case SnapshotReplicator::PartResult::NeedResync: {
+            Wire::SnapshotAck ack;
+            ack.seq = msg.seq;
+            ack.resync = true;
+            sendMessage(sender, ack);
+            if (debugMode)
+                std::cout << "[DEBUG] Snapshot " << msg.seq << " needs baseline " << msg.baseline << "; requested a full one" << std::endl;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void NetworkManager::HandleMessage(const Wire::SnapshotAck& msg, CSteamID sender) {
+    if (game->m_isHost)
+        m_snapshots.onAck(sender, msg, currentTick());
+}
+
+void NetworkManager::CaptureSnapshot(WorldSnapshot& snapshot) const {
+    const float originX = Wire::Codec::PosX::origin();
+    const float originY = Wire::Codec::PosY::origin();
+    const EntityManager& entities = *game->entityManager;
+
+    snapshot.enemies.reserve(entities.getEnemies().size());
+    for (const auto& [id, e] : entities.getEnemies()) {
+        if (e.health <= 0) continue; // Removed on clients; the host erases it shortly.
+        EnemyNetState s;
+        s.id = id;
+        s.x = Wire::quantizePosition(e.x, originX);
+        s.y = Wire::quantizePosition(e.y, originY);
+        s.health = static_cast<uint8_t>(std::clamp(e.health, 0, 255));
+        s.spawnDelay = Wire::quantizeTimer(e.spawnDelay);
+        s.type = static_cast<uint8_t>(e.type);
+        snapshot.enemies.push_back(s);
+    }
+
+    snapshot.players.reserve(entities.getPlayers().size());
+    for (const auto& [id, p] : entities.getPlayers()) {
+        PlayerNetState s;
+        s.account = id.GetAccountID();
+        s.x = Wire::quantizePosition(p.x, originX);
+        s.y = Wire::quantizePosition(p.y, originY);
+        s.health = p.health;
+        s.kills = p.kills;
+        s.money = p.money;
+        s.speed = Wire::quantizeSpeed(p.speed);
+        s.flags = (p.ready ? PlayerNetState::Ready : 0) | (p.isAlive ? PlayerNetState::Alive : 0);
+        snapshot.players.push_back(s);
+    }
+}
+
+void NetworkManager::UpdateSnapshots() {
+    if (!game->m_isHost || !m_snapshots.shouldCapture()) return;
+
+    CaptureSnapshot(m_snapshots.beginCapture(currentTick()));
+    m_snapshots.endCapture();
+    m_interest.update(*game->entityManager, m_connectedClients, game->localSteamID);
+
+    for (const auto& client : m_connectedClients) {
+        if (client.first == game->localSteamID) continue;
+        SnapshotReplicator::ClientView view;
+        if (const InterestManager::Interest* interest = m_interest.find(client.first)) {
+            view.enemies = &interest->enemies;
+            view.centerX = Wire::quantizePosition(interest->center.x, Wire::Codec::PosX::origin());
+            view.centerY = Wire::quantizePosition(interest->center.y, Wire::Codec::PosY::origin());
+        }
+        for (const Wire::ByteWriter& frame : m_snapshots.encodeFor(client.first, view)) {
+            m_unreliableOut.queue(client.first, frame);
+            NetworkStats& stats = usageFor(frame.data()[0]);
+            stats.bytesSent += frame.size();
+            stats.messageCountSent++;
         }
     }
 }
 
-void NetworkManager::BroadcastEnemyDeath(uint64_t enemyId, CSteamID killerID) {
-    if (!game->m_isHost) return;
-    
-    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    
-    char buffer[128];
-    int bytes = snprintf(buffer, sizeof(buffer), "E|DEATH|%llu|%llu|%llu",
-                        enemyId, timestamp, killerID.ConvertToUint64());
-    if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-        broadcastMessage(std::string(buffer));
-        game->entityManager->getEnemies().erase(enemyId);
-        m_lastEnemyUpdateTime[enemyId] = timestamp;
-    }
+void NetworkManager::ResetReplication() {
+    m_snapshots.reset();
+    m_interest.clear();
 }
 
 void NetworkManager::OnLobbyCreated(LobbyCreated_t* pParam) {
@@ -636,7 +824,9 @@ void NetworkManager::OnLobbyCreated(LobbyCreated_t* pParam) {
     CSteamID myID = SteamUser()->GetSteamID();
     std::string hostStr = std::to_string(myID.ConvertToUint64());
     SteamMatchmaking()->SetLobbyData(game->m_currentLobby, "host_steam_id", hostStr.c_str());
+    m_lobbyHost = myID;
     m_connectedClients[myID] = true;
+    game->lobbyMembers.reset(game->m_currentLobby);
 }
 
 void NetworkManager::OnGameLobbyJoinRequested(GameLobbyJoinRequested_t* pParam) {
@@ -664,11 +854,12 @@ void NetworkManager::OnLobbyEnter(LobbyEnter_t* pParam) {
     game->m_currentLobby = CSteamID(pParam->m_ulSteamIDLobby);
     game->inLobby = true;
     game->currentState = GameState::Lobby;
+    game->lobbyMembers.reset(game->m_currentLobby);
+    refreshLobbyHost();
 
     game->entityManager->getPlayers().clear();
     game->playerLoadedStatus.clear();
     m_playerStates.clear();
-    m_lastEnemyUpdateTime.clear();
 
     int memberCount = SteamMatchmaking()->GetNumLobbyMembers(game->m_currentLobby);
     for (int i = 0; i < memberCount; i++) {
@@ -685,9 +876,8 @@ void NetworkManager::OnLobbyEnter(LobbyEnter_t* pParam) {
         setIsConnectedToHost(false);
     } else {
         game->playerLoadedStatus[game->localSteamID] = false;
-        const char* hostStr = SteamMatchmaking()->GetLobbyData(game->m_currentLobby, "host_steam_id");
-        if (hostStr && *hostStr) {
-            CSteamID hostID(std::stoull(hostStr));
+        CSteamID hostID = lobbyHost();
+        if (hostID.IsValid()) {
             if (m_networking->AcceptP2PSessionWithUser(hostID)) {
                 setIsConnectedToHost(true);
             }
@@ -695,11 +885,21 @@ void NetworkManager::OnLobbyEnter(LobbyEnter_t* pParam) {
     }
 }
 
+void NetworkManager::OnLobbyDataUpdate(LobbyDataUpdate_t* pParam) {
+    // Member data updates do not touch the lobby's own keys.
+    if (pParam->m_bSuccess && pParam->m_ulSteamIDLobby == pParam->m_ulSteamIDMember &&
+        CSteamID(pParam->m_ulSteamIDLobby) == game->m_currentLobby)
+        refreshLobbyHost();
+}
+
 void NetworkManager::OnP2PSessionRequest(P2PSessionRequest_t* pParam) {
     if (game->m_isHost) {
         if (AcceptP2PSessionWithUser(pParam->m_steamIDRemote)) {
-            m_connectedClients[pParam->m_steamIDRemote] = true;
-            sendMessage(pParam->m_steamIDRemote, "Welcome to the lobby!");
+            // Non-members may only be probing latency from the lobby browser.
+            if (game->lobbyMembers.contains(pParam->m_steamIDRemote)) {
+                m_connectedClients[pParam->m_steamIDRemote] = true;
+                sendMessage(pParam->m_steamIDRemote, Wire::Welcome());
+            }
         }
     }
 }
@@ -711,16 +911,3 @@ void NetworkManager::OnP2PSessionConnectFail(P2PSessionConnectFail_t* pParam) {
         setIsConnectedToHost(false);
     }
 }
-
-void NetworkManager::OnLobbyMatchList(LobbyMatchList_t* pParam) {
-    game->lobbyList.clear();
-    for (uint32 i = 0; i < pParam->m_nLobbiesMatching; ++i) {
-        CSteamID lobbyID = SteamMatchmaking()->GetLobbyByIndex(i);
-        const char* lobbyName = SteamMatchmaking()->GetLobbyData(lobbyID, "name");
-        if (lobbyName && *lobbyName) {
-            game->lobbyList.emplace_back(lobbyID, std::string(lobbyName));
-        }
-    }
-    game->lobbyListUpdated = true;
-    game->hud.updateText("searchStatus", "Lobby Search");
-}
\ No newline at end of file
@@ -9,6 +9,12 @@
 #include <unordered_map>
 #include <functional>
 #include "../Utils/SteamHelpers.h"
+#include "WireProtocol.h"
+#include "PacketCoalescer.h"
+#include "SnapshotReplicator.h"
+#include "InterestManager.h"
+#include <array>
+#include <unordered_set>
 #include <vector>
 #include <chrono>
 
@@ -21,52 +27,98 @@ public:
     void JoinLobbyFromNetwork(CSteamID lobby);
     bool isInitialized() const;
     bool isLoaded();
-    bool sendMessage(CSteamID target, const std::string &msg);
-    bool broadcastMessage(const std::string &msg);
+    bool sendMessage(CSteamID target, const Wire::ByteWriter &msg);          ///< Queued until flushOutgoing().
+    bool broadcastMessage(const Wire::ByteWriter &msg, CSteamID exclude = CSteamID());
+
+    /// Encodes a Wire message into the shared scratch writer and queues it.
+    template <typename Msg>
+    bool sendMessage(CSteamID target, const Msg& msg) { Wire::encode(m_writer, msg); return sendMessage(target, m_writer); }
+    template <typename Msg>
+    bool broadcastMessage(const Msg& msg, CSteamID exclude = CSteamID()) { Wire::encode(m_writer, msg); return broadcastMessage(m_writer, exclude); }
+
+    /**
+     * @brief Sends everything queued this tick, coalesced into MTU-sized packets per peer.
+     * @return Number of packets sent.
+     */
+    std::size_t flushOutgoing();
+    void discardOutgoing(); ///< Drops queued messages.
+    void leftLobby();       ///< Drops queued messages and the cached lobby host.
+    CSteamID lobbyHost() const { return m_lobbyHost; } ///< Cached host of the current lobby (nil if none).
+
+    /**
+     * @brief Host only: captures a world snapshot when one is due and queues
+     *        each client's delta against its last acknowledged snapshot.
+     *
+     * Called once per fixed simulation tick while playing. Snapshots travel
+     * unreliably; a lost one is simply superseded by the next.
+     */
+    void UpdateSnapshots();
+    void ResetReplication(); ///< Forgets snapshots and baselines, e.g. when a new game starts.
+
     void processCallbacks();
-    void receiveMessages();
-    void setMessageHandler(std::function<void(const std::string&, CSteamID)> handler);
+    std::size_t receiveMessages(); ///< Returns the number of messages handled.
+    void setMessageHandler(std::function<void(const uint8_t*, std::size_t, CSteamID)> handler);
     void acceptSession(CSteamID remoteID);
     const std::unordered_map<CSteamID, bool, CSteamIDHash>& getConnectedClients() const;
     bool AcceptP2PSessionWithUser(CSteamID user);
     void setIsConnectedToHost(bool b);
     
-    // Message handlers
-    void HandlePlayerLoaded(const std::string& msg);
-    void HandlePlayerUpdate(const std::string& msg);
-    void HandleEnemySpawn(const std::string& msg);
-    void HandleEnemyUpdate(const std::string& msg);
-    void HandleEnemyDeath(const std::string& msg);  // Handler for explicit death
-    void HandleEnemySync(const std::string& msg);   // New handler for full enemy sync
-    void HandleBulletFire(const std::string& msg, CSteamID sender);
-    void HandleHit(const std::string& msg, CSteamID sender);
-    void HandleStart(const std::string& msg);
-    void HandleNextLevel(const std::string& msg);
-    void HandleTimer(const std::string& msg);
-    void HandlePlay(const std::string& msg);
-    void HandleGameOver(const std::string& msg);
-    void HandleLobbyReturn(const std::string& msg);
+    /**
+     * @brief Message handlers, one overload per Wire message.
+     *
+     * Called through the dispatch table generated from Wire::Messages after
+     * the payload decoded cleanly; malformed payloads never reach them.
+     */
+    void HandleMessage(const Wire::Welcome& msg, CSteamID sender);
+    void HandleMessage(const Wire::PlayerLoaded& msg, CSteamID sender);
+    void HandleMessage(const Wire::PlayerUpdate& msg, CSteamID sender);
+    void HandleMessage(const Wire::EnemySpawn& msg, CSteamID sender);
+    void HandleMessage(const Wire::EnemyUpdate& msg, CSteamID sender);
+    void HandleMessage(const Wire::EnemyDeath& msg, CSteamID sender);   // Explicit death
+    void HandleMessage(const Wire::EnemyRemove& msg, CSteamID sender);
+    void HandleMessage(const Wire::BulletFire& msg, CSteamID sender);
+    void HandleMessage(const Wire::Hit& msg, CSteamID sender);
+    void HandleMessage(const Wire::Start& msg, CSteamID sender);
+    void HandleMessage(const Wire::NextLevel& msg, CSteamID sender);
+    void HandleMessage(const Wire::Timer& msg, CSteamID sender);
+    void HandleMessage(const Wire::Play& msg, CSteamID sender);
+    void HandleMessage(const Wire::GameOver& msg, CSteamID sender);
+    void HandleMessage(const Wire::LobbyReturn& msg, CSteamID sender);
+    void HandleMessage(const Wire::Ping& msg, CSteamID sender);         ///< Latency probe from the lobby browser.
+    void HandleMessage(const Wire::Pong& msg, CSteamID sender);
+    void HandleMessage(const Wire::SnapshotPart& msg, CSteamID sender);
+    void HandleMessage(const Wire::SnapshotAck& msg, CSteamID sender);
     
     void ReportNetworkUsage() const;
     void ResetNetworkUsage();
     
     // Network/game functions
-    void ProcessNetworkMessages(const std::string& msg, CSteamID sender);
-    void SendGameplayMessage(const std::string& msg);
+    void ProcessNetworkMessages(const uint8_t* data, std::size_t size, CSteamID sender);
+    void SendGameplayMessage(const Wire::ByteWriter& msg);
+    template <typename Msg>
+    void SendGameplayMessage(const Msg& msg) { Wire::encode(m_writer, msg); SendGameplayMessage(m_writer); }
+    /// As above, but the host only sends to clients whose area of interest contains `position`.
+    void SendGameplayMessage(const Wire::ByteWriter& msg, sf::Vector2f position);
+    template <typename Msg>
+    void SendGameplayMessage(const Msg& msg, sf::Vector2f position) { Wire::encode(m_writer, msg); SendGameplayMessage(m_writer, position); }
     void SendPlayerUpdate();
-    void SyncEnemies();
-    void SyncEnemiesFull();                         // New function for full enemy sync
-    void BroadcastEnemySpawns();
-    void SpawnEnemiesAndBroadcast();
+    void SpawnEnemyWave();                          // Host: replicated by the next snapshot
     void ThrottledSendPlayerUpdate();
-    void BroadcastEnemyDeath(uint64_t enemyId, CSteamID killerID);
-    void HandleEnemyRemove(const std::string& msg);
+
+    /**
+     * @brief Tick used to stamp outgoing messages.
+     * @return The host's simulation tick on the host, the newest host tick seen on clients.
+     */
+    Wire::Tick currentTick() const;
 private:
+    struct SnapshotApplier; // Turns snapshot differences into entity updates (clients)
+
     struct NetworkStats {
         size_t bytesSent = 0;
         size_t bytesReceived = 0;
         size_t messageCountSent = 0;
         size_t messageCountReceived = 0;
+        size_t messageCountMalformed = 0;  // Rejected payloads and unknown ids
     };
     
     struct PlayerState {
@@ -84,21 +136,37 @@ private:
     bool debugMode;
     std::unordered_map<CSteamID, bool, CSteamIDHash> m_connectedClients;
     std::unordered_map<CSteamID, PlayerState, CSteamIDHash> m_playerStates;
-    std::unordered_map<uint64_t, uint64_t> m_lastEnemyUpdateTime;  // enemyID -> timestamp
-    uint64_t m_lastEnemySyncTime = 0;                              // New member for last sync timestamp
-    std::function<void(const std::string&, CSteamID)> messageHandler;
+    Wire::Tick m_lastHostTick = 0;                                  // Newest host tick received (clients)
+    CSteamID m_lobbyHost;                                           // Host of the current lobby, from its data (clients and host)
+    std::function<void(const uint8_t*, std::size_t, CSteamID)> messageHandler;
     CubeGame* game;
-    std::map<std::string, NetworkStats> networkUsage;
+    std::array<NetworkStats, static_cast<std::size_t>(Wire::MsgId::Count)> networkUsage; // Indexed by message id
+    Wire::ByteWriter m_writer;                                      // Scratch buffer for outgoing messages
+    PacketCoalescer m_outgoing;                                     // Messages queued until the end of the tick
+    PacketCoalescer m_unreliableOut;                                // Snapshot parts, sent unreliably
+    SnapshotReplicator m_snapshots;                                 // World snapshots and per-client baselines
+    InterestManager m_interest;                                     // Per-client area of interest (host)
+    std::vector<uint8_t> m_recvBuffer = std::vector<uint8_t>(Wire::kMaxPacket); // Never grows
+    std::unordered_set<CSteamID, CSteamIDHash> m_incompatiblePeers; // Peers already reported as another version
+    size_t m_malformedPackets = 0;                                  // Packets with broken framing
+    size_t m_oversizedPackets = 0;                                  // Packets over Wire::kMaxPacket, dropped
+    size_t m_nonMemberFrames = 0;                                   // Non-probe frames from outside the lobby, dropped
     sf::Clock usageClock;
     float usageReportInterval = 10.0f;
     const float INTERPOLATION_TIME = 0.1f;
+
+    NetworkStats& usageFor(uint8_t msgId);
+    void refreshLobbyHost();    ///< Re-reads the host from the lobby data.
+    void observeHostTick(Wire::Tick tick);
+    void CaptureSnapshot(WorldSnapshot& snapshot) const;
+    void broadcastNear(const Wire::ByteWriter& msg, sf::Vector2f position, CSteamID exclude = CSteamID());
     
     STEAM_CALLBACK(NetworkManager, OnLobbyCreated, LobbyCreated_t, m_cbLobbyCreated);
     STEAM_CALLBACK(NetworkManager, OnGameLobbyJoinRequested, GameLobbyJoinRequested_t, m_cbGameLobbyJoinRequested);
     STEAM_CALLBACK(NetworkManager, OnLobbyEnter, LobbyEnter_t, m_cbLobbyEnter);
+    STEAM_CALLBACK(NetworkManager, OnLobbyDataUpdate, LobbyDataUpdate_t, m_cbLobbyDataUpdate);
     STEAM_CALLBACK(NetworkManager, OnP2PSessionRequest, P2PSessionRequest_t, m_cbP2PSessionRequest);
     STEAM_CALLBACK(NetworkManager, OnP2PSessionConnectFail, P2PSessionConnectFail_t, m_cbP2PSessionConnectFail);
-    STEAM_CALLBACK(NetworkManager, OnLobbyMatchList, LobbyMatchList_t, m_cbLobbyMatchList);
 };
 
 #endif // NETWORKMANAGER_H
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "PacketCoalescer.h"
+
+// Schema-derived bound: every frame fits a default packet with a two-byte length prefix.
+static_assert(Wire::kLargestFrame < 0x4000, "frame length prefixes are expected to be at most two bytes");
+static_assert(1 + 2 + Wire::kLargestFrame <= PacketCoalescer::Config{}.mtu, "a message no longer fits one packet");
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+PacketCoalescer::PacketCoalescer()
+    : PacketCoalescer(Config())
+{
+}
+
+PacketCoalescer::PacketCoalescer(const Config& config)
+    : m_config(config)
+{
+}
+
+//-------------------------------------------------------------------------
+// Queueing
+//-------------------------------------------------------------------------
+PacketCoalescer::Span PacketCoalescer::append(const Wire::ByteWriter& frame) {
+    Span span;
+    span.offset = static_cast<uint32_t>(m_arena.size());
+    uint64_t len = frame.size();
+    while (len >= 0x80) {
+        m_arena.push_back(static_cast<uint8_t>(len | 0x80));
+        len >>= 7;
+    }
+    m_arena.push_back(static_cast<uint8_t>(len));
+    span.prefix = static_cast<uint8_t>(m_arena.size() - span.offset);
+    m_arena.insert(m_arena.end(), frame.data(), frame.data() + frame.size());
+    span.size = static_cast<uint32_t>(m_arena.size() - span.offset);
+    return span;
+}
+
+PacketCoalescer::PeerQueue& PacketCoalescer::queueFor(CSteamID peer) {
+    auto it = m_peerIndex.find(peer);
+    if (it != m_peerIndex.end())
+        return m_peers[it->second];
+    m_peerIndex.emplace(peer, m_peers.size());
+    m_peers.push_back({ peer, {} });
+    return m_peers.back();
+}
+
+void PacketCoalescer::queue(CSteamID peer, const Wire::ByteWriter& frame) {
+    if (frame.empty()) return;
+    queueFor(peer).spans.push_back(append(frame));
+    ++m_pendingFrames;
+}
+
+void PacketCoalescer::queueBroadcast(const std::unordered_map<CSteamID, bool, CSteamIDHash>& peers,
+                                     const Wire::ByteWriter& frame, CSteamID exclude) {
+    if (frame.empty() || peers.empty()) return;
+    const Span span = append(frame);
+    for (const auto& peer : peers) {
+        if (peer.first == exclude) continue;
+        queueFor(peer.first).spans.push_back(span);
+        ++m_pendingFrames;
+    }
+}
+
+//-------------------------------------------------------------------------
+// Packing & Sending
+//-------------------------------------------------------------------------
+void PacketCoalescer::pack(const std::vector<Span>& spans) {
+    m_packetCount = 0;
+    std::vector<uint8_t>* packet = nullptr;
+    for (const Span& span : spans) {
+        // Start a new packet when this frame would overflow a non-empty one.
+        if (!packet || (packet->size() > 1 && packet->size() + span.size > m_config.mtu)) {
+            if (m_packetCount == m_packets.size())
+                m_packets.emplace_back();
+            packet = &m_packets[m_packetCount++];
+            packet->clear();
+            packet->push_back(Wire::kVersion);
+        }
+        packet->insert(packet->end(), m_arena.begin() + span.offset, m_arena.begin() + span.offset + span.size);
+    }
+}
+
+std::size_t PacketCoalescer::flush(const PacketSender& send) {
+    std::size_t sent = 0;
+    const std::vector<Span>* packed = nullptr;
+    for (PeerQueue& q : m_peers) {
+        if (q.spans.empty()) continue;
+
+        if (packed && *packed == q.spans)
+            m_stats.sharedPackets += m_packetCount;
+        else
+            pack(q.spans);
+        packed = &q.spans;
+
+        for (std::size_t i = 0; i < m_packetCount; ++i) {
+            const std::vector<uint8_t>& packet = m_packets[i];
+            if (send(q.peer, packet.data(), packet.size())) {
+                ++m_stats.packets;
+                ++sent;
+            } else {
+                ++m_stats.failedPackets;
+            }
+        }
+
+        m_stats.overheadBytes += m_packetCount; // Version byte per packet.
+        for (const Span& span : q.spans) {
+            m_stats.overheadBytes += span.prefix;
+            m_stats.payloadBytes += span.size - span.prefix;
+        }
+        m_stats.frames += q.spans.size();
+        m_stats.uncoalescedPackets += q.spans.size();
+        m_stats.uncoalescedOverhead += q.spans.size();
+    }
+
+    // Empty the span lists but keep the peers (and their capacity) for the next tick.
+    for (PeerQueue& q : m_peers)
+        q.spans.clear();
+    m_arena.clear();
+    m_pendingFrames = 0;
+    return sent;
+}
+
+void PacketCoalescer::clear() {
+    m_peers.clear();
+    m_peerIndex.clear();
+    m_arena.clear();
+    m_pendingFrames = 0;
+}
@@ -0,0 +1,120 @@
+#ifndef PACKETCOALESCER_H
+#define PACKETCOALESCER_H
+
+#include <steam/steam_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "../Utils/SteamHelpers.h"
+#include "WireProtocol.h"
+
+/**
+ * @brief Per-tick outbound queue that packs every message for a peer into
+ *        as few MTU-sized packets as possible.
+ *
+ * Frames are appended once to a shared byte arena; peers only hold spans
+ * into it, so a broadcast is encoded once however many peers receive it.
+ * At flush() each peer's spans are packed in queue order into packets of
+ * the form [kVersion][varint len][frame]..., and peers whose span lists are
+ * identical (the common case: everyone got the same broadcasts) reuse the
+ * packets built for the previous peer.
+ *
+ * Counters also record what the same traffic would have cost with one packet
+ * per message per peer, so reports can show the saving.
+ */
+class PacketCoalescer {
+public:
+    struct Config {
+        std::size_t mtu = 1200;  ///< Target packet size; larger single frames travel alone.
+    };
+
+    /// Sends one finished packet; returns false if the transport rejected it.
+    using PacketSender = std::function<bool(CSteamID peer, const uint8_t* data, std::size_t size)>;
+
+    struct Stats {
+        std::size_t packets = 0;            ///< Packets handed to the transport.
+        std::size_t frames = 0;             ///< Messages delivered (per peer).
+        std::size_t payloadBytes = 0;       ///< Message id + payload bytes (per peer).
+        std::size_t overheadBytes = 0;      ///< Version bytes and length prefixes.
+        std::size_t uncoalescedPackets = 0; ///< One packet per message per peer.
+        std::size_t uncoalescedOverhead = 0;///< Version byte per uncoalesced packet.
+        std::size_t sharedPackets = 0;      ///< Packets reused from the previous peer.
+        std::size_t failedPackets = 0;      ///< Packets the transport rejected.
+    };
+
+    PacketCoalescer();
+    explicit PacketCoalescer(const Config& config);
+
+    /**
+     * @brief Queues one encoded frame (message id + payload) for a peer.
+     */
+    void queue(CSteamID peer, const Wire::ByteWriter& frame);
+
+    /**
+     * @brief Queues one frame for every peer, storing its bytes once.
+     * @param exclude Peer that should not receive it (e.g. the originator of a relay).
+     */
+    void queueBroadcast(const std::unordered_map<CSteamID, bool, CSteamIDHash>& peers,
+                        const Wire::ByteWriter& frame, CSteamID exclude = CSteamID());
+
+    /**
+     * @brief Packs and sends everything queued since the last flush.
+     * @return Number of packets sent.
+     */
+    std::size_t flush(const PacketSender& send);
+
+    /// Drops queued frames and forgets all peers (e.g. when leaving a lobby).
+    void clear();
+
+    bool empty() const { return m_pendingFrames == 0; }
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+    /**
+     * @brief Calls fn(frame, size) for every frame in a received packet.
+     * @return false if the packet is not of this protocol version or its framing is malformed.
+     */
+    template <typename Fn>
+    static bool forEachFrame(const uint8_t* data, std::size_t size, Fn&& fn) {
+        if (size < 1 || data[0] != Wire::kVersion) return false;
+        Wire::ByteReader reader(data + 1, size - 1);
+        while (!reader.atEnd()) {
+            const uint64_t len = reader.varint();
+            if (!reader.ok() || len == 0 || len > reader.remaining()) return false;
+            const uint8_t* frame = reader.cursor();
+            reader.skip(static_cast<std::size_t>(len));
+            fn(frame, static_cast<std::size_t>(len));
+        }
+        return true;
+    }
+
+private:
+    struct Span {
+        uint32_t offset;  ///< Start of the length-prefixed frame in m_arena.
+        uint32_t size;    ///< Length prefix + frame bytes.
+        uint8_t prefix;   ///< Bytes taken by the length prefix.
+        bool operator==(const Span& o) const { return offset == o.offset && size == o.size; }
+    };
+
+    struct PeerQueue {
+        CSteamID peer;
+        std::vector<Span> spans;
+    };
+
+    Span append(const Wire::ByteWriter& frame);
+    PeerQueue& queueFor(CSteamID peer);
+    void pack(const std::vector<Span>& spans);
+
+    Config m_config;
+    std::vector<uint8_t> m_arena;                            ///< Length-prefixed frames queued this tick.
+    std::vector<PeerQueue> m_peers;                          ///< Kept across flushes to reuse capacity.
+    std::unordered_map<CSteamID, std::size_t, CSteamIDHash> m_peerIndex;
+    std::vector<std::vector<uint8_t>> m_packets;             ///< Packets built for the last packed span list.
+    std::size_t m_packetCount = 0;
+    std::size_t m_pendingFrames = 0;
+    Stats m_stats;
+};
+
+#endif // PACKETCOALESCER_H
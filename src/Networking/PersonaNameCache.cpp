@@ -0,0 +1,38 @@
+#include "PersonaNameCache.h"
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+PersonaNameCache::PersonaNameCache()
+    : m_cbPersonaStateChange(this, &PersonaNameCache::OnPersonaStateChange)
+{
+}
+
+//-------------------------------------------------------------------------
+// Lookup
+//-------------------------------------------------------------------------
+const std::string& PersonaNameCache::get(CSteamID id) {
+    auto it = m_names.find(id);
+    if (it != m_names.end())
+        return it->second;
+
+    const char* name = SteamFriends() ? SteamFriends()->GetFriendPersonaName(id) : nullptr;
+    // Steam returns "" or "[unknown]" until the persona is downloaded; the
+    // PersonaStateChange_t that follows replaces the placeholder.
+    return m_names.emplace(id, (name && name[0] != '\0') ? name : "Unknown").first->second;
+}
+
+void PersonaNameCache::clear() {
+    m_names.clear();
+    ++m_version;
+}
+
+//-------------------------------------------------------------------------
+// Steam Callbacks
+//-------------------------------------------------------------------------
+void PersonaNameCache::OnPersonaStateChange(PersonaStateChange_t* pCallback) {
+    if (!(pCallback->m_nChangeFlags & k_EPersonaChangeName))
+        return;
+    if (m_names.erase(CSteamID(pCallback->m_ulSteamID)) > 0)
+        ++m_version;
+}
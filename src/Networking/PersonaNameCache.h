@@ -0,0 +1,43 @@
+#ifndef PERSONANAMECACHE_H
+#define PERSONANAMECACHE_H
+
+#include <steam/steam_api.h>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include "../Utils/SteamHelpers.h"
+
+/**
+ * @brief Caches Steam persona names so UI code never queries Steam per tick.
+ *
+ * A name is fetched from ISteamFriends the first time it is requested and
+ * kept until Steam reports a name change through PersonaStateChange_t. Every
+ * invalidation bumps getVersion(), which views compare against to decide
+ * whether strings containing names need to be rebuilt.
+ */
+class PersonaNameCache {
+public:
+    PersonaNameCache();
+
+    /**
+     * @brief Returns the persona name of a user, or "Unknown" if unavailable.
+     * @param id Steam ID of the user.
+     */
+    const std::string& get(CSteamID id);
+
+    /**
+     * @brief Drops every cached name (e.g. when leaving a lobby).
+     */
+    void clear();
+
+    /// Incremented whenever a cached name is invalidated.
+    uint32_t getVersion() const { return m_version; }
+
+private:
+    STEAM_CALLBACK(PersonaNameCache, OnPersonaStateChange, PersonaStateChange_t, m_cbPersonaStateChange);
+
+    std::unordered_map<CSteamID, std::string, CSteamIDHash> m_names; ///< Resolved names.
+    uint32_t m_version = 0;
+};
+
+#endif // PERSONANAMECACHE_H
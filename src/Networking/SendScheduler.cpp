@@ -0,0 +1,118 @@
+#include "SendScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr std::size_t kSentWindow = 64; // Snapshots tracked for RTT and loss.
+}
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+SendScheduler::SendScheduler()
+    : SendScheduler(Config())
+{
+}
+
+SendScheduler::SendScheduler(const Config& config)
+    : m_config(config), m_rate(config.initialRate), m_sent(kSentWindow)
+{
+}
+
+//-------------------------------------------------------------------------
+// Bandwidth
+//-------------------------------------------------------------------------
+float SendScheduler::seconds(Wire::Tick from, Wire::Tick to) const {
+    return static_cast<uint16_t>(to - from) / m_config.tickRate;
+}
+
+void SendScheduler::onSent(Wire::Tick seq, Wire::Tick now, std::size_t bytes) {
+    Sent& s = m_sent[seq % m_sent.size()];
+    s.seq = seq;
+    s.at = now;
+    s.pending = true;
+    m_stats.bytes += bytes;
+}
+
+void SendScheduler::onAck(Wire::Tick seq, Wire::Tick now) {
+    Sent& acked = m_sent[seq % m_sent.size()];
+    if (!acked.pending || acked.seq != seq) return;
+    acked.pending = false;
+    ++m_stats.acks;
+
+    // Acks arrive in order, so anything older still pending was lost or overtaken.
+    std::size_t lost = 0;
+    for (Sent& s : m_sent) {
+        if (s.pending && Wire::tickBefore(s.seq, seq)) {
+            s.pending = false;
+            ++lost;
+        }
+    }
+    m_stats.lost += lost;
+
+    const float tick = 1.f / m_config.tickRate;
+    const float sample = seconds(acked.at, now);
+    const float sinceLastAck = m_hasAck ? seconds(m_lastAckAt, now) : 0.f;
+    m_srtt = m_hasAck ? m_srtt * 0.875f + sample * 0.125f : sample;
+    m_minRtt = m_hasAck ? std::min(m_minRtt, sample) : sample;
+    m_loss = m_loss * 0.9f + 0.1f * static_cast<float>(lost) / (lost + 1);
+    m_hasAck = true;
+    m_lastAckAt = now;
+
+    // Two ticks of slack: samples are only tick-accurate.
+    const bool congested = lost > 0 || sample > m_minRtt * m_config.rttTolerance + 2.f * tick;
+    if (congested) {
+        if (!m_hasDecreased || seconds(m_lastDecrease, now) >= std::max(m_srtt, tick)) {
+            m_rate = std::max(m_config.minRate, m_rate * m_config.decreaseFactor);
+            m_hasDecreased = true;
+            m_lastDecrease = now;
+            ++m_stats.decreases;
+        }
+    } else {
+        // One increasePerRtt per round trip, spread over the acks within it.
+        const float share = std::min(sinceLastAck / std::max(m_srtt, tick), 1.f);
+        m_rate = std::min(m_config.maxRate, m_rate + m_config.increasePerRtt * share);
+    }
+}
+
+std::size_t SendScheduler::budget(int ticks) const {
+    return static_cast<std::size_t>(m_rate * ticks / m_config.tickRate);
+}
+
+//-------------------------------------------------------------------------
+// Priority
+//-------------------------------------------------------------------------
+float SendScheduler::accumulate(const EnemyNetState& now, const EnemyNetState* sent,
+                                uint16_t centerX, uint16_t centerY, Wire::Tick seq) {
+    const float dx = (static_cast<float>(now.x) - centerX) * NET_POSITION_QUANTUM;
+    const float dy = (static_cast<float>(now.y) - centerY) * NET_POSITION_QUANTUM;
+    const float weight = 1.f / (1.f + std::sqrt(dx * dx + dy * dy) / m_config.distanceFalloff);
+
+    float error = m_config.enterError;
+    if (sent) {
+        const float ex = (static_cast<float>(now.x) - sent->x) * NET_POSITION_QUANTUM;
+        const float ey = (static_cast<float>(now.y) - sent->y) * NET_POSITION_QUANTUM;
+        error = std::sqrt(ex * ex + ey * ey);
+        if (now.health != sent->health) error += m_config.errorScale;
+        if (now.spawnDelay != sent->spawnDelay) error += m_config.errorScale;
+        if (now.type != sent->type) error += m_config.enterError;
+    }
+
+    Accumulator& acc = m_priority[now.id];
+    acc.priority += weight * (1.f + error / m_config.errorScale);
+    acc.seen = seq;
+    return acc.priority;
+}
+
+void SendScheduler::markSent(uint64_t id) {
+    m_priority.erase(id);
+}
+
+void SendScheduler::prune(Wire::Tick seq) {
+    for (auto it = m_priority.begin(); it != m_priority.end();) {
+        if (it->second.seen != seq)
+            it = m_priority.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef SENDSCHEDULER_H
+#define SENDSCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../Utils/Config.h"
+#include "WireProtocol.h"
+#include "WorldSnapshot.h"
+
+/**
+ * @brief Per-client send rate and update priorities for snapshot replication.
+ *
+ * Bandwidth: the rate starts at initialRate and follows AIMD on snapshot
+ * acknowledgements. Each ack without new loss or round-trip inflation adds
+ * increasePerRtt per round trip; a snapshot overtaken by a newer ack counts
+ * as lost, and loss or an RTT above rttTolerance times the minimum cuts the
+ * rate by decreaseFactor (at most once per round trip). Times are host
+ * simulation ticks.
+ *
+ * Priority: every enemy whose state differs from what the client was last
+ * sent accumulates priority each snapshot it is held back, weighted by its
+ * distance to the client's player and by how far its state has drifted, so
+ * near, fast-changing entities go first and distant ones still get through
+ * eventually. Sending an entity resets its accumulator.
+ */
+class SendScheduler {
+public:
+    struct Config {
+        float initialRate = 16384.f;      ///< Bytes per second.
+        float minRate = 4096.f;
+        float maxRate = 131072.f;
+        float increasePerRtt = 2048.f;    ///< Additive increase, bytes per second per round trip.
+        float decreaseFactor = 0.7f;      ///< Multiplicative decrease on congestion.
+        float rttTolerance = 1.5f;        ///< RTT over this multiple of the minimum counts as congestion.
+        float tickRate = 60.f;            ///< Simulation ticks per second.
+
+        float distanceFalloff = 400.f;    ///< Pixels at which an entity's weight halves.
+        float errorScale = 8.f;           ///< Pixels of drift that double the per-snapshot gain.
+        float enterError = 64.f;          ///< Drift credited to an entity the client does not have.
+    };
+
+    struct Stats {
+        std::size_t bytes = 0;            ///< Snapshot bytes sent.
+        std::size_t acks = 0;
+        std::size_t lost = 0;             ///< Snapshots overtaken before being acknowledged.
+        std::size_t decreases = 0;
+        std::size_t deferred = 0;         ///< Entity updates held back by the budget.
+    };
+
+    SendScheduler();
+    explicit SendScheduler(const Config& config);
+
+    //--------------------------------------------------------------------------
+    // Bandwidth
+    //--------------------------------------------------------------------------
+    void onSent(Wire::Tick seq, Wire::Tick now, std::size_t bytes);
+    void onAck(Wire::Tick seq, Wire::Tick now);
+
+    /// Bytes that may be sent over the given number of ticks at the current rate.
+    std::size_t budget(int ticks) const;
+    float rate() const { return m_rate; }           ///< Bytes per second.
+    float rttSeconds() const { return m_srtt; }     ///< Smoothed; 0 before the first ack.
+    float lossRate() const { return m_loss; }       ///< Smoothed fraction of snapshots lost.
+
+    //--------------------------------------------------------------------------
+    // Priority
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Adds this snapshot's priority for an enemy that has something new to send.
+     * @param sent The enemy as last sent to the client, or nullptr if it has none.
+     * @param centerX, centerY The client's player, in quantised wire coordinates.
+     * @return The accumulated priority.
+     */
+    float accumulate(const EnemyNetState& now, const EnemyNetState* sent,
+                     uint16_t centerX, uint16_t centerY, Wire::Tick seq);
+    void markSent(uint64_t id);                      ///< Resets an enemy's accumulator.
+    void markDeferred() { ++m_stats.deferred; }
+    void prune(Wire::Tick seq);                      ///< Forgets enemies not accumulated for `seq`.
+
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    struct Sent {
+        Wire::Tick seq = 0;
+        Wire::Tick at = 0;
+        bool pending = false;   ///< Sent and neither acknowledged nor counted as lost.
+    };
+
+    struct Accumulator {
+        float priority = 0.f;
+        Wire::Tick seen = 0;
+    };
+
+    float seconds(Wire::Tick from, Wire::Tick to) const;
+
+    Config m_config;
+    float m_rate;
+    float m_srtt = 0.f;
+    float m_minRtt = 0.f;
+    float m_loss = 0.f;
+    bool m_hasAck = false;
+    Wire::Tick m_lastAckAt = 0;
+    bool m_hasDecreased = false;
+    Wire::Tick m_lastDecrease = 0;
+    std::vector<Sent> m_sent;                         ///< Ring of recent snapshots, by seq.
+    std::unordered_map<uint64_t, Accumulator> m_priority;
+    Stats m_stats;
+};
+
+#endif // SENDSCHEDULER_H
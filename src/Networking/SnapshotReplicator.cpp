@@ -0,0 +1,342 @@
+#include "SnapshotReplicator.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace {
+    // Marks a deferred enemy the client does not have yet; real ids are never all ones.
+    constexpr uint64_t kDeferredEnemy = ~uint64_t(0);
+}
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+SnapshotReplicator::SnapshotReplicator()
+    : SnapshotReplicator(Config())
+{
+}
+
+SnapshotReplicator::SnapshotReplicator(const Config& config)
+    : m_config(config), m_history(config.history)
+{
+}
+
+//-------------------------------------------------------------------------
+// Host: Capture
+//-------------------------------------------------------------------------
+bool SnapshotReplicator::shouldCapture() {
+    if (--m_ticksUntilCapture > 0) return false;
+    m_ticksUntilCapture = m_config.ticksPerSnapshot;
+    return true;
+}
+
+WorldSnapshot& SnapshotReplicator::beginCapture(Wire::Tick tick) {
+    m_current = m_nextSeq++;
+    m_hasCurrent = false;
+    for (Encoding& e : m_encodings)
+        e.valid = false;
+
+    m_capture = &m_history.store(m_current);
+    m_capture->clear();
+    m_capture->tick = tick;
+    return *m_capture;
+}
+
+void SnapshotReplicator::endCapture() {
+    m_capture->sort();
+    m_hasCurrent = true;
+    ++m_stats.snapshots;
+}
+
+//-------------------------------------------------------------------------
+// Host: Encoding & Acknowledgements
+//-------------------------------------------------------------------------
+void SnapshotReplicator::encode(const WorldSnapshot* base, const WorldSnapshot& to, const WorldSnapshot* world, Encoding& out) {
+    const std::size_t count = writeSnapshotDelta(base, to, m_bodies, world);
+
+    out.valid = true;
+    out.hasBaseline = base != nullptr;
+    out.baseline = base ? base->seq : 0;
+    if (count > std::numeric_limits<uint8_t>::max()) {
+        std::cerr << "[ERROR] Snapshot " << m_current << " needs " << count << " parts; not sent" << std::endl;
+        out.frames.clear();
+        return;
+    }
+
+    out.frames.resize(count);
+    Wire::SnapshotPart part;
+    part.seq = m_current;
+    part.baseline = out.baseline;
+    part.tick = to.tick;
+    part.partCount = static_cast<uint8_t>(count);
+    part.hasBaseline = out.hasBaseline;
+    for (std::size_t i = 0; i < count; ++i) {
+        part.part = static_cast<uint8_t>(i);
+        part.body = { m_bodies[i].data(), m_bodies[i].size() };
+        Wire::encode(out.frames[i], part);
+        m_stats.bodyBytes += m_bodies[i].size();
+    }
+}
+
+SnapshotReplicator::Encoding& SnapshotReplicator::sharedEncodingFor(const WorldSnapshot* base) {
+    Encoding* slot = nullptr;
+    for (Encoding& e : m_encodings) {
+        if (e.valid && e.hasBaseline == (base != nullptr) && (!base || e.baseline == base->seq))
+            return e;
+        if (!e.valid && !slot)
+            slot = &e;
+    }
+    if (!slot) {
+        m_encodings.emplace_back();
+        slot = &m_encodings.back();
+    }
+    encode(base, *m_capture, nullptr, *slot);
+    return *slot;
+}
+
+SnapshotReplicator::PeerState& SnapshotReplicator::peerState(CSteamID peer) {
+    return m_peers.try_emplace(peer, m_config.scheduler).first->second;
+}
+
+const std::vector<Wire::ByteWriter>& SnapshotReplicator::encodeFor(CSteamID peer) {
+    return encodeFor(peer, ClientView());
+}
+
+const std::vector<Wire::ByteWriter>& SnapshotReplicator::encodeFor(CSteamID peer, const ClientView& client) {
+    static const std::vector<Wire::ByteWriter> none;
+    if (!m_hasCurrent) return none;
+
+    // Acks against one history say nothing about the other.
+    PeerState& state = peerState(peer);
+    const bool filtered = client.enemies != nullptr;
+    if (state.filtered != filtered) {
+        state.filtered = filtered;
+        state.hasAck = false;
+        state.hasLastView = false;
+    }
+
+    const Encoding* encoding = nullptr;
+    bool delta = false;
+    if (!filtered) {
+        // Delta against the newest acknowledged snapshot if it is still held.
+        const WorldSnapshot* base = state.hasAck ? m_history.find(state.acked) : nullptr;
+        encoding = &sharedEncodingFor(base);
+        delta = base != nullptr;
+    } else {
+        delta = encodeFiltered(state, client);
+        encoding = &state.encoding;
+    }
+
+    std::size_t bytes = 0;
+    for (const Wire::ByteWriter& frame : encoding->frames)
+        bytes += frame.size();
+    if (!encoding->frames.empty())
+        state.scheduler.onSent(m_current, m_capture->tick, bytes);
+
+    if (delta) ++m_stats.deltaSends;
+    else ++m_stats.fullSends;
+    m_stats.parts += encoding->frames.size();
+    return encoding->frames;
+}
+
+bool SnapshotReplicator::encodeFiltered(PeerState& state, const ClientView& client) {
+    if (!state.history)
+        state.history = std::make_unique<SnapshotHistory>(m_config.history);
+    SnapshotHistory& history = *state.history;
+    SendScheduler& scheduler = state.scheduler;
+
+    // What the client was last sent; the slot may be about to be reused.
+    const WorldSnapshot* sent = state.hasLastView ? history.find(state.lastView) : nullptr;
+    WorldSnapshot& view = history.store(m_current);
+    if (sent == &view) sent = nullptr;
+    const WorldSnapshot* base = state.hasAck ? history.find(state.acked) : nullptr;
+
+    auto findEnemy = [](const WorldSnapshot* snapshot, uint64_t id) -> const EnemyNetState* {
+        if (!snapshot) return nullptr;
+        auto it = std::lower_bound(snapshot->enemies.begin(), snapshot->enemies.end(), id,
+                                   [](const EnemyNetState& e, uint64_t v) { return e.id < v; });
+        return it != snapshot->enemies.end() && it->id == id ? &*it : nullptr;
+    };
+
+    // This client's view: every player, and the enemies in its area. Enemies
+    // that changed since they were last sent become candidates; the rest are
+    // already final.
+    view.clear();
+    view.tick = m_capture->tick;
+    view.players = m_capture->players;
+    m_candidates.clear();
+    std::size_t spent = 0;
+    auto wanted = client.enemies->begin();
+    for (const EnemyNetState& e : m_capture->enemies) {
+        while (wanted != client.enemies->end() && *wanted < e.id) ++wanted;
+        if (wanted == client.enemies->end()) break;
+        if (*wanted != e.id) continue;
+
+        const EnemyNetState* last = findEnemy(sent, e.id);
+        if (last && enemyRecordSize(last, e) == 0) {
+            view.enemies.push_back(e);
+            spent += enemyRecordSize(findEnemy(base, e.id), e); // Sent before but not yet acknowledged.
+            continue;
+        }
+        Candidate c;
+        c.index = view.enemies.size();
+        c.now = &e;
+        c.last = last;
+        c.priority = scheduler.accumulate(e, last, client.centerX, client.centerY, m_current);
+        m_candidates.push_back(c);
+        view.enemies.push_back(e);
+    }
+    scheduler.prune(m_current);
+
+    // Highest priority first until the budget is spent; the first always goes
+    // so the client keeps making progress at the minimum rate.
+    m_order.resize(m_candidates.size());
+    for (std::size_t i = 0; i < m_order.size(); ++i) m_order[i] = i;
+    std::sort(m_order.begin(), m_order.end(), [this](std::size_t a, std::size_t b) {
+        return m_candidates[a].priority > m_candidates[b].priority;
+    });
+
+    const std::size_t budget = scheduler.budget(m_config.ticksPerSnapshot);
+    bool removeDeferred = false;
+    for (std::size_t n = 0; n < m_order.size(); ++n) {
+        Candidate& c = m_candidates[m_order[n]];
+        const EnemyNetState* known = findEnemy(base, c.now->id);
+        const std::size_t fresh = enemyRecordSize(known, *c.now);
+        if (n == 0 || spent + fresh <= budget) {
+            spent += fresh;
+            scheduler.markSent(c.now->id);
+            continue;
+        }
+
+        // Deferred: the client keeps what it was last sent (if anything).
+        scheduler.markDeferred();
+        if (c.last) {
+            view.enemies[c.index] = *c.last;
+            spent += enemyRecordSize(known, *c.last);
+        } else {
+            view.enemies[c.index].id = kDeferredEnemy;
+            removeDeferred = true;
+        }
+    }
+    if (removeDeferred) {
+        view.enemies.erase(std::remove_if(view.enemies.begin(), view.enemies.end(),
+                                          [](const EnemyNetState& e) { return e.id == kDeferredEnemy; }),
+                           view.enemies.end());
+    }
+
+    state.hasLastView = true;
+    state.lastView = m_current;
+    encode(base, view, m_capture, state.encoding);
+    return base != nullptr;
+}
+
+void SnapshotReplicator::onAck(CSteamID peer, const Wire::SnapshotAck& ack, Wire::Tick now) {
+    PeerState& state = peerState(peer);
+    if (ack.resync) {
+        state.hasAck = false;
+        ++m_stats.resyncs;
+        return;
+    }
+    // Ignore acks for snapshots not sent yet (another game, or garbage).
+    if (!Wire::tickBefore(ack.seq, m_nextSeq)) return;
+    state.scheduler.onAck(ack.seq, now);
+    if (!state.hasAck || Wire::tickBefore(state.acked, ack.seq)) {
+        state.hasAck = true;
+        state.acked = ack.seq;
+    }
+}
+
+const SendScheduler* SnapshotReplicator::scheduler(CSteamID peer) const {
+    auto it = m_peers.find(peer);
+    return it == m_peers.end() ? nullptr : &it->second.scheduler;
+}
+
+void SnapshotReplicator::resetStats() {
+    m_stats = Stats();
+    for (auto& peer : m_peers)
+        peer.second.scheduler.resetStats();
+}
+
+//-------------------------------------------------------------------------
+// Client: Assembly & Application
+//-------------------------------------------------------------------------
+SnapshotReplicator::PartResult SnapshotReplicator::onPart(const Wire::SnapshotPart& part, SnapshotVisitor& visitor) {
+    if (m_hasLatest && !Wire::tickBefore(m_latest, part.seq)) return PartResult::Dropped;
+    if (part.partCount == 0 || part.part >= part.partCount) return PartResult::Dropped;
+
+    Assembly& a = m_assembly;
+    if (!a.active || a.seq != part.seq) {
+        // A newer snapshot replaces an incomplete older one; parts of older ones are stale.
+        if (a.active && Wire::tickBefore(part.seq, a.seq)) return PartResult::Dropped;
+        a.active = true;
+        a.seq = part.seq;
+        a.baseline = part.baseline;
+        a.tick = part.tick;
+        a.hasBaseline = part.hasBaseline;
+        a.partCount = part.partCount;
+        a.received = 0;
+        a.bodies.resize(part.partCount);
+        a.have.assign(part.partCount, false);
+    } else if (a.partCount != part.partCount || a.hasBaseline != part.hasBaseline || a.baseline != part.baseline) {
+        return PartResult::Dropped;
+    }
+
+    if (a.have[part.part]) return PartResult::Dropped;
+    a.have[part.part] = true;
+    a.bodies[part.part].assign(part.body.data, part.body.data + part.body.size);
+    if (++a.received < a.partCount) return PartResult::Pending;
+    a.active = false;
+
+    const WorldSnapshot* base = nullptr;
+    if (a.hasBaseline) {
+        base = m_history.find(a.baseline);
+        if (!base) {
+            ++m_stats.resyncs;
+            return PartResult::NeedResync;
+        }
+    }
+
+    // Rebuild the full snapshot from its baseline, then report what changed
+    // since the one applied last.
+    if (base) m_scratch = *base;
+    else m_scratch.clear();
+    m_scratch.departed.clear();
+    m_scratch.seq = a.seq;
+    m_scratch.tick = a.tick;
+    for (const std::vector<uint8_t>& body : a.bodies) {
+        // Records that do not fit the baseline mean host and client disagree on it.
+        if (!readSnapshotDelta({ body.data(), body.size() }, m_scratch)) {
+            ++m_stats.resyncs;
+            return PartResult::NeedResync;
+        }
+    }
+    diffSnapshots(latest(), m_scratch, visitor);
+
+    // Swapping keeps the evicted snapshot's storage as the next scratch.
+    std::swap(m_history.store(a.seq), m_scratch);
+    m_hasLatest = true;
+    m_latest = a.seq;
+    ++m_stats.snapshots;
+    return PartResult::Applied;
+}
+
+const WorldSnapshot* SnapshotReplicator::latest() const {
+    return m_hasLatest ? m_history.find(m_latest) : nullptr;
+}
+
+//-------------------------------------------------------------------------
+// Reset
+//-------------------------------------------------------------------------
+void SnapshotReplicator::reset() {
+    // Sequence numbers keep counting so parts still in flight from the
+    // previous game cannot pass for new ones on the host's side.
+    m_history.clear();
+    m_ticksUntilCapture = 0;
+    m_hasCurrent = false;
+    m_peers.clear();
+    for (Encoding& e : m_encodings)
+        e.valid = false;
+    m_hasLatest = false;
+    m_assembly.active = false;
+}
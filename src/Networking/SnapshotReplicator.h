@@ -0,0 +1,190 @@
+#ifndef SNAPSHOTREPLICATOR_H
+#define SNAPSHOTREPLICATOR_H
+
+#include <steam/steam_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../Utils/SteamHelpers.h"
+#include "SendScheduler.h"
+#include "WireProtocol.h"
+#include "WorldSnapshot.h"
+
+/**
+ * @brief Snapshot replication with per-client delta compression.
+ *
+ * Host: every few ticks the world is captured into a numbered snapshot kept
+ * in a short history. Each client is sent that snapshot as a delta against
+ * the newest snapshot it has acknowledged (or in full if it has none), so
+ * steady-state traffic scales with how much changed rather than with the
+ * size of the world. Clients with the same baseline share one encoding.
+ *
+ * With an area of interest, a client is sent only the enemies inside it: its
+ * filtered snapshots are kept in a history of its own, and enemies dropping
+ * out of the area are sent as having left rather than been destroyed. Such
+ * clients also get a SendScheduler: enemy updates are packed by priority into
+ * a byte budget that follows the client's measured round trip and loss, and
+ * updates that do not fit stay at what the client was last sent.
+ *
+ * Client: parts are collected per sequence number; once complete they are
+ * applied to the referenced baseline, the result is stored as a possible
+ * future baseline and reported to a SnapshotVisitor as adds, changes and
+ * removals relative to the previously applied snapshot.
+ *
+ * Snapshots may be lost or reordered; only acknowledged ones become baselines
+ * and anything older than the newest applied snapshot is ignored.
+ */
+class SnapshotReplicator {
+public:
+    struct Config {
+        int ticksPerSnapshot = 3;        ///< 20 snapshots/s at the 60 Hz simulation.
+        std::size_t history = 32;        ///< Snapshots kept as baselines (~1.6 s).
+        SendScheduler::Config scheduler; ///< Per-client budget and priorities (area of interest only).
+    };
+
+    /// What the host knows about one client when encoding for it.
+    struct ClientView {
+        const std::vector<uint64_t>* enemies = nullptr; ///< Sorted ids in its area of interest, or nullptr for all.
+        uint16_t centerX = 0;                           ///< Its player, in quantised wire coordinates.
+        uint16_t centerY = 0;
+    };
+
+    /// Result of SnapshotReplicator::onPart().
+    enum class PartResult {
+        Pending,     ///< More parts of this snapshot are outstanding.
+        Applied,     ///< Snapshot complete and applied; acknowledge it.
+        Dropped,     ///< Stale, duplicate or inconsistent parts; nothing to do.
+        NeedResync   ///< The baseline is no longer held or does not match the delta.
+    };
+
+    struct Stats {
+        std::size_t snapshots = 0;    ///< Snapshots captured (host) or applied (client).
+        std::size_t fullSends = 0;    ///< Snapshots sent without a baseline.
+        std::size_t deltaSends = 0;   ///< Snapshots sent as a delta.
+        std::size_t parts = 0;        ///< SnapshotPart messages produced.
+        std::size_t bodyBytes = 0;    ///< Delta record bytes produced (per client).
+        std::size_t resyncs = 0;      ///< Resync requests sent or honoured.
+    };
+
+    SnapshotReplicator();
+    explicit SnapshotReplicator(const Config& config);
+
+    //--------------------------------------------------------------------------
+    // Host
+    //--------------------------------------------------------------------------
+    /// Advances the tick counter; true when a snapshot is due this tick.
+    bool shouldCapture();
+
+    /// Starts a new snapshot; fill it, then call endCapture().
+    WorldSnapshot& beginCapture(Wire::Tick tick);
+    void endCapture();
+
+    /**
+     * @brief Encodes the current snapshot for one client.
+     *
+     * Without an area of interest every enemy is sent. With one, only the
+     * enemies inside it are, and only as many of their updates as fit the
+     * client's budget.
+     * @return Encoded SnapshotPart frames, valid until the next call.
+     */
+    const std::vector<Wire::ByteWriter>& encodeFor(CSteamID peer);
+    const std::vector<Wire::ByteWriter>& encodeFor(CSteamID peer, const ClientView& client);
+
+    /// Records a client acknowledgement; a resync request drops its baseline.
+    void onAck(CSteamID peer, const Wire::SnapshotAck& ack, Wire::Tick now);
+
+    /// A client's scheduler, or nullptr if nothing was sent to it yet.
+    const SendScheduler* scheduler(CSteamID peer) const;
+
+    //--------------------------------------------------------------------------
+    // Client
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Collects one received part and applies the snapshot once complete.
+     *
+     * `part.body` is copied, so the receive buffer may be reused afterwards.
+     */
+    PartResult onPart(const Wire::SnapshotPart& part, SnapshotVisitor& visitor);
+
+    /// Newest snapshot applied on this client (nullptr before the first).
+    const WorldSnapshot* latest() const;
+
+    /// Forgets every snapshot, baseline and partial assembly (new game or lobby).
+    void reset();
+
+    const Stats& getStats() const { return m_stats; }
+    void resetStats(); ///< Also resets every client's scheduler statistics.
+
+private:
+    struct Encoding {
+        bool valid = false;
+        bool hasBaseline = false;
+        Wire::Tick baseline = 0;
+        std::vector<Wire::ByteWriter> frames;
+    };
+
+    struct PeerState {
+        explicit PeerState(const SendScheduler::Config& config) : scheduler(config) {}
+
+        bool hasAck = false;
+        Wire::Tick acked = 0;    ///< Newest acknowledged snapshot.
+        bool filtered = false;   ///< Acks refer to this client's filtered history.
+        bool hasLastView = false;
+        Wire::Tick lastView = 0; ///< Newest filtered snapshot sent.
+        std::unique_ptr<SnapshotHistory> history; ///< Filtered snapshots (area of interest).
+        Encoding encoding;       ///< Filtered encoding of the current snapshot.
+        SendScheduler scheduler;
+    };
+
+    /// An enemy update competing for a client's budget.
+    struct Candidate {
+        std::size_t index = 0;                 ///< Position in the client's view.
+        const EnemyNetState* now = nullptr;    ///< Captured state.
+        const EnemyNetState* last = nullptr;   ///< As last sent, or nullptr.
+        float priority = 0.f;
+    };
+
+    struct Assembly {
+        bool active = false;
+        Wire::Tick seq = 0;
+        Wire::Tick baseline = 0;
+        Wire::Tick tick = 0;
+        bool hasBaseline = false;
+        uint8_t partCount = 0;
+        uint8_t received = 0;
+        std::vector<std::vector<uint8_t>> bodies;
+        std::vector<bool> have;
+    };
+
+    PeerState& peerState(CSteamID peer);
+    Encoding& sharedEncodingFor(const WorldSnapshot* base);
+    bool encodeFiltered(PeerState& state, const ClientView& client); ///< True if encoded as a delta.
+    void encode(const WorldSnapshot* base, const WorldSnapshot& to, const WorldSnapshot* world, Encoding& out);
+
+    Config m_config;
+    SnapshotHistory m_history;
+    int m_ticksUntilCapture = 0;
+
+    // Host
+    Wire::Tick m_nextSeq = 0;
+    bool m_hasCurrent = false;
+    Wire::Tick m_current = 0;
+    WorldSnapshot* m_capture = nullptr;              ///< History slot of the current snapshot.
+    std::unordered_map<CSteamID, PeerState, CSteamIDHash> m_peers;
+    std::vector<Encoding> m_encodings;               ///< Per-baseline encodings of the current snapshot.
+    std::vector<Wire::ByteWriter> m_bodies;          ///< Scratch delta bodies.
+    std::vector<Candidate> m_candidates;             ///< Scratch: enemy updates for one client.
+    std::vector<std::size_t> m_order;                ///< Scratch: candidates by priority.
+
+    // Client
+    bool m_hasLatest = false;
+    Wire::Tick m_latest = 0;
+    Assembly m_assembly;
+    WorldSnapshot m_scratch;
+
+    Stats m_stats;
+};
+
+#endif // SNAPSHOTREPLICATOR_H
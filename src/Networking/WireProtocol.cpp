@@ -0,0 +1,135 @@
+#include "WireProtocol.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Wire {
+
+//-------------------------------------------------------------------------
+// Names & Quantisation
+//-------------------------------------------------------------------------
+const char* name(MsgId id) {
+    switch (id) {
+        case MsgId::Welcome:      return "Welcome";
+        case MsgId::PlayerLoaded: return "PlayerLoaded";
+        case MsgId::PlayerUpdate: return "PlayerUpdate";
+        case MsgId::EnemySpawn:   return "EnemySpawn";
+        case MsgId::EnemyUpdate:  return "EnemyUpdate";
+        case MsgId::EnemyDeath:   return "EnemyDeath";
+        case MsgId::EnemyRemove:  return "EnemyRemove";
+        case MsgId::BulletFire:   return "BulletFire";
+        case MsgId::Hit:          return "Hit";
+        case MsgId::Start:        return "Start";
+        case MsgId::NextLevel:    return "NextLevel";
+        case MsgId::Timer:        return "Timer";
+        case MsgId::Play:         return "Play";
+        case MsgId::GameOver:     return "GameOver";
+        case MsgId::LobbyReturn:  return "LobbyReturn";
+        case MsgId::Ping:         return "Ping";
+        case MsgId::Pong:         return "Pong";
+        case MsgId::SnapshotPart: return "SnapshotPart";
+        case MsgId::SnapshotAck:  return "SnapshotAck";
+        default:                  return "Unknown";
+    }
+}
+
+static_assert(ARENA_HALF_EXTENT <= 32767.f * NET_POSITION_QUANTUM,
+              "the arena must fit the 16-bit position encoding");
+
+uint16_t quantizePosition(float v, float origin) {
+    // Offset by 32768 so the origin sits in the middle of the 16-bit range.
+    float q = std::round((v - origin) / NET_POSITION_QUANTUM) + 32768.f;
+    if (!(q >= 0.f)) q = 0.f; // Also catches NaN.
+    return static_cast<uint16_t>(std::min(q, 65535.f));
+}
+
+float dequantizePosition(uint16_t q, float origin) {
+    return origin + (static_cast<float>(q) - 32768.f) * NET_POSITION_QUANTUM;
+}
+
+uint8_t quantizeTimer(float seconds) {
+    float q = std::round(seconds / kTimerQuantum);
+    if (!(q >= 0.f)) q = 0.f;
+    return static_cast<uint8_t>(std::min(q, 255.f));
+}
+
+float dequantizeTimer(uint8_t q) {
+    return q * kTimerQuantum;
+}
+
+uint16_t quantizeSpeed(float v) {
+    float q = std::round(v / kSpeedQuantum);
+    if (!(q >= 0.f)) q = 0.f;
+    return static_cast<uint16_t>(std::min(q, 65535.f));
+}
+
+float dequantizeSpeed(uint16_t q) {
+    return q * kSpeedQuantum;
+}
+
+//-------------------------------------------------------------------------
+// ByteWriter
+//-------------------------------------------------------------------------
+void ByteWriter::u16(uint16_t v) {
+    m_bytes.push_back(static_cast<uint8_t>(v));
+    m_bytes.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void ByteWriter::u32(uint32_t v) {
+    for (int i = 0; i < 4; ++i)
+        m_bytes.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void ByteWriter::varint(uint64_t v) {
+    while (v >= 0x80) {
+        m_bytes.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    m_bytes.push_back(static_cast<uint8_t>(v));
+}
+
+void ByteWriter::svarint(int64_t v) {
+    varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+//-------------------------------------------------------------------------
+// ByteReader
+//-------------------------------------------------------------------------
+uint8_t ByteReader::u8() {
+    if (m_pos >= m_size) {
+        m_ok = false;
+        return 0;
+    }
+    return m_data[m_pos++];
+}
+
+uint16_t ByteReader::u16() {
+    uint16_t lo = u8();
+    uint16_t hi = u8();
+    return static_cast<uint16_t>(lo | (hi << 8));
+}
+
+uint32_t ByteReader::u32() {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i)
+        v |= static_cast<uint32_t>(u8()) << (8 * i);
+    return v;
+}
+
+uint64_t ByteReader::varint() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = u8();
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return v;
+    }
+    m_ok = false; // More than 10 bytes.
+    return 0;
+}
+
+int64_t ByteReader::svarint() {
+    uint64_t v = varint();
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+} // namespace Wire
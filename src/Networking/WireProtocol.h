@@ -0,0 +1,684 @@
+#ifndef WIREPROTOCOL_H
+#define WIREPROTOCOL_H
+
+#include <steam/steam_api.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "../Utils/Config.h"
+
+/**
+ * @brief Binary P2P message format.
+ *
+ * Every packet starts with the protocol version (kVersion) followed by one or
+ * more frames, each a varint length and then a one-byte MsgId and its payload
+ * (see PacketCoalescer). Payload fields use compact encodings:
+ * - entity ids and counters are LEB128 varints (signed values zigzag-encoded),
+ * - Steam IDs are sent as their 32-bit account id (individual, public universe),
+ * - positions are 16-bit, quantised to NET_POSITION_QUANTUM around the arena origin,
+ * - enemy health and timers are 8-bit,
+ * - timestamps are 16-bit host simulation ticks compared with wrap-around.
+ *
+ * Each message layout is declared once, as a Schema specialisation listing
+ * (member, codec) pairs. Encoders, decoders, maximum frame sizes and the
+ * receive dispatch table are all generated from those schemas, so a field
+ * whose type does not match its codec, a message without a schema or a
+ * message nobody handles fails to compile.
+ *
+ * Peers running a different protocol version (including the old text format,
+ * whose first byte is a letter) are rejected on the first byte.
+ */
+namespace Wire {
+
+constexpr uint8_t kVersion = 0xC3;  ///< Bump whenever any message layout changes.
+constexpr std::size_t kMaxPacket = 16 * 1024; ///< Larger received packets are dropped unparsed; we never send one.
+
+/**
+ * @brief One-byte message identifiers.
+ */
+enum class MsgId : uint8_t {
+    Welcome = 1,   ///< Host greeting after accepting a P2P session.
+    PlayerLoaded,
+    PlayerUpdate,
+    EnemySpawn,
+    EnemyUpdate,
+    EnemyDeath,
+    EnemyRemove,
+    BulletFire,
+    Hit,
+    Start,
+    NextLevel,
+    Timer,
+    Play,
+    GameOver,
+    LobbyReturn,
+    Ping,          ///< Lobby browser latency probe.
+    Pong,
+    SnapshotPart,  ///< Host world state, delta-encoded against the client's acknowledged snapshot.
+    SnapshotAck,
+    Count
+};
+
+/// Short name of a message id for logs and usage reports.
+const char* name(MsgId id);
+
+/// Host simulation tick, truncated to 16 bits.
+using Tick = uint16_t;
+
+/// True if tick a is older than tick b (serial-number arithmetic, valid within 32767 ticks).
+inline bool tickBefore(Tick a, Tick b) { return static_cast<int16_t>(static_cast<uint16_t>(a - b)) < 0; }
+
+constexpr float kTimerQuantum = 0.05f;  ///< 8-bit timers cover 0 - 12.75 s.
+constexpr std::size_t kMaxSnapshotBody = 1100; ///< Keeps a snapshot part inside one unreliable packet.
+constexpr float kSpeedQuantum = 0.1f;   ///< 16-bit speeds cover 0 - 6553.5 px/s.
+
+/// Clamps beyond +-16384 px; clampToArena() keeps simulated entities inside that range.
+uint16_t quantizePosition(float v, float origin);
+float dequantizePosition(uint16_t q, float origin);
+uint8_t quantizeTimer(float seconds);
+float dequantizeTimer(uint8_t q);
+uint16_t quantizeSpeed(float v);
+float dequantizeSpeed(uint16_t q);
+
+//------------------------------------------------------------------------------
+// Byte streams
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Appends little-endian fields to a reusable byte buffer.
+ */
+class ByteWriter {
+public:
+    void clear() { m_bytes.clear(); }
+    void header(MsgId id) { u8(static_cast<uint8_t>(id)); }
+
+    void u8(uint8_t v) { m_bytes.push_back(v); }
+    void u16(uint16_t v);
+    void u32(uint32_t v);
+    void varint(uint64_t v);
+    void svarint(int64_t v);                 ///< Zigzag-encoded signed varint.
+    void bytes(const uint8_t* data, std::size_t size) { m_bytes.insert(m_bytes.end(), data, data + size); }
+
+    const uint8_t* data() const { return m_bytes.data(); }
+    std::size_t size() const { return m_bytes.size(); }
+    bool empty() const { return m_bytes.empty(); }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+/**
+ * @brief Reads fields written by ByteWriter.
+ *
+ * Reading past the end or an over-long varint clears ok() and returns zeros;
+ * callers check ok() once after reading a whole message.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    uint8_t u8();
+    uint16_t u16();
+    uint32_t u32();
+    uint64_t varint();
+    int64_t svarint();
+
+    bool ok() const { return m_ok; }
+    void fail() { m_ok = false; }            ///< Marks a value as out of range for its field.
+    bool atEnd() const { return m_pos == m_size; }
+    std::size_t remaining() const { return m_size - m_pos; }
+    const uint8_t* cursor() const { return m_data + m_pos; }
+    void skip(std::size_t n) { if (n > remaining()) { m_ok = false; n = remaining(); } m_pos += n; }
+
+private:
+    const uint8_t* m_data;
+    std::size_t m_size;
+    std::size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+//------------------------------------------------------------------------------
+// Field codecs
+//------------------------------------------------------------------------------
+
+/// Raw bytes that stay in the receive buffer.
+struct ByteSpan {
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief Wire encodings for a single field.
+ *
+ * Each codec names the C++ type it accepts (value_type), the most bytes it
+ * can write (kMaxSize), and write/read functions.
+ */
+namespace Codec {
+
+struct U8 {
+    using value_type = uint8_t;
+    static constexpr std::size_t kMaxSize = 1;
+    static void write(ByteWriter& w, uint8_t v) { w.u8(v); }
+    static void read(ByteReader& r, uint8_t& v) { v = r.u8(); }
+};
+
+/// 16-bit host simulation tick.
+struct Tick16 {
+    using value_type = Tick;
+    static constexpr std::size_t kMaxSize = 2;
+    static void write(ByteWriter& w, Tick v) { w.u16(v); }
+    static void read(ByteReader& r, Tick& v) { v = r.u16(); }
+};
+
+struct VarU32 {
+    using value_type = uint32_t;
+    static constexpr std::size_t kMaxSize = 5;
+    static void write(ByteWriter& w, uint32_t v) { w.varint(v); }
+    static void read(ByteReader& r, uint32_t& v) {
+        uint64_t raw = r.varint();
+        if (raw > std::numeric_limits<uint32_t>::max()) r.fail();
+        v = static_cast<uint32_t>(raw);
+    }
+};
+
+struct VarU64 {
+    using value_type = uint64_t;
+    static constexpr std::size_t kMaxSize = 10;
+    static void write(ByteWriter& w, uint64_t v) { w.varint(v); }
+    static void read(ByteReader& r, uint64_t& v) { v = r.varint(); }
+};
+
+/// Non-negative int as a varint; negative values are sent as 0.
+struct VarCount {
+    using value_type = int;
+    static constexpr std::size_t kMaxSize = 5;
+    static void write(ByteWriter& w, int v) { w.varint(static_cast<uint32_t>(v < 0 ? 0 : v)); }
+    static void read(ByteReader& r, int& v) {
+        uint64_t raw = r.varint();
+        if (raw > static_cast<uint64_t>(std::numeric_limits<int>::max())) r.fail();
+        v = static_cast<int>(raw);
+    }
+};
+
+/// Signed int as a zigzag varint.
+struct SVarInt {
+    using value_type = int;
+    static constexpr std::size_t kMaxSize = 5;
+    static void write(ByteWriter& w, int v) { w.svarint(v); }
+    static void read(ByteReader& r, int& v) {
+        int64_t raw = r.svarint();
+        if (raw < std::numeric_limits<int>::min() || raw > std::numeric_limits<int>::max()) r.fail();
+        v = static_cast<int>(raw);
+    }
+};
+
+/// Enum value sent as one byte; values of Count or more fail the read.
+template <uint8_t Count>
+struct Enum8 {
+    using value_type = uint8_t;
+    static constexpr std::size_t kMaxSize = 1;
+    static void write(ByteWriter& w, uint8_t v) { w.u8(v); }
+    static void read(ByteReader& r, uint8_t& v) {
+        v = r.u8();
+        if (v >= Count) {
+            r.fail();
+            v = 0;
+        }
+    }
+};
+using EnemyType = Enum8<ENEMY_TYPE_COUNT>; ///< Enemy::Type.
+
+/// Int clamped to 0 - 255 (enemy health).
+struct ClampedU8 {
+    using value_type = int;
+    static constexpr std::size_t kMaxSize = 1;
+    static void write(ByteWriter& w, int v) { w.u8(static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v))); }
+    static void read(ByteReader& r, int& v) { v = r.u8(); }
+};
+
+/// Account id of an individual, public-universe Steam ID.
+struct SteamId {
+    using value_type = CSteamID;
+    static constexpr std::size_t kMaxSize = 4;
+    static void write(ByteWriter& w, CSteamID v) { w.u32(v.GetAccountID()); }
+    static void read(ByteReader& r, CSteamID& v) { v = CSteamID(r.u32(), k_EUniversePublic, k_EAccountTypeIndividual); }
+};
+
+/// Coordinate quantised to NET_POSITION_QUANTUM around one axis of the arena origin.
+template <int Axis>
+struct Coord {
+    using value_type = float;
+    static constexpr std::size_t kMaxSize = 2;
+    static float origin() { return Axis == 0 ? ARENA_ORIGIN_X : ARENA_ORIGIN_Y; }
+    static void write(ByteWriter& w, float v) { w.u16(quantizePosition(v, origin())); }
+    static void read(ByteReader& r, float& v) { v = dequantizePosition(r.u16(), origin()); }
+};
+using PosX = Coord<0>;
+using PosY = Coord<1>;
+
+/// Seconds in kTimerQuantum steps (0 - 12.75 s).
+struct Timer8 {
+    using value_type = float;
+    static constexpr std::size_t kMaxSize = 1;
+    static void write(ByteWriter& w, float v) { w.u8(quantizeTimer(v)); }
+    static void read(ByteReader& r, float& v) { v = dequantizeTimer(r.u8()); }
+};
+
+/// Length-prefixed byte string of at most MaxSize bytes; reads do not copy.
+template <std::size_t MaxSize>
+struct Bytes {
+    using value_type = ByteSpan;
+    static constexpr std::size_t kMaxSize = (MaxSize < 0x80 ? 1 : MaxSize < 0x4000 ? 2 : 3) + MaxSize;
+    static void write(ByteWriter& w, const ByteSpan& v) { w.varint(v.size); w.bytes(v.data, v.size); }
+    static void read(ByteReader& r, ByteSpan& v) {
+        const uint64_t size = r.varint();
+        if (size > MaxSize || size > r.remaining()) {
+            r.fail();
+            return;
+        }
+        v.data = r.cursor();
+        v.size = static_cast<std::size_t>(size);
+        r.skip(v.size);
+    }
+};
+
+/// Speed in kSpeedQuantum steps.
+struct Speed16 {
+    using value_type = float;
+    static constexpr std::size_t kMaxSize = 2;
+    static void write(ByteWriter& w, float v) { w.u16(quantizeSpeed(v)); }
+    static void read(ByteReader& r, float& v) { v = dequantizeSpeed(r.u16()); }
+};
+
+} // namespace Codec
+
+//------------------------------------------------------------------------------
+// Schemas
+//------------------------------------------------------------------------------
+
+namespace detail {
+    template <typename M> struct MemberOf;
+    template <typename C, typename T> struct MemberOf<T C::*> { using type = T; };
+}
+
+/**
+ * @brief One message field: a data member and the codec that carries it.
+ */
+template <auto Member, typename C>
+struct Field {
+    using value_type = typename detail::MemberOf<decltype(Member)>::type;
+    static_assert(std::is_same_v<value_type, typename C::value_type>,
+                  "field type does not match its codec");
+    static constexpr std::size_t kMaxSize = C::kMaxSize;
+
+    template <typename Msg>
+    static void write(ByteWriter& w, const Msg& m) { C::write(w, m.*Member); }
+    template <typename Msg>
+    static void read(ByteReader& r, Msg& m) { C::read(r, m.*Member); }
+};
+
+/**
+ * @brief Up to eight bool members packed into one byte, first member in bit 0.
+ */
+template <auto... Members>
+struct Bits {
+    static_assert(sizeof...(Members) >= 1 && sizeof...(Members) <= 8, "Bits packs 1 - 8 flags");
+    static_assert((std::is_same_v<typename detail::MemberOf<decltype(Members)>::type, bool> && ...),
+                  "Bits members must be bool");
+    static constexpr std::size_t kMaxSize = 1;
+
+    template <typename Msg>
+    static void write(ByteWriter& w, const Msg& m) {
+        uint8_t bits = 0, bit = 0;
+        ((bits |= static_cast<uint8_t>((m.*Members ? 1u : 0u) << bit++)), ...);
+        w.u8(bits);
+    }
+    template <typename Msg>
+    static void read(ByteReader& r, Msg& m) {
+        const uint8_t bits = r.u8();
+        uint8_t bit = 0;
+        ((m.*Members = ((bits >> bit++) & 1u) != 0), ...);
+        if (bits >> sizeof...(Members)) r.fail(); // Unknown flags.
+    }
+};
+
+/**
+ * @brief Ordered field list; fields are written and read front to back.
+ */
+template <typename... Fs>
+struct Fields {
+    static constexpr std::size_t kMaxSize = (std::size_t{0} + ... + Fs::kMaxSize);
+
+    template <typename Msg>
+    static void write(ByteWriter& w, const Msg& m) { (Fs::write(w, m), ...); }
+    template <typename Msg>
+    static void read(ByteReader& r, Msg& m) { (Fs::read(r, m), ...); }
+};
+
+/// Layout of a message; every message type specialises this exactly once.
+template <typename Msg>
+struct Schema;
+
+//------------------------------------------------------------------------------
+// Messages
+//------------------------------------------------------------------------------
+
+/// Messages that carry only their id.
+template <MsgId Id>
+struct Signal {
+    static constexpr MsgId kId = Id;
+};
+template <MsgId Id>
+struct Schema<Signal<Id>> : Fields<> {};
+
+using Welcome = Signal<MsgId::Welcome>;
+using Start = Signal<MsgId::Start>;
+using Play = Signal<MsgId::Play>;
+using GameOver = Signal<MsgId::GameOver>;
+using LobbyReturn = Signal<MsgId::LobbyReturn>;
+
+struct PlayerLoaded {
+    static constexpr MsgId kId = MsgId::PlayerLoaded;
+    CSteamID player;
+};
+template <>
+struct Schema<PlayerLoaded> : Fields<
+    Field<&PlayerLoaded::player, Codec::SteamId>> {};
+
+/**
+ * @brief Full replicated player state.
+ */
+struct PlayerUpdate {
+    static constexpr MsgId kId = MsgId::PlayerUpdate;
+    CSteamID player;
+    float x = 0.f, y = 0.f;
+    float renderedX = 0.f, renderedY = 0.f;
+    int health = 0;
+    int kills = 0;
+    int money = 0;
+    float speed = 0.f;
+    bool ready = false;
+    bool alive = true;
+};
+template <>
+struct Schema<PlayerUpdate> : Fields<
+    Field<&PlayerUpdate::player, Codec::SteamId>,
+    Field<&PlayerUpdate::x, Codec::PosX>,
+    Field<&PlayerUpdate::y, Codec::PosY>,
+    Field<&PlayerUpdate::renderedX, Codec::PosX>,
+    Field<&PlayerUpdate::renderedY, Codec::PosY>,
+    Field<&PlayerUpdate::health, Codec::SVarInt>,
+    Field<&PlayerUpdate::kills, Codec::VarCount>,
+    Field<&PlayerUpdate::money, Codec::SVarInt>,
+    Field<&PlayerUpdate::speed, Codec::Speed16>,
+    Bits<&PlayerUpdate::ready, &PlayerUpdate::alive>> {};
+
+struct EnemySpawn {
+    static constexpr MsgId kId = MsgId::EnemySpawn;
+    uint64_t id = 0;
+    float x = 0.f, y = 0.f;
+    int health = 0;          ///< Sent as 8 bits (clamped to 0 - 255).
+    float spawnDelay = 0.f;
+    uint8_t type = 0;
+    Tick tick = 0;
+};
+template <>
+struct Schema<EnemySpawn> : Fields<
+    Field<&EnemySpawn::id, Codec::VarU64>,
+    Field<&EnemySpawn::x, Codec::PosX>,
+    Field<&EnemySpawn::y, Codec::PosY>,
+    Field<&EnemySpawn::health, Codec::ClampedU8>,
+    Field<&EnemySpawn::spawnDelay, Codec::Timer8>,
+    Field<&EnemySpawn::type, Codec::EnemyType>,
+    Field<&EnemySpawn::tick, Codec::Tick16>> {};
+
+struct EnemyUpdate {
+    static constexpr MsgId kId = MsgId::EnemyUpdate;
+    uint64_t id = 0;
+    float x = 0.f, y = 0.f;
+    int health = 0;          ///< Sent as 8 bits (clamped to 0 - 255).
+    float spawnDelay = 0.f;
+    Tick tick = 0;
+};
+template <>
+struct Schema<EnemyUpdate> : Fields<
+    Field<&EnemyUpdate::id, Codec::VarU64>,
+    Field<&EnemyUpdate::x, Codec::PosX>,
+    Field<&EnemyUpdate::y, Codec::PosY>,
+    Field<&EnemyUpdate::health, Codec::ClampedU8>,
+    Field<&EnemyUpdate::spawnDelay, Codec::Timer8>,
+    Field<&EnemyUpdate::tick, Codec::Tick16>> {};
+
+struct EnemyDeath {
+    static constexpr MsgId kId = MsgId::EnemyDeath;
+    uint64_t id = 0;
+    Tick tick = 0;
+    CSteamID killer;
+};
+template <>
+struct Schema<EnemyDeath> : Fields<
+    Field<&EnemyDeath::id, Codec::VarU64>,
+    Field<&EnemyDeath::tick, Codec::Tick16>,
+    Field<&EnemyDeath::killer, Codec::SteamId>> {};
+
+struct EnemyRemove {
+    static constexpr MsgId kId = MsgId::EnemyRemove;
+    uint64_t id = 0;
+};
+template <>
+struct Schema<EnemyRemove> : Fields<
+    Field<&EnemyRemove::id, Codec::VarU64>> {};
+
+/**
+ * @brief A fired bullet. The bullet id is (shooter << 32) | bulletIndex.
+ */
+struct BulletFire {
+    static constexpr MsgId kId = MsgId::BulletFire;
+    uint32_t messageId = 0;
+    CSteamID shooter;
+    uint32_t bulletIndex = 0;
+    float startX = 0.f, startY = 0.f;
+    float targetX = 0.f, targetY = 0.f;
+    float lifetime = 0.f;
+};
+template <>
+struct Schema<BulletFire> : Fields<
+    Field<&BulletFire::messageId, Codec::VarU32>,
+    Field<&BulletFire::shooter, Codec::SteamId>,
+    Field<&BulletFire::bulletIndex, Codec::VarU32>,
+    Field<&BulletFire::startX, Codec::PosX>,
+    Field<&BulletFire::startY, Codec::PosY>,
+    Field<&BulletFire::targetX, Codec::PosX>,
+    Field<&BulletFire::targetY, Codec::PosY>,
+    Field<&BulletFire::lifetime, Codec::Timer8>> {};
+
+/**
+ * @brief A bullet hitting an enemy. The bullet id is rebuilt from shooter and index.
+ */
+struct Hit {
+    static constexpr MsgId kId = MsgId::Hit;
+    CSteamID shooter;
+    uint32_t bulletIndex = 0;
+    uint64_t enemyId = 0;
+    int damage = 0;
+    Tick tick = 0;           ///< Latest host tick known to the sender.
+    uint64_t bulletId() const { return (shooter.ConvertToUint64() << 32) | bulletIndex; }
+};
+template <>
+struct Schema<Hit> : Fields<
+    Field<&Hit::shooter, Codec::SteamId>,
+    Field<&Hit::bulletIndex, Codec::VarU32>,
+    Field<&Hit::enemyId, Codec::VarU64>,
+    Field<&Hit::damage, Codec::SVarInt>,
+    Field<&Hit::tick, Codec::Tick16>> {};
+
+struct NextLevel {
+    static constexpr MsgId kId = MsgId::NextLevel;
+    float duration = 0.f;
+};
+template <>
+struct Schema<NextLevel> : Fields<
+    Field<&NextLevel::duration, Codec::Timer8>> {};
+
+struct Timer {
+    static constexpr MsgId kId = MsgId::Timer;
+    float remaining = 0.f;
+};
+template <>
+struct Schema<Timer> : Fields<
+    Field<&Timer::remaining, Codec::Timer8>> {};
+
+struct Ping {
+    static constexpr MsgId kId = MsgId::Ping;
+    uint32_t nonce = 0;
+};
+template <>
+struct Schema<Ping> : Fields<
+    Field<&Ping::nonce, Codec::VarU32>> {};
+
+struct Pong {
+    static constexpr MsgId kId = MsgId::Pong;
+    uint32_t nonce = 0;
+};
+template <>
+struct Schema<Pong> : Fields<
+    Field<&Pong::nonce, Codec::VarU32>> {};
+
+/**
+ * @brief One part of a world snapshot (see SnapshotReplicator).
+ *
+ * The body holds delta records against snapshot `baseline` (or against an
+ * empty world when hasBaseline is false). A snapshot is applied once all
+ * partCount parts with the same seq have arrived.
+ */
+struct SnapshotPart {
+    static constexpr MsgId kId = MsgId::SnapshotPart;
+    Tick seq = 0;
+    Tick baseline = 0;
+    Tick tick = 0;           ///< Host simulation tick the snapshot was taken at.
+    uint8_t part = 0;
+    uint8_t partCount = 1;
+    bool hasBaseline = false;
+    ByteSpan body;
+};
+template <>
+struct Schema<SnapshotPart> : Fields<
+    Field<&SnapshotPart::seq, Codec::Tick16>,
+    Field<&SnapshotPart::baseline, Codec::Tick16>,
+    Field<&SnapshotPart::tick, Codec::Tick16>,
+    Field<&SnapshotPart::part, Codec::U8>,
+    Field<&SnapshotPart::partCount, Codec::U8>,
+    Bits<&SnapshotPart::hasBaseline>,
+    Field<&SnapshotPart::body, Codec::Bytes<kMaxSnapshotBody>>> {};
+
+/**
+ * @brief Client acknowledgement of a fully applied snapshot.
+ */
+struct SnapshotAck {
+    static constexpr MsgId kId = MsgId::SnapshotAck;
+    Tick seq = 0;
+    bool resync = false;     ///< The client lacks the baseline it was sent; send a full snapshot.
+};
+template <>
+struct Schema<SnapshotAck> : Fields<
+    Field<&SnapshotAck::seq, Codec::Tick16>,
+    Bits<&SnapshotAck::resync>> {};
+
+//------------------------------------------------------------------------------
+// Generated encoders, decoders, sizes and dispatch
+//------------------------------------------------------------------------------
+
+template <typename... Msgs>
+struct MessageList {};
+
+/// Every message on the wire; each id must appear exactly once.
+using Messages = MessageList<Welcome, PlayerLoaded, PlayerUpdate, EnemySpawn, EnemyUpdate,
+                             EnemyDeath, EnemyRemove, BulletFire, Hit, Start, NextLevel,
+                             Timer, Play, GameOver, LobbyReturn, Ping, Pong,
+                             SnapshotPart, SnapshotAck>;
+
+/// Largest possible frame (id + payload) of a message.
+template <typename Msg>
+constexpr std::size_t kMaxFrameSize = 1 + Schema<Msg>::kMaxSize;
+
+namespace detail {
+    constexpr std::size_t kIdCount = static_cast<std::size_t>(MsgId::Count);
+
+    template <typename... Msgs>
+    constexpr bool coversEveryIdOnce(MessageList<Msgs...>) {
+        std::array<int, kIdCount> seen{};
+        ((++seen[static_cast<std::size_t>(Msgs::kId)]), ...);
+        for (std::size_t id = 1; id < kIdCount; ++id)
+            if (seen[id] != 1) return false;
+        return seen[0] == 0;
+    }
+
+    template <typename... Msgs>
+    constexpr std::size_t largestFrame(MessageList<Msgs...>) {
+        std::size_t largest = 0;
+        ((largest = kMaxFrameSize<Msgs> > largest ? kMaxFrameSize<Msgs> : largest), ...);
+        return largest;
+    }
+}
+
+static_assert(detail::coversEveryIdOnce(Messages{}), "every MsgId needs exactly one message type in Wire::Messages");
+
+/// Largest frame of any message; sizes receive buffers and bounds packet packing.
+constexpr std::size_t kLargestFrame = detail::largestFrame(Messages{});
+
+/**
+ * @brief Writes a complete frame (id and payload) into a cleared writer.
+ */
+template <typename Msg>
+void encode(ByteWriter& w, const Msg& msg) {
+    w.clear();
+    w.header(Msg::kId);
+    Schema<Msg>::write(w, msg);
+}
+
+/**
+ * @brief Reads a payload; the reader must be positioned after the message id.
+ * @return false if the payload is truncated, out of range or has trailing bytes.
+ */
+template <typename Msg>
+bool decode(ByteReader& r, Msg& msg) {
+    Schema<Msg>::read(r, msg);
+    return r.ok() && r.atEnd();
+}
+
+/// Decodes a payload and hands it to the receiver; false if it was malformed.
+template <typename Receiver>
+using Dispatcher = bool (*)(Receiver& receiver, ByteReader& reader, CSteamID sender);
+
+namespace detail {
+    template <typename Receiver, typename Msg>
+    bool dispatchAs(Receiver& receiver, ByteReader& reader, CSteamID sender) {
+        Msg msg;
+        if (!decode(reader, msg)) return false;
+        receiver.HandleMessage(msg, sender);
+        return true;
+    }
+
+    template <typename Receiver, typename... Msgs>
+    constexpr std::array<Dispatcher<Receiver>, kIdCount> makeDispatchTable(MessageList<Msgs...>) {
+        std::array<Dispatcher<Receiver>, kIdCount> table{};
+        ((table[static_cast<std::size_t>(Msgs::kId)] = &dispatchAs<Receiver, Msgs>), ...);
+        return table;
+    }
+}
+
+/**
+ * @brief Table indexed by message id that decodes each message and calls
+ *        receiver.HandleMessage(msg, sender); a missing overload does not compile.
+ */
+template <typename Receiver>
+constexpr std::array<Dispatcher<Receiver>, detail::kIdCount> makeDispatchTable() {
+    return detail::makeDispatchTable<Receiver>(Messages{});
+}
+
+} // namespace Wire
+
+#endif // WIREPROTOCOL_H
@@ -0,0 +1,301 @@
+#include "WorldSnapshot.h"
+#include <algorithm>
+
+namespace {
+    enum RecordKind : uint8_t {
+        EnemyRecord = 1,
+        EnemyRemovedRecord,
+        PlayerRecord,
+        PlayerRemovedRecord,
+        EnemyLeftRecord
+    };
+
+    // Field mask bits. New entities set NewEntity and carry every field.
+    enum EnemyField : uint8_t {
+        EnemyX = 1, EnemyY = 2, EnemyHealth = 4, EnemySpawnDelay = 8, EnemyType = 16
+    };
+    enum PlayerField : uint8_t {
+        PlayerX = 1, PlayerY = 2, PlayerHealth = 4, PlayerKills = 8,
+        PlayerMoney = 16, PlayerSpeed = 32, PlayerFlags = 64
+    };
+    constexpr uint8_t kAllEnemyFields = 0x1F;
+    constexpr uint8_t kAllPlayerFields = 0x7F;
+    constexpr uint8_t kNewEntity = 0x80;
+
+    // Worst-case record sizes; a body is closed before it could overflow.
+    constexpr std::size_t kMaxEnemyRecord = 1 + 10 + 1 + 2 + 2 + 1 + 1 + 1;
+    constexpr std::size_t kMaxPlayerRecord = 1 + 4 + 1 + 2 + 2 + 5 + 5 + 5 + 2 + 1;
+
+    template <typename T, typename Id>
+    typename std::vector<T>::iterator findById(std::vector<T>& list, Id id, Id T::*key) {
+        return std::lower_bound(list.begin(), list.end(), id,
+                                [key](const T& s, Id v) { return s.*key < v; });
+    }
+
+    uint8_t enemyMask(const EnemyNetState& a, const EnemyNetState& b) {
+        uint8_t mask = 0;
+        if (a.x != b.x) mask |= EnemyX;
+        if (a.y != b.y) mask |= EnemyY;
+        if (a.health != b.health) mask |= EnemyHealth;
+        if (a.spawnDelay != b.spawnDelay) mask |= EnemySpawnDelay;
+        if (a.type != b.type) mask |= EnemyType;
+        return mask;
+    }
+
+    uint8_t playerMask(const PlayerNetState& a, const PlayerNetState& b) {
+        uint8_t mask = 0;
+        if (a.x != b.x) mask |= PlayerX;
+        if (a.y != b.y) mask |= PlayerY;
+        if (a.health != b.health) mask |= PlayerHealth;
+        if (a.kills != b.kills) mask |= PlayerKills;
+        if (a.money != b.money) mask |= PlayerMoney;
+        if (a.speed != b.speed) mask |= PlayerSpeed;
+        if (a.flags != b.flags) mask |= PlayerFlags;
+        return mask;
+    }
+
+    /**
+     * @brief Visitor that writes delta records, starting a new body when one fills up.
+     */
+    class DeltaWriter : public SnapshotVisitor {
+    public:
+        DeltaWriter(std::vector<Wire::ByteWriter>& bodies, const WorldSnapshot* world)
+            : m_bodies(bodies), m_world(world) {}
+
+        void enemyAdded(const EnemyNetState& now) override { writeEnemy(now, kNewEntity | kAllEnemyFields); }
+        void enemyChanged(const EnemyNetState& before, const EnemyNetState& now) override {
+            const uint8_t mask = enemyMask(before, now);
+            if (mask) writeEnemy(now, mask);
+        }
+        void enemyRemoved(uint64_t id) override {
+            Wire::ByteWriter& w = body(kMaxEnemyRecord);
+            w.u8(m_world && contains(m_world->enemies, id) ? EnemyLeftRecord : EnemyRemovedRecord);
+            w.varint(id);
+        }
+        void playerAdded(const PlayerNetState& now) override { writePlayer(now, kNewEntity | kAllPlayerFields); }
+        void playerChanged(const PlayerNetState& before, const PlayerNetState& now) override {
+            const uint8_t mask = playerMask(before, now);
+            if (mask) writePlayer(now, mask);
+        }
+        void playerRemoved(uint32_t account) override {
+            Wire::ByteWriter& w = body(kMaxPlayerRecord);
+            w.u8(PlayerRemovedRecord);
+            w.u32(account);
+        }
+
+        std::size_t count() const { return m_count; }
+
+    private:
+        Wire::ByteWriter& body(std::size_t recordSize) {
+            if (m_count == 0 || m_bodies[m_count - 1].size() + recordSize > Wire::kMaxSnapshotBody) {
+                if (m_count == m_bodies.size())
+                    m_bodies.emplace_back();
+                m_bodies[m_count++].clear();
+            }
+            return m_bodies[m_count - 1];
+        }
+
+        void writeEnemy(const EnemyNetState& s, uint8_t mask) {
+            Wire::ByteWriter& w = body(kMaxEnemyRecord);
+            w.u8(EnemyRecord);
+            w.varint(s.id);
+            w.u8(mask);
+            if (mask & EnemyX) w.u16(s.x);
+            if (mask & EnemyY) w.u16(s.y);
+            if (mask & EnemyHealth) w.u8(s.health);
+            if (mask & EnemySpawnDelay) w.u8(s.spawnDelay);
+            if (mask & EnemyType) Wire::Codec::EnemyType::write(w, s.type);
+        }
+
+        void writePlayer(const PlayerNetState& s, uint8_t mask) {
+            Wire::ByteWriter& w = body(kMaxPlayerRecord);
+            w.u8(PlayerRecord);
+            w.u32(s.account);
+            w.u8(mask);
+            if (mask & PlayerX) w.u16(s.x);
+            if (mask & PlayerY) w.u16(s.y);
+            if (mask & PlayerHealth) w.svarint(s.health);
+            if (mask & PlayerKills) w.svarint(s.kills);
+            if (mask & PlayerMoney) w.svarint(s.money);
+            if (mask & PlayerSpeed) w.u16(s.speed);
+            if (mask & PlayerFlags) w.u8(s.flags);
+        }
+
+        static bool contains(const std::vector<EnemyNetState>& enemies, uint64_t id) {
+            auto it = std::lower_bound(enemies.begin(), enemies.end(), id,
+                                       [](const EnemyNetState& s, uint64_t v) { return s.id < v; });
+            return it != enemies.end() && it->id == id;
+        }
+
+        std::vector<Wire::ByteWriter>& m_bodies;
+        const WorldSnapshot* m_world;
+        std::size_t m_count = 0;
+    };
+
+    int readInt(Wire::ByteReader& r) {
+        return static_cast<int>(r.svarint());
+    }
+}
+
+//-------------------------------------------------------------------------
+// WorldSnapshot
+//-------------------------------------------------------------------------
+void WorldSnapshot::sort() {
+    std::sort(enemies.begin(), enemies.end(),
+              [](const EnemyNetState& a, const EnemyNetState& b) { return a.id < b.id; });
+    std::sort(players.begin(), players.end(),
+              [](const PlayerNetState& a, const PlayerNetState& b) { return a.account < b.account; });
+}
+
+//-------------------------------------------------------------------------
+// Diff
+//-------------------------------------------------------------------------
+void diffSnapshots(const WorldSnapshot* from, const WorldSnapshot& to, SnapshotVisitor& visitor) {
+    static const WorldSnapshot empty;
+    const WorldSnapshot& a = from ? *from : empty;
+
+    std::size_t i = 0, j = 0;
+    while (i < a.enemies.size() || j < to.enemies.size()) {
+        if (j == to.enemies.size() || (i < a.enemies.size() && a.enemies[i].id < to.enemies[j].id)) {
+            const uint64_t id = a.enemies[i++].id;
+            if (std::binary_search(to.departed.begin(), to.departed.end(), id))
+                visitor.enemyLeft(id);
+            else
+                visitor.enemyRemoved(id);
+        } else if (i == a.enemies.size() || to.enemies[j].id < a.enemies[i].id) {
+            visitor.enemyAdded(to.enemies[j++]);
+        } else {
+            visitor.enemyChanged(a.enemies[i++], to.enemies[j++]);
+        }
+    }
+
+    i = j = 0;
+    while (i < a.players.size() || j < to.players.size()) {
+        if (j == to.players.size() || (i < a.players.size() && a.players[i].account < to.players[j].account)) {
+            visitor.playerRemoved(a.players[i++].account);
+        } else if (i == a.players.size() || to.players[j].account < a.players[i].account) {
+            visitor.playerAdded(to.players[j++]);
+        } else {
+            visitor.playerChanged(a.players[i++], to.players[j++]);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Delta Encoding
+//-------------------------------------------------------------------------
+std::size_t writeSnapshotDelta(const WorldSnapshot* base, const WorldSnapshot& to, std::vector<Wire::ByteWriter>& bodies,
+                               const WorldSnapshot* world) {
+    DeltaWriter writer(bodies, world);
+    diffSnapshots(base, to, writer);
+    if (writer.count() == 0) {
+        // Nothing changed: still send one empty part so the client can acknowledge.
+        if (bodies.empty()) bodies.emplace_back();
+        bodies[0].clear();
+        return 1;
+    }
+    return writer.count();
+}
+
+std::size_t enemyRecordSize(const EnemyNetState* base, const EnemyNetState& now) {
+    const uint8_t mask = base ? enemyMask(*base, now) : kAllEnemyFields;
+    if (!mask) return 0;
+    std::size_t size = 3; // Kind, mask and at least one id byte.
+    for (uint64_t id = now.id; id >= 0x80; id >>= 7) ++size;
+    if (mask & EnemyX) size += 2;
+    if (mask & EnemyY) size += 2;
+    if (mask & EnemyHealth) size += 1;
+    if (mask & EnemySpawnDelay) size += 1;
+    if (mask & EnemyType) size += 1;
+    return size;
+}
+
+bool readSnapshotDelta(const Wire::ByteSpan& body, WorldSnapshot& world) {
+    Wire::ByteReader r(body.data, body.size);
+    while (r.ok() && !r.atEnd()) {
+        const uint8_t kind = r.u8();
+        switch (kind) {
+            case EnemyRecord: {
+                const uint64_t id = r.varint();
+                const uint8_t mask = r.u8();
+                auto it = findById(world.enemies, id, &EnemyNetState::id);
+                if (it == world.enemies.end() || it->id != id) {
+                    if (!(mask & kNewEntity)) return false; // Delta for an entity the baseline lacks.
+                    EnemyNetState added;
+                    added.id = id;
+                    it = world.enemies.insert(it, added);
+                }
+                if (mask & EnemyX) it->x = r.u16();
+                if (mask & EnemyY) it->y = r.u16();
+                if (mask & EnemyHealth) it->health = r.u8();
+                if (mask & EnemySpawnDelay) it->spawnDelay = r.u8();
+                if (mask & EnemyType) Wire::Codec::EnemyType::read(r, it->type);
+                break;
+            }
+            case EnemyRemovedRecord:
+            case EnemyLeftRecord: {
+                const uint64_t id = r.varint();
+                auto it = findById(world.enemies, id, &EnemyNetState::id);
+                if (it != world.enemies.end() && it->id == id)
+                    world.enemies.erase(it);
+                if (kind == EnemyLeftRecord)
+                    world.departed.insert(std::lower_bound(world.departed.begin(), world.departed.end(), id), id);
+                break;
+            }
+            case PlayerRecord: {
+                const uint32_t account = r.u32();
+                const uint8_t mask = r.u8();
+                auto it = findById(world.players, account, &PlayerNetState::account);
+                if (it == world.players.end() || it->account != account) {
+                    if (!(mask & kNewEntity)) return false;
+                    PlayerNetState added;
+                    added.account = account;
+                    it = world.players.insert(it, added);
+                }
+                if (mask & PlayerX) it->x = r.u16();
+                if (mask & PlayerY) it->y = r.u16();
+                if (mask & PlayerHealth) it->health = readInt(r);
+                if (mask & PlayerKills) it->kills = readInt(r);
+                if (mask & PlayerMoney) it->money = readInt(r);
+                if (mask & PlayerSpeed) it->speed = r.u16();
+                if (mask & PlayerFlags) it->flags = r.u8();
+                break;
+            }
+            case PlayerRemovedRecord: {
+                const uint32_t account = r.u32();
+                auto it = findById(world.players, account, &PlayerNetState::account);
+                if (it != world.players.end() && it->account == account)
+                    world.players.erase(it);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return r.ok();
+}
+
+//-------------------------------------------------------------------------
+// SnapshotHistory
+//-------------------------------------------------------------------------
+SnapshotHistory::SnapshotHistory(std::size_t capacity)
+    : m_slots(capacity), m_valid(capacity, false)
+{
+}
+
+WorldSnapshot& SnapshotHistory::store(Wire::Tick seq) {
+    const std::size_t slot = seq % m_slots.size();
+    m_valid[slot] = true;
+    WorldSnapshot& snapshot = m_slots[slot];
+    snapshot.seq = seq;
+    return snapshot;
+}
+
+const WorldSnapshot* SnapshotHistory::find(Wire::Tick seq) const {
+    const std::size_t slot = seq % m_slots.size();
+    return m_valid[slot] && m_slots[slot].seq == seq ? &m_slots[slot] : nullptr;
+}
+
+void SnapshotHistory::clear() {
+    std::fill(m_valid.begin(), m_valid.end(), false);
+}
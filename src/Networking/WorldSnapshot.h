@@ -0,0 +1,125 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "WireProtocol.h"
+
+/**
+ * @brief Replicated state of one enemy, already quantised to its wire form.
+ *
+ * Storing wire values means two snapshots differ exactly when the bytes a
+ * client would receive differ.
+ */
+struct EnemyNetState {
+    uint64_t id = 0;
+    uint16_t x = 0, y = 0;   ///< Wire::quantizePosition around the arena origin.
+    uint8_t health = 0;      ///< Clamped to 0 - 255.
+    uint8_t spawnDelay = 0;  ///< Wire::quantizeTimer.
+    uint8_t type = 0;
+};
+
+/**
+ * @brief Replicated state of one player, already quantised to its wire form.
+ */
+struct PlayerNetState {
+    enum Flags : uint8_t { Ready = 1, Alive = 2 };
+    uint32_t account = 0;    ///< Steam account id (individual, public universe).
+    uint16_t x = 0, y = 0;
+    int health = 0;
+    int kills = 0;
+    int money = 0;
+    uint16_t speed = 0;      ///< Wire::quantizeSpeed.
+    uint8_t flags = 0;
+};
+
+/**
+ * @brief The host's replicated world at one network tick.
+ *
+ * Both lists are sorted by id so two snapshots can be diffed in one merge pass.
+ */
+struct WorldSnapshot {
+    Wire::Tick seq = 0;      ///< Snapshot number (wraps; compared with Wire::tickBefore).
+    Wire::Tick tick = 0;     ///< Host simulation tick it was taken at.
+    std::vector<EnemyNetState> enemies;
+    std::vector<PlayerNetState> players;
+    std::vector<uint64_t> departed; ///< Client side: enemies that left the area of interest in this snapshot (sorted).
+
+    void clear() { enemies.clear(); players.clear(); departed.clear(); }
+    void sort(); ///< Restores id order after filling the lists.
+};
+
+/**
+ * @brief Receives the differences found by diffSnapshots().
+ */
+class SnapshotVisitor {
+public:
+    virtual ~SnapshotVisitor() = default;
+    virtual void enemyAdded(const EnemyNetState& /*now*/) {}
+    virtual void enemyChanged(const EnemyNetState& /*before*/, const EnemyNetState& /*now*/) {}
+    virtual void enemyRemoved(uint64_t /*id*/) {}
+    /// An enemy left the receiver's area of interest; it still exists on the host.
+    virtual void enemyLeft(uint64_t id) { enemyRemoved(id); }
+    virtual void playerAdded(const PlayerNetState& /*now*/) {}
+    virtual void playerChanged(const PlayerNetState& /*before*/, const PlayerNetState& /*now*/) {}
+    virtual void playerRemoved(uint32_t /*account*/) {}
+};
+
+/**
+ * @brief Reports every entity added, changed or removed between two snapshots, in id order.
+ *
+ * Enemies listed in `to.departed` are reported as having left rather than removed.
+ * @param from Older snapshot, or nullptr for an empty world.
+ */
+void diffSnapshots(const WorldSnapshot* from, const WorldSnapshot& to, SnapshotVisitor& visitor);
+
+/**
+ * @brief Encodes `to` as delta records against `base`, split into snapshot bodies.
+ *
+ * Each record carries an entity id and a bitmask of the fields that differ
+ * from the baseline, followed by only those fields; new entities carry every
+ * field and removed ones only their id. Unchanged entities cost nothing.
+ *
+ * @param base Baseline the receiver already has, or nullptr to encode everything.
+ * @param bodies Receives one writer per part, each at most Wire::kMaxSnapshotBody bytes.
+ * @param world Unfiltered snapshot when `to` is one client's area of interest;
+ *              enemies missing from `to` but alive in `world` are sent as having left.
+ * @return Number of bodies written.
+ */
+std::size_t writeSnapshotDelta(const WorldSnapshot* base, const WorldSnapshot& to, std::vector<Wire::ByteWriter>& bodies,
+                               const WorldSnapshot* world = nullptr);
+
+/**
+ * @brief Bytes the delta record for an enemy would take.
+ * @param base The enemy as the receiver has it, or nullptr if it is new to the receiver.
+ * @return 0 if nothing changed.
+ */
+std::size_t enemyRecordSize(const EnemyNetState* base, const EnemyNetState& now);
+
+/**
+ * @brief Applies the records of one snapshot body to a copy of the baseline.
+ * @return false if the body is malformed; `world` is then partially updated.
+ */
+bool readSnapshotDelta(const Wire::ByteSpan& body, WorldSnapshot& world);
+
+/**
+ * @brief Fixed-size ring of recent snapshots, indexed by sequence number.
+ */
+class SnapshotHistory {
+public:
+    explicit SnapshotHistory(std::size_t capacity);
+
+    /// Slot that will hold snapshot `seq`, replacing whatever was there.
+    WorldSnapshot& store(Wire::Tick seq);
+    /// Snapshot `seq` if it is still held.
+    const WorldSnapshot* find(Wire::Tick seq) const;
+    void clear();
+    std::size_t capacity() const { return m_slots.size(); }
+
+private:
+    std::vector<WorldSnapshot> m_slots;
+    std::vector<bool> m_valid;
+};
+
+#endif // WORLDSNAPSHOT_H
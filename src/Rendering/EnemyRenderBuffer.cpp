@@ -0,0 +1,208 @@
+#include "EnemyRenderBuffer.h"
+#include "../Utils/FastHash.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+EnemyRenderBuffer::EnemyRenderBuffer()
+    : m_buffer(sf::Quads, sf::VertexBuffer::Stream),
+      m_useBuffer(sf::VertexBuffer::isAvailable()),
+      m_dirtyBegin(std::numeric_limits<std::size_t>::max()),
+      m_dirtyEnd(0)
+{
+}
+
+//-------------------------------------------------------------------------
+// Frame Lifecycle
+//-------------------------------------------------------------------------
+void EnemyRenderBuffer::beginFrame() {
+    ++m_frame;
+    m_seenThisFrame = 0;
+    m_rewrittenQuads = 0;
+    m_uploadedVertices = 0;
+}
+
+void EnemyRenderBuffer::submit(const Enemy& enemy) {
+    if (enemy.health <= 0 || std::isnan(enemy.renderedX) || std::isnan(enemy.renderedY))
+        return;
+
+    sf::Vector2f pos(enemy.renderedX, enemy.renderedY);
+    if (enemy.isSplitting && enemy.shakeTimer > 0) {
+        // Deterministic per-enemy jitter instead of rand(); varies every frame.
+        float shake = enemy.shakeTimer / enemy.shakeDuration;
+        pos.x += hashJitter(enemy.id, m_frame, 0) * shake;
+        pos.y += hashJitter(enemy.id, m_frame, 1) * shake;
+    }
+    submit(enemy.id, pos, enemy.size, enemy.color, enemy.type);
+}
+
+void EnemyRenderBuffer::submit(uint64_t id, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& color, Enemy::Type type) {
+    auto it = m_slotOf.find(id);
+    std::size_t slot;
+    if (it == m_slotOf.end()) {
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = m_slots.size();
+            m_slots.emplace_back();
+            m_vertices.resize(m_slots.size() * 4);
+        }
+        m_slotOf.emplace(id, slot);
+        m_slots[slot].id = id;
+        m_slots[slot].live = true;
+        writeQuad(slot, pos, size, color, type);
+    } else {
+        slot = it->second;
+        const Slot& s = m_slots[slot];
+        if (s.pos != pos || s.size != size || s.color != color || s.type != type)
+            writeQuad(slot, pos, size, color, type);
+    }
+
+    if (m_slots[slot].seenFrame != m_frame) {
+        m_slots[slot].seenFrame = m_frame;
+        ++m_seenThisFrame;
+    }
+}
+
+void EnemyRenderBuffer::endFrame() {
+    // Only scan for stale slots when fewer enemies were submitted than own a slot.
+    if (m_seenThisFrame < m_slotOf.size()) {
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].live && m_slots[i].seenFrame != m_frame)
+                releaseSlot(i);
+        }
+    }
+
+    // Compact lazily: only once holes outnumber live quads.
+    const std::size_t minHolesForCompaction = 256;
+    if (m_freeSlots.size() > minHolesForCompaction && m_freeSlots.size() > m_slotOf.size())
+        compact();
+
+    upload();
+}
+
+void EnemyRenderBuffer::clear() {
+    m_slotOf.clear();
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_vertices.clear();
+    m_dirtyBegin = std::numeric_limits<std::size_t>::max();
+    m_dirtyEnd = 0;
+    m_fullUpload = true;
+}
+
+void EnemyRenderBuffer::setSprites(const EntitySprites* sprites) {
+    m_sprites = sprites;
+    for (std::size_t i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i].live)
+            writeQuad(i, m_slots[i].pos, m_slots[i].size, m_slots[i].color, m_slots[i].type);
+    }
+}
+
+//-------------------------------------------------------------------------
+// Slot Management
+//-------------------------------------------------------------------------
+void EnemyRenderBuffer::writeQuad(std::size_t slot, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& color, Enemy::Type type) {
+    Slot& s = m_slots[slot];
+    s.pos = pos;
+    s.size = size;
+    s.color = color;
+    s.type = type;
+
+    sf::Vertex* quad = &m_vertices[slot * 4];
+    quad[0].position = pos;
+    quad[1].position = sf::Vector2f(pos.x + size.x, pos.y);
+    quad[2].position = sf::Vector2f(pos.x + size.x, pos.y + size.y);
+    quad[3].position = sf::Vector2f(pos.x, pos.y + size.y);
+    for (int j = 0; j < 4; ++j)
+        quad[j].color = color;
+    if (m_sprites) {
+        const sf::FloatRect& uv = m_sprites->forEnemy(type);
+        quad[0].texCoords = sf::Vector2f(uv.left, uv.top);
+        quad[1].texCoords = sf::Vector2f(uv.left + uv.width, uv.top);
+        quad[2].texCoords = sf::Vector2f(uv.left + uv.width, uv.top + uv.height);
+        quad[3].texCoords = sf::Vector2f(uv.left, uv.top + uv.height);
+    }
+
+    ++m_rewrittenQuads;
+    markDirty(slot);
+}
+
+void EnemyRenderBuffer::markDirty(std::size_t slot) {
+    m_dirtyBegin = std::min(m_dirtyBegin, slot);
+    m_dirtyEnd = std::max(m_dirtyEnd, slot + 1);
+}
+
+void EnemyRenderBuffer::releaseSlot(std::size_t slot) {
+    Slot& s = m_slots[slot];
+    m_slotOf.erase(s.id);
+    s.live = false;
+
+    // Collapse the quad so the hole draws nothing until it is reused.
+    sf::Vertex* quad = &m_vertices[slot * 4];
+    for (int j = 0; j < 4; ++j)
+        quad[j] = sf::Vertex(sf::Vector2f(0.f, 0.f), sf::Color::Transparent);
+    markDirty(slot);
+
+    m_freeSlots.push_back(slot);
+}
+
+void EnemyRenderBuffer::compact() {
+    std::size_t write = 0;
+    for (std::size_t read = 0; read < m_slots.size(); ++read) {
+        if (!m_slots[read].live) continue;
+        if (write != read) {
+            m_slots[write] = m_slots[read];
+            std::copy(m_vertices.begin() + read * 4, m_vertices.begin() + read * 4 + 4,
+                      m_vertices.begin() + write * 4);
+            m_slotOf[m_slots[write].id] = write;
+        }
+        ++write;
+    }
+    m_slots.resize(write);
+    m_vertices.resize(write * 4);
+    m_freeSlots.clear();
+    m_fullUpload = true;
+}
+
+//-------------------------------------------------------------------------
+// GPU Upload & Rendering
+//-------------------------------------------------------------------------
+void EnemyRenderBuffer::upload() {
+    const std::size_t usedSlots = m_slots.size();
+    if (m_useBuffer && usedSlots > 0) {
+        if (usedSlots > m_bufferSlots) {
+            m_bufferSlots = std::max<std::size_t>({ usedSlots, m_bufferSlots * 2, 256 });
+            m_buffer.create(m_bufferSlots * 4);
+            m_fullUpload = true;
+        }
+        if (m_fullUpload) {
+            m_buffer.update(m_vertices.data(), usedSlots * 4, 0);
+            m_uploadedVertices = usedSlots * 4;
+        } else if (m_dirtyBegin < m_dirtyEnd) {
+            std::size_t end = std::min(m_dirtyEnd, usedSlots);
+            if (m_dirtyBegin < end) {
+                m_buffer.update(&m_vertices[m_dirtyBegin * 4], (end - m_dirtyBegin) * 4,
+                                static_cast<unsigned int>(m_dirtyBegin * 4));
+                m_uploadedVertices = (end - m_dirtyBegin) * 4;
+            }
+        }
+    }
+    m_fullUpload = false;
+    m_dirtyBegin = std::numeric_limits<std::size_t>::max();
+    m_dirtyEnd = 0;
+}
+
+void EnemyRenderBuffer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    const std::size_t vertexCount = getVertexCount();
+    if (vertexCount == 0) return;
+    states.texture = getTexture();
+    if (m_useBuffer)
+        target.draw(m_buffer, 0, vertexCount, states);
+    else
+        target.draw(m_vertices.data(), vertexCount, sf::Quads, states);
+}
@@ -0,0 +1,110 @@
+#ifndef ENEMYRENDERBUFFER_H
+#define ENEMYRENDERBUFFER_H
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "../Entities/Enemy.h"
+#include "EntitySprites.h"
+
+/**
+ * @brief Persistent, partially updated vertex storage for enemy quads.
+ *
+ * Every enemy owns a quad slot for as long as it is submitted each frame.
+ * Only quads whose position, size or colour changed are rewritten, and only
+ * the dirty range is uploaded to an sf::VertexBuffer (Stream usage). When
+ * vertex buffers are unavailable, the CPU-side shadow array is drawn directly.
+ *
+ * Slots of enemies that stop being submitted are released at the end of the
+ * frame and reused; the array is compacted lazily once holes dominate.
+ */
+class EnemyRenderBuffer : public sf::Drawable {
+public:
+    EnemyRenderBuffer();
+
+    /**
+     * @brief Starts a frame. Must be called before submit().
+     */
+    void beginFrame();
+
+    /**
+     * @brief Writes (or refreshes) the quad of an enemy for this frame.
+     * @param enemy Enemy to draw at its interpolated position.
+     */
+    void submit(const Enemy& enemy);
+
+    /**
+     * @brief Same, for an enemy known only by id (render-thread snapshots).
+     * @param pos Final top-left position, shake included.
+     */
+    void submit(uint64_t id, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& color, Enemy::Type type);
+
+    /**
+     * @brief Releases unsubmitted slots, compacts if needed and uploads changes.
+     */
+    void endFrame();
+
+    /**
+     * @brief Drops every slot, e.g. when leaving gameplay.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the atlas sprites used for enemy quads; existing quads are rewritten.
+     * @param sprites Sprite set (must outlive this buffer), or nullptr for flat colour.
+     */
+    void setSprites(const EntitySprites* sprites);
+
+    /// Texture enemy quads sample from (nullptr when flat-coloured).
+    const sf::Texture* getTexture() const { return m_sprites ? m_sprites->texture : nullptr; }
+
+    bool empty() const { return m_slots.empty(); }                         ///< True if there is nothing to draw.
+    std::size_t getLiveCount() const { return m_slotOf.size(); }           ///< Enemies with a slot.
+    std::size_t getVertexCount() const { return m_slots.size() * 4; }      ///< Vertices draw() submits, holes included.
+    std::size_t getRewrittenQuads() const { return m_rewrittenQuads; }     ///< Quads rewritten last frame.
+    std::size_t getUploadedVertices() const { return m_uploadedVertices; } ///< Vertices uploaded last frame.
+
+private:
+    /**
+     * @brief Draws all live quads in one call (via target.draw(buffer) or a RenderQueue).
+     */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    struct Slot {
+        uint64_t id = 0;        ///< Owning enemy id.
+        sf::Vector2f pos;       ///< Last written top-left position.
+        sf::Vector2f size;      ///< Last written size.
+        sf::Color color;        ///< Last written colour.
+        Enemy::Type type = Enemy::Default; ///< Last written sprite.
+        uint32_t seenFrame = 0; ///< Frame in which the slot was last submitted.
+        bool live = false;      ///< False for holes waiting to be reused.
+    };
+
+    void writeQuad(std::size_t slot, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& color, Enemy::Type type);
+    void markDirty(std::size_t slot);
+    void releaseSlot(std::size_t slot);
+    void compact();
+    void upload();
+
+    std::unordered_map<uint64_t, std::size_t> m_slotOf; ///< Enemy id -> slot index.
+    std::vector<Slot> m_slots;                          ///< Slot metadata.
+    std::vector<std::size_t> m_freeSlots;               ///< Holes available for reuse.
+    std::vector<sf::Vertex> m_vertices;                 ///< CPU shadow copy, 4 vertices per slot.
+    const EntitySprites* m_sprites = nullptr;           ///< Atlas rectangles per enemy type.
+
+    sf::VertexBuffer m_buffer;      ///< GPU copy (Stream usage).
+    bool m_useBuffer;               ///< False when vertex buffers are unsupported.
+    std::size_t m_bufferSlots = 0;  ///< Slot capacity of m_buffer.
+    bool m_fullUpload = false;      ///< Set after growth/compaction to re-upload everything.
+
+    std::size_t m_dirtyBegin;       ///< First dirty slot (inclusive).
+    std::size_t m_dirtyEnd;         ///< Last dirty slot (exclusive).
+    uint32_t m_frame = 0;           ///< Frame counter used for liveness and shake.
+    std::size_t m_seenThisFrame = 0;
+
+    std::size_t m_rewrittenQuads = 0;
+    std::size_t m_uploadedVertices = 0;
+};
+
+#endif // ENEMYRENDERBUFFER_H
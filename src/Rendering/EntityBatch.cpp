@@ -0,0 +1,53 @@
+#include "EntityBatch.h"
+#include "../Utils/Config.h"
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+EntityBatch::EntityBatch()
+    : m_vertices(sf::Quads)
+{
+    m_styles[static_cast<std::size_t>(Kind::Player)] = { sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE), sf::Color::Blue, sf::FloatRect() };
+    m_styles[static_cast<std::size_t>(Kind::Bullet)] = { sf::Vector2f(BULLET_SIZE, BULLET_SIZE), sf::Color::Yellow, sf::FloatRect() };
+}
+
+//-------------------------------------------------------------------------
+// Batch Building
+//-------------------------------------------------------------------------
+void EntityBatch::begin() {
+    // sf::VertexArray::clear keeps the underlying storage, so steady-state
+    // frames do not reallocate.
+    m_vertices.clear();
+}
+
+void EntityBatch::add(Kind kind, float x, float y) {
+    const KindStyle& style = m_styles[static_cast<std::size_t>(kind)];
+    add(x, y, style.size, style.color, style.texRect);
+}
+
+void EntityBatch::add(float x, float y, const sf::Vector2f& size, const sf::Color& color, const sf::FloatRect& texRect) {
+    const float u0 = texRect.left, v0 = texRect.top;
+    const float u1 = texRect.left + texRect.width, v1 = texRect.top + texRect.height;
+    m_vertices.append(sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u0, v0)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(x + size.x, y), color, sf::Vector2f(u1, v0)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(x + size.x, y + size.y), color, sf::Vector2f(u1, v1)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(x, y + size.y), color, sf::Vector2f(u0, v1)));
+}
+
+void EntityBatch::setStyle(Kind kind, const KindStyle& style) {
+    m_styles[static_cast<std::size_t>(kind)] = style;
+}
+
+//-------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------
+unsigned int EntityBatch::draw(sf::RenderTarget& target) const {
+    if (m_vertices.getVertexCount() == 0) return 0;
+    target.draw(m_vertices, sf::RenderStates(m_texture));
+    return 1;
+}
+
+void EntityBatch::submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view) const {
+    if (m_vertices.getVertexCount() == 0) return;
+    queue.submitVertices(layer, view, &m_vertices[0], m_vertices.getVertexCount(), sf::Quads, m_texture);
+}
@@ -0,0 +1,98 @@
+#ifndef ENTITYBATCH_H
+#define ENTITYBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include "RenderQueue.h"
+
+/**
+ * @brief Collects axis-aligned entity quads into a single vertex stream.
+ *
+ * Players and bullets are written into one shared sf::VertexArray every frame
+ * and submitted with a single draw call. Each entity kind has its own size and
+ * colour so callers only provide a position.
+ */
+class EntityBatch {
+public:
+    /**
+     * @brief Entity kinds that share the batch.
+     */
+    enum class Kind {
+        Player, ///< Player cube.
+        Bullet, ///< Bullet projectile.
+        Count
+    };
+
+    /**
+     * @brief Per-kind appearance used when appending quads.
+     */
+    struct KindStyle {
+        sf::Vector2f size;     ///< Quad dimensions.
+        sf::Color color;       ///< Fill colour.
+        sf::FloatRect texRect; ///< Atlas rectangle (pixels); ignored without a texture.
+    };
+
+    EntityBatch();
+
+    /**
+     * @brief Starts a new frame, discarding previous quads but keeping capacity.
+     */
+    void begin();
+
+    /**
+     * @brief Appends a quad using the style registered for the given kind.
+     * @param kind Entity kind.
+     * @param x Left position in world space.
+     * @param y Top position in world space.
+     */
+    void add(Kind kind, float x, float y);
+
+    /**
+     * @brief Appends a quad with an explicit size and colour.
+     * @param x Left position in world space.
+     * @param y Top position in world space.
+     * @param size Quad dimensions.
+     * @param color Fill colour.
+     * @param texRect Atlas rectangle (pixels); ignored without a texture.
+     */
+    void add(float x, float y, const sf::Vector2f& size, const sf::Color& color,
+             const sf::FloatRect& texRect = sf::FloatRect());
+
+    /**
+     * @brief Submits every quad appended since begin() in one draw call.
+     * @param target Render target to draw to.
+     * @return Number of draw calls issued (0 if the batch is empty).
+     */
+    unsigned int draw(sf::RenderTarget& target) const;
+
+    /**
+     * @brief Queues every quad appended since begin() as one vertex command.
+     * @param queue Render queue for this frame.
+     * @param layer Draw layer.
+     * @param view View id from RenderQueue::registerView().
+     */
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view) const;
+
+    /**
+     * @brief Overrides the style used for an entity kind.
+     * @param kind Entity kind.
+     * @param style New size and colour.
+     */
+    void setStyle(Kind kind, const KindStyle& style);
+
+    /**
+     * @brief Sets the atlas texture every quad samples from (nullptr for flat colour).
+     */
+    void setTexture(const sf::Texture* texture) { m_texture = texture; }
+
+    /// Number of quads currently in the batch.
+    std::size_t getQuadCount() const { return m_vertices.getVertexCount() / 4; }
+
+private:
+    sf::VertexArray m_vertices; ///< Quad vertices for the current frame.
+    const sf::Texture* m_texture = nullptr; ///< Shared atlas texture.
+    std::array<KindStyle, static_cast<std::size_t>(Kind::Count)> m_styles; ///< Style per kind.
+};
+
+#endif // ENTITYBATCH_H
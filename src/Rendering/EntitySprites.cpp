@@ -0,0 +1,84 @@
+#include "EntitySprites.h"
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+const unsigned int SPRITE_SIZE = 32;
+
+// Builds a square mask image; shade(u, v) returns brightness in [0, 1] for u, v in [-1, 1].
+sf::Image makeSprite(unsigned int size, const std::function<float(float, float)>& shade, bool roundAlpha = false) {
+    sf::Image image;
+    image.create(size, size, sf::Color::Transparent);
+    for (unsigned int py = 0; py < size; ++py) {
+        for (unsigned int px = 0; px < size; ++px) {
+            float u = (px + 0.5f) / size * 2.f - 1.f;
+            float v = (py + 0.5f) / size * 2.f - 1.f;
+            float b = std::max(0.f, std::min(1.f, shade(u, v)));
+            sf::Uint8 level = static_cast<sf::Uint8>(b * 255.f);
+            sf::Uint8 alpha = 255;
+            if (roundAlpha) {
+                float r = std::sqrt(u * u + v * v);
+                alpha = static_cast<sf::Uint8>(255.f * std::max(0.f, 1.f - r));
+            }
+            image.setPixel(px, py, sf::Color(level, level, level, alpha));
+        }
+    }
+    return image;
+}
+
+// Bright face with a darker bevel, shared by all cube-like sprites.
+float bevel(float u, float v) {
+    float edge = std::max(std::abs(u), std::abs(v));
+    return edge > 0.85f ? 0.6f : 1.f;
+}
+
+} // namespace
+
+EntitySprites buildEntitySprites(TextureAtlas& atlas) {
+    using Region = TextureAtlas::RegionId;
+    const unsigned int s = SPRITE_SIZE;
+
+    Region player = atlas.add("player", makeSprite(s, [](float u, float v) {
+        return bevel(u, v) * (std::abs(u) < 0.2f && std::abs(v) < 0.2f ? 0.8f : 1.f);
+    }));
+    Region bullet = atlas.add("bullet", makeSprite(8, [](float u, float v) { return 1.f - 0.3f * (u * u + v * v); }));
+    Region particle = atlas.add("particle", makeSprite(8, [](float, float) { return 1.f; }, true));
+    Region white = atlas.add("white", makeSprite(4, [](float, float) { return 1.f; }));
+
+    std::array<Region, ENEMY_TYPE_COUNT> enemies;
+    enemies[Enemy::Swarmlet] = atlas.add("enemy_swarmlet", makeSprite(s, [](float u, float v) {
+        return bevel(u, v) * ((u * u + v * v) < 0.1f ? 0.7f : 1.f);
+    }));
+    enemies[Enemy::Sniper] = atlas.add("enemy_sniper", makeSprite(s, [](float u, float v) {
+        return bevel(u, v) * ((std::abs(u) < 0.08f || std::abs(v) < 0.08f) ? 0.6f : 1.f);
+    }));
+    enemies[Enemy::Bomber] = atlas.add("enemy_bomber", makeSprite(s, [](float u, float v) {
+        float r = std::sqrt(u * u + v * v);
+        return bevel(u, v) * (std::abs(r - 0.5f) < 0.1f ? 0.6f : 1.f);
+    }));
+    enemies[Enemy::Brute] = atlas.add("enemy_brute", makeSprite(s, [](float u, float v) {
+        return std::max(std::abs(u), std::abs(v)) > 0.7f ? 0.55f : 1.f;
+    }));
+    enemies[Enemy::GravityWell] = atlas.add("enemy_gravitywell", makeSprite(s, [](float u, float v) {
+        float r = std::sqrt(u * u + v * v);
+        return bevel(u, v) * (0.7f + 0.3f * std::cos(r * 12.f));
+    }));
+    enemies[Enemy::Default] = atlas.add("enemy_default", makeSprite(s, bevel));
+    enemies[Enemy::Splitter] = atlas.add("enemy_splitter", makeSprite(s, [](float u, float v) {
+        return bevel(u, v) * (std::abs(u - v) < 0.1f ? 0.6f : 1.f);
+    }));
+
+    EntitySprites sprites;
+    if (!atlas.build()) return sprites;
+
+    sprites.texture = &atlas.getTexture();
+    sprites.player = atlas.getTexRect(player);
+    sprites.bullet = atlas.getTexRect(bullet);
+    sprites.particle = atlas.getTexRect(particle);
+    sprites.white = atlas.getTexRect(white);
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+        sprites.enemies[i] = atlas.getTexRect(enemies[i]);
+    return sprites;
+}
@@ -0,0 +1,38 @@
+#ifndef ENTITYSPRITES_H
+#define ENTITYSPRITES_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include "TextureAtlas.h"
+#include "../Entities/Enemy.h"
+
+/**
+ * @brief Atlas texture rectangles for every entity visual.
+ *
+ * Sprites are generated procedurally as white/grey masks so the per-entity
+ * vertex colour still decides the hue. With no atlas (texture == nullptr) the
+ * rectangles are ignored and quads draw as flat colour, as before.
+ */
+struct EntitySprites {
+    const sf::Texture* texture = nullptr; ///< Atlas texture shared by all entity quads.
+    sf::FloatRect player;                 ///< Player cube.
+    sf::FloatRect bullet;                 ///< Bullet.
+    sf::FloatRect particle;               ///< Soft particle dot.
+    sf::FloatRect white;                  ///< Solid white block for untextured geometry (grid lines).
+    std::array<sf::FloatRect, ENEMY_TYPE_COUNT> enemies; ///< One per Enemy::Type.
+
+    /// Texture rectangle for an enemy type.
+    const sf::FloatRect& forEnemy(Enemy::Type type) const { return enemies[static_cast<std::size_t>(type)]; }
+
+    /// Centre of the white block, for primitives that need a single texel.
+    sf::Vector2f whiteTexel() const { return sf::Vector2f(white.left + white.width * 0.5f, white.top + white.height * 0.5f); }
+};
+
+/**
+ * @brief Generates the entity sprites, packs them into an atlas and resolves their rectangles.
+ * @param atlas Empty atlas to fill and build.
+ * @return Resolved sprite set (texture is nullptr if the build failed).
+ */
+EntitySprites buildEntitySprites(TextureAtlas& atlas);
+
+#endif // ENTITYSPRITES_H
@@ -0,0 +1,78 @@
+#include "GridBackground.h"
+#include <cmath>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+GridBackground::GridBackground(float cellSize, const sf::Color& color)
+    : m_cellSize(cellSize),
+      m_color(color),
+      m_lines(sf::Lines),
+      m_builtFor(0.f, 0.f)
+{
+}
+
+void GridBackground::setCellSize(float cellSize) {
+    if (cellSize <= 0.f || cellSize == m_cellSize) return;
+    m_cellSize = cellSize;
+    m_builtFor = sf::Vector2f(0.f, 0.f); // Force a rebuild.
+}
+
+void GridBackground::setTexture(const sf::Texture* texture, const sf::Vector2f& texel) {
+    m_texture = texture;
+    m_texel = texel;
+    m_builtFor = sf::Vector2f(0.f, 0.f); // Force a rebuild with the new texel.
+}
+
+//-------------------------------------------------------------------------
+// Geometry
+//-------------------------------------------------------------------------
+void GridBackground::rebuild(const sf::Vector2f& viewSize) {
+    // One extra cell on each side so snapping never exposes an edge.
+    int cols = static_cast<int>(std::ceil(viewSize.x / m_cellSize)) + 2;
+    int rows = static_cast<int>(std::ceil(viewSize.y / m_cellSize)) + 2;
+    float width = cols * m_cellSize;
+    float height = rows * m_cellSize;
+
+    m_lines.clear();
+    for (int x = 0; x <= cols; ++x) {
+        float lineX = x * m_cellSize;
+        m_lines.append(sf::Vertex(sf::Vector2f(lineX, 0.f), m_color, m_texel));
+        m_lines.append(sf::Vertex(sf::Vector2f(lineX, height), m_color, m_texel));
+    }
+    for (int y = 0; y <= rows; ++y) {
+        float lineY = y * m_cellSize;
+        m_lines.append(sf::Vertex(sf::Vector2f(0.f, lineY), m_color, m_texel));
+        m_lines.append(sf::Vertex(sf::Vector2f(width, lineY), m_color, m_texel));
+    }
+
+    m_builtFor = viewSize;
+    ++m_rebuildCount;
+}
+
+//-------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------
+sf::RenderStates GridBackground::prepare(const sf::View& view) {
+    const sf::Vector2f viewSize = view.getSize();
+    if (viewSize != m_builtFor)
+        rebuild(viewSize);
+
+    // Snap the cached grid to the cell containing the view's top-left corner.
+    sf::Vector2f topLeft = view.getCenter() - viewSize * 0.5f;
+    float originX = (std::floor(topLeft.x / m_cellSize) - 1.f) * m_cellSize;
+    float originY = (std::floor(topLeft.y / m_cellSize) - 1.f) * m_cellSize;
+
+    sf::RenderStates states(m_texture);
+    states.transform.translate(originX, originY);
+    return states;
+}
+
+unsigned int GridBackground::draw(sf::RenderTarget& target, const sf::View& view) {
+    target.draw(m_lines, prepare(view));
+    return 1;
+}
+
+void GridBackground::submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId viewId, const sf::View& view) {
+    queue.submitDrawable(layer, viewId, m_lines, m_texture, prepare(view));
+}
@@ -0,0 +1,70 @@
+#ifndef GRIDBACKGROUND_H
+#define GRIDBACKGROUND_H
+
+#include <SFML/Graphics.hpp>
+#include "RenderQueue.h"
+
+/**
+ * @brief Cached background grid that follows the camera.
+ *
+ * The line geometry is built once for an area one cell larger than the view
+ * on every side, then translated by whole cells as the camera moves. It is only
+ * rebuilt when the view size changes (window resize or zoom), so the per-frame
+ * cost is a single draw of a pre-built vertex array at any zoom level.
+ */
+class GridBackground {
+public:
+    /**
+     * @brief Constructor.
+     * @param cellSize Size of one grid cell in world units.
+     * @param color Line colour.
+     */
+    explicit GridBackground(float cellSize = 50.f, const sf::Color& color = sf::Color(50, 50, 50));
+
+    /**
+     * @brief Draws the grid covering the given view.
+     * @param target Render target to draw to.
+     * @param view View whose visible area must be covered.
+     * @return Number of draw calls issued.
+     */
+    unsigned int draw(sf::RenderTarget& target, const sf::View& view);
+
+    /**
+     * @brief Queues the grid covering the given view. The grid must outlive the flush.
+     * @param queue Render queue for this frame.
+     * @param layer Draw layer.
+     * @param viewId Id of the view in the queue.
+     * @param view View whose visible area must be covered.
+     */
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId viewId, const sf::View& view);
+
+    /**
+     * @brief Changes the cell size; the grid is rebuilt on the next draw.
+     * @param cellSize Size of one grid cell in world units.
+     */
+    void setCellSize(float cellSize);
+
+    /**
+     * @brief Samples a single texel of a shared texture so the grid can join the world atlas bind.
+     * @param texture Atlas texture, or nullptr for flat lines.
+     * @param texel Pixel coordinate of an opaque white texel.
+     */
+    void setTexture(const sf::Texture* texture, const sf::Vector2f& texel);
+
+    /// Number of times the geometry has been rebuilt (for diagnostics).
+    unsigned int getRebuildCount() const { return m_rebuildCount; }
+
+private:
+    void rebuild(const sf::Vector2f& viewSize);
+    sf::RenderStates prepare(const sf::View& view);
+
+    float m_cellSize;          ///< Size of one grid cell.
+    sf::Color m_color;         ///< Line colour.
+    sf::VertexArray m_lines;   ///< Cached line geometry anchored at (0, 0).
+    sf::Vector2f m_builtFor;   ///< View size the geometry was built for.
+    const sf::Texture* m_texture = nullptr; ///< Optional shared texture.
+    sf::Vector2f m_texel;      ///< White texel sampled by every line vertex.
+    unsigned int m_rebuildCount = 0;
+};
+
+#endif // GRIDBACKGROUND_H
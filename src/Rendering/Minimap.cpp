@@ -0,0 +1,102 @@
+#include "Minimap.h"
+#include <algorithm>
+#include <cmath>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+Minimap::Minimap(unsigned int resolution, float screenSize, float updateInterval)
+    : m_resolution(resolution),
+      m_screenSize(screenSize),
+      m_updateInterval(updateInterval),
+      m_timer(updateInterval), // Generate on the first update.
+      m_pixels(static_cast<std::size_t>(resolution) * resolution * 4, 0)
+{
+}
+
+//-------------------------------------------------------------------------
+// Pixel Generation
+//-------------------------------------------------------------------------
+void Minimap::setPixel(int x, int y, const sf::Color& color) {
+    if (x < 0 || y < 0 || x >= static_cast<int>(m_resolution) || y >= static_cast<int>(m_resolution)) return;
+    sf::Uint8* p = &m_pixels[(static_cast<std::size_t>(y) * m_resolution + x) * 4];
+    p[0] = color.r;
+    p[1] = color.g;
+    p[2] = color.b;
+    p[3] = color.a;
+}
+
+bool Minimap::update(float dt, const EntityManager& entities, const sf::Vector2f& center, const sf::Vector2f& localPlayer) {
+    m_timer += dt;
+    if (m_timer < m_updateInterval) return false;
+    m_timer = 0.f;
+
+    const int half = static_cast<int>(m_resolution / 2);
+    const int originX = EntityManager::cellCoord(center.x) - half;
+    const int originY = EntityManager::cellCoord(center.y) - half;
+
+    // Density heat map: transparent background, red intensity grows with count.
+    const std::size_t saturation = 8;
+    for (int y = 0; y < static_cast<int>(m_resolution); ++y) {
+        for (int x = 0; x < static_cast<int>(m_resolution); ++x) {
+            std::size_t count = entities.enemyCountInCell(originX + x, originY + y);
+            if (count == 0) {
+                setPixel(x, y, sf::Color(20, 20, 20, 160));
+            } else {
+                float heat = std::min(1.f, static_cast<float>(count) / saturation);
+                setPixel(x, y, sf::Color(static_cast<sf::Uint8>(120 + 135 * heat),
+                                         static_cast<sf::Uint8>(60 * (1.f - heat)), 0, 230));
+            }
+        }
+    }
+
+    // Players are few; mark their cells directly.
+    for (const auto& [id, player] : entities.getPlayers()) {
+        if (!player.isAlive || std::isnan(player.x) || std::isnan(player.y)) continue;
+        setPixel(EntityManager::cellCoord(player.x) - originX, EntityManager::cellCoord(player.y) - originY,
+                 sf::Color(80, 140, 255));
+    }
+    setPixel(EntityManager::cellCoord(localPlayer.x) - originX, EntityManager::cellCoord(localPlayer.y) - originY,
+             sf::Color::White);
+
+    m_dirty = true;
+    return true;
+}
+
+void Minimap::setPixels(const std::vector<sf::Uint8>& pixels) {
+    if (pixels.size() != m_pixels.size() || pixels == m_pixels) return;
+    m_pixels = pixels;
+    m_dirty = true;
+}
+
+//-------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------
+void Minimap::submit(RenderQueue& queue, RenderQueue::ViewId screenView, const sf::Vector2u& windowSize) {
+    if (m_texture.getSize().x != m_resolution) {
+        if (!m_texture.create(m_resolution, m_resolution)) return;
+        m_dirty = true;
+    }
+    if (m_dirty) {
+        m_texture.update(m_pixels.data());
+        m_dirty = false;
+        ++m_uploadCount;
+    }
+
+    const float margin = 10.f;
+    const float left = windowSize.x - m_screenSize - margin;
+    const float top = windowSize.y - m_screenSize - margin;
+    const float res = static_cast<float>(m_resolution);
+
+    queue.submitRect(RenderQueue::Layer::ScreenUI, screenView,
+                     sf::FloatRect(left - 2.f, top - 2.f, m_screenSize + 4.f, m_screenSize + 4.f),
+                     sf::Color(200, 200, 200, 180));
+
+    const sf::Vertex quad[4] = {
+        sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0.f, 0.f)),
+        sf::Vertex(sf::Vector2f(left + m_screenSize, top), sf::Vector2f(res, 0.f)),
+        sf::Vertex(sf::Vector2f(left + m_screenSize, top + m_screenSize), sf::Vector2f(res, res)),
+        sf::Vertex(sf::Vector2f(left, top + m_screenSize), sf::Vector2f(0.f, res))
+    };
+    queue.submitVertices(RenderQueue::Layer::ScreenUI, screenView, quad, 4, sf::Quads, &m_texture);
+}
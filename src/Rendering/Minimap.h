@@ -0,0 +1,70 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "RenderQueue.h"
+#include "../Entities/EntityManager.h"
+
+/**
+ * @brief Enemy density minimap generated from the collision grid.
+ *
+ * Each pixel is one collision cell around the camera, shaded by the number of
+ * enemies in it, so regeneration costs resolution^2 grid lookups however many
+ * enemies exist. Pixels are regenerated at a reduced rate into a small CPU
+ * buffer, uploaded to a texture only when they change, and drawn as a single
+ * screen-space quad.
+ */
+class Minimap {
+public:
+    /**
+     * @brief Constructor.
+     * @param resolution Cells (pixels) per side.
+     * @param screenSize Drawn edge length in screen pixels.
+     * @param updateInterval Seconds between regenerations.
+     */
+    explicit Minimap(unsigned int resolution = 48, float screenSize = 160.f, float updateInterval = 0.2f);
+
+    /**
+     * @brief Regenerates the pixels if the update interval has elapsed.
+     * @param dt Time step in seconds.
+     * @param entities Entity manager providing the grid and players.
+     * @param center World position the map is centred on.
+     * @param localPlayer Local player's world position (highlighted).
+     * @return True if the pixels changed.
+     */
+    bool update(float dt, const EntityManager& entities, const sf::Vector2f& center, const sf::Vector2f& localPlayer);
+
+    /**
+     * @brief Replaces the pixels wholesale (render-thread copy of a simulation minimap).
+     * @param pixels RGBA8 pixels, resolution^2 * 4 bytes.
+     */
+    void setPixels(const std::vector<sf::Uint8>& pixels);
+
+    /**
+     * @brief Uploads pending pixels and queues the map quad plus its frame.
+     * @param queue Render queue for this frame.
+     * @param screenView Id of the window's default view in the queue.
+     * @param windowSize Window size, used to anchor the map bottom-right.
+     */
+    void submit(RenderQueue& queue, RenderQueue::ViewId screenView, const sf::Vector2u& windowSize);
+
+    const std::vector<sf::Uint8>& getPixels() const { return m_pixels; } ///< RGBA8 pixel buffer.
+    unsigned int getResolution() const { return m_resolution; }
+    unsigned int getUploadCount() const { return m_uploadCount; }        ///< Texture uploads so far.
+
+private:
+    void setPixel(int x, int y, const sf::Color& color);
+
+    unsigned int m_resolution;
+    float m_screenSize;
+    float m_updateInterval;
+    float m_timer = 0.f;
+
+    std::vector<sf::Uint8> m_pixels; ///< CPU copy, resolution x resolution RGBA.
+    sf::Texture m_texture;           ///< Created lazily on the drawing thread.
+    bool m_dirty = true;
+    unsigned int m_uploadCount = 0;
+};
+
+#endif // MINIMAP_H
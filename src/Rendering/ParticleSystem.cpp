@@ -0,0 +1,144 @@
+#include "ParticleSystem.h"
+#include "../Utils/FastHash.h"
+#include <algorithm>
+#include <cmath>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : m_capacity(capacity),
+      m_x(capacity), m_y(capacity),
+      m_vx(capacity), m_vy(capacity),
+      m_life(capacity), m_invMaxLife(capacity),
+      m_size(capacity),
+      m_drag(capacity),
+      m_color(capacity)
+{
+    m_vertices.reserve(capacity * 4);
+
+    //                                                 count  speed         life        size  drag
+    m_presets[static_cast<std::size_t>(ParticleEffect::Hit)]   = {  6,  60.f, 160.f, 0.15f, 0.35f, 3.f, 0.05f };
+    m_presets[static_cast<std::size_t>(ParticleEffect::Split)] = { 16,  40.f, 120.f, 0.30f, 0.60f, 4.f, 0.20f };
+    m_presets[static_cast<std::size_t>(ParticleEffect::Death)] = { 24,  80.f, 260.f, 0.40f, 0.90f, 4.f, 0.10f };
+}
+
+void ParticleSystem::setPreset(ParticleEffect effect, const EmitterPreset& preset) {
+    m_presets[static_cast<std::size_t>(effect)] = preset;
+}
+
+void ParticleSystem::setTexture(const sf::Texture* texture, const sf::FloatRect& texRect) {
+    m_texture = texture;
+    m_texRect = texRect;
+}
+
+float ParticleSystem::nextRandom() {
+    return static_cast<float>(hash32(m_randomState++) >> 8) * (1.0f / 16777216.0f);
+}
+
+//-------------------------------------------------------------------------
+// Emission
+//-------------------------------------------------------------------------
+unsigned int ParticleSystem::emit(ParticleEffect effect, const sf::Vector2f& position, const sf::Color& color) {
+    const EmitterPreset& preset = m_presets[static_cast<std::size_t>(effect)];
+
+    // Past 50% occupancy, scale each emission down linearly so bursts thin out
+    // instead of starving later effects; the hard cap catches the rest.
+    float occupancy = static_cast<float>(m_count) / static_cast<float>(m_capacity);
+    float scale = occupancy <= 0.5f ? 1.f : std::max(0.f, (1.f - occupancy) * 2.f);
+    unsigned int wanted = static_cast<unsigned int>(std::ceil(preset.count * scale));
+    unsigned int available = static_cast<unsigned int>(m_capacity - m_count);
+    unsigned int emitted = std::min(wanted, available);
+    m_dropped += preset.count - emitted;
+
+    const float twoPi = 6.2831853f;
+    for (unsigned int n = 0; n < emitted; ++n) {
+        std::size_t i = m_count++;
+        float angle = nextRandom() * twoPi;
+        float speed = preset.speedMin + (preset.speedMax - preset.speedMin) * nextRandom();
+        float life = preset.lifeMin + (preset.lifeMax - preset.lifeMin) * nextRandom();
+        m_x[i] = position.x;
+        m_y[i] = position.y;
+        m_vx[i] = std::cos(angle) * speed;
+        m_vy[i] = std::sin(angle) * speed;
+        m_life[i] = life;
+        m_invMaxLife[i] = 1.f / life;
+        m_size[i] = preset.size;
+        m_drag[i] = preset.drag;
+        m_color[i] = color;
+    }
+    return emitted;
+}
+
+//-------------------------------------------------------------------------
+// Simulation
+//-------------------------------------------------------------------------
+void ParticleSystem::update(float dt) {
+    const std::size_t n = m_count;
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* life = m_life.data();
+    const float* drag = m_drag.data();
+
+    // Branch-free integration over contiguous floats (vectorisable). Drag is
+    // linearised (1 - (1 - keep) * dt), which is accurate at fixed 60 Hz steps.
+    for (std::size_t i = 0; i < n; ++i) {
+        float damping = 1.f - (1.f - drag[i]) * dt;
+        vx[i] *= damping;
+        vy[i] *= damping;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+    }
+
+    // Retire dead particles by moving the last live one into their slot.
+    std::size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0.f) {
+            ++i;
+            continue;
+        }
+        std::size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_life[i] = m_life[last];
+        m_invMaxLife[i] = m_invMaxLife[last];
+        m_size[i] = m_size[last];
+        m_drag[i] = m_drag[last];
+        m_color[i] = m_color[last];
+    }
+}
+
+//-------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------
+void ParticleSystem::buildVertices(const sf::FloatRect& cullRect, std::vector<sf::Vertex>& out) const {
+    const float right = cullRect.left + cullRect.width;
+    const float bottom = cullRect.top + cullRect.height;
+    const float u0 = m_texRect.left, v0 = m_texRect.top;
+    const float u1 = m_texRect.left + m_texRect.width, v1 = m_texRect.top + m_texRect.height;
+    for (std::size_t i = 0; i < m_count; ++i) {
+        float px = m_x[i], py = m_y[i];
+        if (px < cullRect.left || px > right || py < cullRect.top || py > bottom)
+            continue;
+
+        float half = m_size[i] * 0.5f;
+        sf::Color c = m_color[i];
+        c.a = static_cast<sf::Uint8>(255.f * std::min(1.f, m_life[i] * m_invMaxLife[i]));
+        out.emplace_back(sf::Vector2f(px - half, py - half), c, sf::Vector2f(u0, v0));
+        out.emplace_back(sf::Vector2f(px + half, py - half), c, sf::Vector2f(u1, v0));
+        out.emplace_back(sf::Vector2f(px + half, py + half), c, sf::Vector2f(u1, v1));
+        out.emplace_back(sf::Vector2f(px - half, py + half), c, sf::Vector2f(u0, v1));
+    }
+}
+
+void ParticleSystem::submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view, const sf::FloatRect& cullRect) {
+    m_vertices.clear();
+    buildVertices(cullRect, m_vertices);
+    if (!m_vertices.empty())
+        queue.submitVertices(layer, view, m_vertices.data(), m_vertices.size(), sf::Quads, m_texture);
+}
@@ -0,0 +1,126 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "RenderQueue.h"
+
+/**
+ * @brief Visual effects that can be spawned by the particle system.
+ */
+enum class ParticleEffect {
+    Hit,   ///< Bullet hit an enemy.
+    Split, ///< Splitter enemy divided.
+    Death, ///< Enemy was killed or removed.
+    Count
+};
+
+/**
+ * @brief Fixed-capacity particle pool with structure-of-arrays storage.
+ *
+ * All storage is allocated once in the constructor; emitting and updating never
+ * allocate. Positions, velocities and lifetimes live in separate arrays so the
+ * integration loop is a straight run over floats the compiler can vectorise.
+ * Dead particles are removed by swapping in the last live one.
+ *
+ * When the pool fills up, emitters are scaled down progressively and excess
+ * particles are dropped, so a burst (e.g. a whole wave dying at once) costs at
+ * most one pool's worth of work and still draws as a single vertex array.
+ */
+class ParticleSystem {
+public:
+    /**
+     * @brief Emission parameters for one effect type.
+     */
+    struct EmitterPreset {
+        unsigned int count;   ///< Particles per emission at low load.
+        float speedMin;       ///< Minimum initial speed (units/s).
+        float speedMax;       ///< Maximum initial speed (units/s).
+        float lifeMin;        ///< Minimum lifetime (s).
+        float lifeMax;        ///< Maximum lifetime (s).
+        float size;           ///< Quad edge length.
+        float drag;           ///< Fraction of velocity kept per second (0..1).
+    };
+
+    /**
+     * @brief Constructor.
+     * @param capacity Maximum number of live particles.
+     */
+    explicit ParticleSystem(std::size_t capacity = 8192);
+
+    /**
+     * @brief Spawns an effect centred at a world position.
+     * @param effect Effect preset to use.
+     * @param position World-space centre.
+     * @param color Base particle colour.
+     * @return Number of particles actually emitted.
+     */
+    unsigned int emit(ParticleEffect effect, const sf::Vector2f& position, const sf::Color& color);
+
+    /**
+     * @brief Advances and retires particles.
+     * @param dt Time step in seconds.
+     */
+    void update(float dt);
+
+    /**
+     * @brief Writes quads for the live particles that intersect a rectangle.
+     * @param cullRect World-space rectangle (usually the view plus a margin).
+     * @param out Destination vertex list (appended to).
+     */
+    void buildVertices(const sf::FloatRect& cullRect, std::vector<sf::Vertex>& out) const;
+
+    /**
+     * @brief Queues the visible particles as one vertex command.
+     * @param queue Render queue for this frame.
+     * @param layer Draw layer.
+     * @param view View id from RenderQueue::registerView().
+     * @param cullRect World-space rectangle used for culling.
+     */
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view, const sf::FloatRect& cullRect);
+
+    /**
+     * @brief Sets the atlas texture and the rectangle every particle samples.
+     * @param texture Atlas texture, or nullptr for flat squares.
+     * @param texRect Particle sprite rectangle in pixels.
+     */
+    void setTexture(const sf::Texture* texture, const sf::FloatRect& texRect);
+
+    /// Texture particles sample from (nullptr when flat-coloured).
+    const sf::Texture* getTexture() const { return m_texture; }
+
+    /// Replaces the preset for an effect.
+    void setPreset(ParticleEffect effect, const EmitterPreset& preset);
+
+    /// Removes every particle.
+    void clear() { m_count = 0; }
+
+    std::size_t getLiveCount() const { return m_count; }       ///< Live particles.
+    std::size_t getCapacity() const { return m_capacity; }     ///< Pool size.
+    unsigned long long getDropped() const { return m_dropped; } ///< Particles not emitted due to load.
+
+private:
+    float nextRandom(); ///< Deterministic [0, 1) sequence; no rand().
+
+    std::size_t m_capacity;
+    std::size_t m_count = 0;
+
+    // Structure-of-arrays particle state.
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_vx, m_vy;
+    std::vector<float> m_life, m_invMaxLife;
+    std::vector<float> m_size;
+    std::vector<float> m_drag;
+    std::vector<sf::Color> m_color;
+
+    std::array<EmitterPreset, static_cast<std::size_t>(ParticleEffect::Count)> m_presets;
+    std::vector<sf::Vertex> m_vertices; ///< Reused vertex storage for submit().
+    const sf::Texture* m_texture = nullptr; ///< Shared atlas texture.
+    sf::FloatRect m_texRect;                ///< Particle sprite in the atlas.
+    uint64_t m_randomState = 0;
+    unsigned long long m_dropped = 0;
+};
+
+#endif // PARTICLESYSTEM_H
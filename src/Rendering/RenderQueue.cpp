@@ -0,0 +1,169 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+//-------------------------------------------------------------------------
+// Frame Lifecycle
+//-------------------------------------------------------------------------
+void RenderQueue::begin() {
+    // clear() keeps capacity, so steady-state frames do not allocate.
+    m_commands.clear();
+    m_views.clear();
+    m_textures.clear();
+    m_states.clear();
+    m_vertices.clear();
+    m_runs.fill(0);
+    m_runKey.fill(0);
+}
+
+RenderQueue::ViewId RenderQueue::registerView(const sf::View& view) {
+    for (std::size_t i = 0; i < m_views.size(); ++i) {
+        const sf::View& v = m_views[i];
+        if (v.getCenter() == view.getCenter() && v.getSize() == view.getSize() &&
+            v.getRotation() == view.getRotation() && v.getViewport() == view.getViewport())
+            return static_cast<ViewId>(i);
+    }
+    m_views.push_back(view);
+    return static_cast<ViewId>(m_views.size() - 1);
+}
+
+//-------------------------------------------------------------------------
+// Command Submission
+//-------------------------------------------------------------------------
+uint64_t RenderQueue::makeKey(Layer layer, ViewId view, const sf::Texture* texture, bool drawable, sf::PrimitiveType type) {
+    uint64_t textureId = 0;
+    if (texture) {
+        auto it = std::find(m_textures.begin(), m_textures.end(), texture);
+        if (it == m_textures.end()) {
+            m_textures.push_back(texture);
+            it = m_textures.end() - 1;
+        }
+        textureId = static_cast<uint64_t>(it - m_textures.begin()) + 1;
+    }
+    const uint64_t key = (static_cast<uint64_t>(layer) << 56) |
+                         (static_cast<uint64_t>(view) << 32) |
+                         (textureId << 16) |
+                         (static_cast<uint64_t>(drawable ? 1 : 0) << 8) |
+                         static_cast<uint64_t>(type);
+    if (!isOrdered(layer)) return key;
+
+    // A new run starts whenever the state changes; the count saturates, after
+    // which later runs fall back to view/texture order.
+    const std::size_t l = static_cast<std::size_t>(layer);
+    if (m_runs[l] == 0 || key != m_runKey[l]) {
+        if (m_runs[l] < UINT16_MAX) ++m_runs[l];
+        m_runKey[l] = key;
+    }
+    return key | (static_cast<uint64_t>(m_runs[l]) << 40);
+}
+
+bool RenderQueue::isOrdered(Layer layer) {
+    return layer == Layer::UIBackground || layer == Layer::WorldUI || layer == Layer::ScreenUI;
+}
+
+void RenderQueue::submitVertices(Layer layer, ViewId view, const sf::Vertex* vertices, std::size_t count,
+                                 sf::PrimitiveType type, const sf::Texture* texture) {
+    if (count == 0) return;
+    Command cmd;
+    cmd.key = makeKey(layer, view, texture, false, type);
+    cmd.view = view;
+    cmd.type = type;
+    cmd.texture = texture;
+    cmd.first = m_vertices.size();
+    cmd.count = count;
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+    m_commands.push_back(cmd);
+}
+
+void RenderQueue::submitDrawable(Layer layer, ViewId view, const sf::Drawable& drawable,
+                                 const sf::Texture* texture, const sf::RenderStates& states,
+                                 std::size_t vertexCount) {
+    Command cmd;
+    cmd.key = makeKey(layer, view, texture, true, sf::Points);
+    cmd.view = view;
+    cmd.texture = texture;
+    cmd.drawable = &drawable;
+    cmd.count = vertexCount;
+    cmd.states = m_states.size();
+    m_states.push_back(states);
+    m_commands.push_back(cmd);
+}
+
+void RenderQueue::submitRect(Layer layer, ViewId view, const sf::FloatRect& rect, const sf::Color& color) {
+    const sf::Vertex quad[4] = {
+        sf::Vertex(sf::Vector2f(rect.left, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color),
+        sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color)
+    };
+    submitVertices(layer, view, quad, 4, sf::Quads);
+}
+
+bool RenderQueue::isMergeable(sf::PrimitiveType type) {
+    return type == sf::Points || type == sf::Lines || type == sf::Triangles || type == sf::Quads;
+}
+
+//-------------------------------------------------------------------------
+// Flush
+//-------------------------------------------------------------------------
+unsigned int RenderQueue::flush(RenderStats& target) {
+    m_drawCalls = 0;
+    m_viewSwitches = 0;
+    m_commandCount = m_commands.size();
+
+    std::stable_sort(m_commands.begin(), m_commands.end(),
+                     [](const Command& a, const Command& b) { return a.key < b.key; });
+
+    const sf::View originalView = target.getView();
+    int currentView = -1;
+    for (std::size_t i = 0; i < m_commands.size(); ++i) {
+        const Command& cmd = m_commands[i];
+        if (cmd.view != currentView) {
+            target.setView(m_views[cmd.view]);
+            currentView = cmd.view;
+            ++m_viewSwitches;
+        }
+
+        if (cmd.drawable) {
+            target.draw(*cmd.drawable, m_states[cmd.states]);
+            target.countVertices(cmd.count);
+            ++m_drawCalls;
+            continue;
+        }
+
+        sf::RenderStates states(cmd.texture);
+
+        // Extend the run while the next command shares the whole key.
+        std::size_t end = i + 1;
+        if (isMergeable(cmd.type)) {
+            while (end < m_commands.size() && m_commands[end].key == cmd.key)
+                ++end;
+        }
+
+        // Runs submitted back to back are already contiguous and need no copy.
+        bool contiguous = true;
+        std::size_t total = cmd.count;
+        for (std::size_t j = i + 1; j < end; ++j) {
+            contiguous = contiguous && m_commands[j].first == m_commands[j - 1].first + m_commands[j - 1].count;
+            total += m_commands[j].count;
+        }
+
+        if (contiguous) {
+            target.draw(&m_vertices[cmd.first], total, cmd.type, states);
+        } else {
+            m_merged.clear();
+            for (std::size_t j = i; j < end; ++j) {
+                const Command& part = m_commands[j];
+                m_merged.insert(m_merged.end(), m_vertices.begin() + part.first,
+                                m_vertices.begin() + part.first + part.count);
+            }
+            target.draw(m_merged.data(), m_merged.size(), cmd.type, states);
+        }
+        ++m_drawCalls;
+        i = end - 1;
+    }
+
+    // Leave the target as we found it so callers can keep using getView().
+    if (currentView != -1)
+        target.setView(originalView);
+    return m_drawCalls;
+}
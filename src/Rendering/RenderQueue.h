@@ -0,0 +1,137 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "RenderStats.h"
+
+/**
+ * @brief Per-frame queue of draw commands, sorted and merged before submission.
+ *
+ * States and the HUD submit commands tagged with a layer, a view, a texture and
+ * a primitive type instead of drawing directly. flush() orders commands by
+ * (layer, view, texture, primitive), so each view is set at most once per
+ * layer, and merges consecutive vertex commands that share all four into a
+ * single draw call.
+ *
+ * Layers are drawn in enum order and give painter's ordering. Within the
+ * world layers (Background, World, Effects) commands with different views or
+ * textures may be reordered, so overlapping content there must not depend on
+ * submission order; commands with the same key keep it. The UI layers
+ * (UIBackground, WorldUI, ScreenUI) keep full submission order: each run of
+ * commands sharing view, texture and primitive gets the next sequence number,
+ * placed above the view and texture in the key, so frames and the content
+ * drawn over them never swap. Runs still merge within themselves.
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief Draw layers, back to front.
+     */
+    enum class Layer : uint8_t {
+        Background, ///< Clear-colour decorations such as the grid.
+        World,      ///< Entities in world space.
+        Effects,    ///< World-space effects drawn over entities.
+        UIBackground, ///< UI panels and frames, above the world and behind UI text.
+        WorldUI,    ///< UI anchored to the game view.
+        ScreenUI,   ///< UI in screen (default view) coordinates.
+        Count
+    };
+
+    using ViewId = uint8_t;
+
+    /**
+     * @brief Starts a new frame, dropping all commands, views and textures.
+     */
+    void begin();
+
+    /**
+     * @brief Registers a view for this frame; identical views share an id.
+     * @param view View to draw commands with.
+     * @return Id to pass to submit calls.
+     */
+    ViewId registerView(const sf::View& view);
+
+    /**
+     * @brief Queues raw vertices. They are copied, so the source may be reused immediately.
+     * @param layer Draw layer.
+     * @param view View id from registerView().
+     * @param vertices First vertex.
+     * @param count Number of vertices.
+     * @param type Primitive type. Only list primitives (points, lines, triangles, quads) are merged.
+     * @param texture Texture to draw with, or nullptr.
+     */
+    void submitVertices(Layer layer, ViewId view, const sf::Vertex* vertices, std::size_t count,
+                        sf::PrimitiveType type, const sf::Texture* texture = nullptr);
+
+    /**
+     * @brief Queues a drawable. It is drawn as-is and must stay alive until flush().
+     * @param layer Draw layer.
+     * @param view View id from registerView().
+     * @param drawable Object to draw.
+     * @param texture Texture the drawable uses (sort key only), or nullptr.
+     * @param states Render states (e.g. transform) to draw with.
+     * @param vertexCount Vertices the drawable submits internally, for RenderStats
+     *                    (0 if it is a vertex array or buffer, which are counted directly).
+     */
+    void submitDrawable(Layer layer, ViewId view, const sf::Drawable& drawable,
+                        const sf::Texture* texture = nullptr,
+                        const sf::RenderStates& states = sf::RenderStates::Default,
+                        std::size_t vertexCount = 0);
+
+    /**
+     * @brief Queues a solid rectangle as a mergeable quad.
+     * @param layer Draw layer.
+     * @param view View id from registerView().
+     * @param rect Rectangle in the view's coordinates.
+     * @param color Fill colour.
+     */
+    void submitRect(Layer layer, ViewId view, const sf::FloatRect& rect, const sf::Color& color);
+
+    /**
+     * @brief Sorts, merges and draws every queued command.
+     * @param target Instrumented window to draw to. Its view is restored afterwards.
+     * @return Number of draw calls issued.
+     */
+    unsigned int flush(RenderStats& target);
+
+    unsigned int getDrawCalls() const { return m_drawCalls; }        ///< Draw calls in the last flush.
+    unsigned int getViewSwitches() const { return m_viewSwitches; }  ///< setView calls in the last flush.
+    std::size_t getCommandCount() const { return m_commandCount; }   ///< Commands in the last flush.
+    std::size_t getTextureCount() const { return m_textures.size(); } ///< Distinct textures queued this frame.
+
+private:
+    struct Command {
+        uint64_t key = 0;                     ///< Sort key: layer | run | view | texture | kind | primitive.
+        ViewId view = 0;
+        sf::PrimitiveType type = sf::Quads;
+        const sf::Texture* texture = nullptr;
+        const sf::Drawable* drawable = nullptr; ///< Set for drawable commands.
+        std::size_t states = 0;               ///< Index into m_states (drawables only).
+        std::size_t first = 0;                ///< First vertex in m_vertices (vertex commands).
+        std::size_t count = 0;                ///< Vertex count (vertex commands; reported count for drawables).
+    };
+
+    uint64_t makeKey(Layer layer, ViewId view, const sf::Texture* texture, bool drawable, sf::PrimitiveType type);
+    static bool isMergeable(sf::PrimitiveType type);
+    static bool isOrdered(Layer layer);   ///< True for layers that keep submission order.
+
+    std::vector<Command> m_commands;
+    std::vector<sf::View> m_views;
+    std::vector<const sf::Texture*> m_textures; ///< Per-frame texture -> small id.
+    std::vector<sf::RenderStates> m_states;
+    std::vector<sf::Vertex> m_vertices;         ///< Storage for all vertex commands.
+    std::vector<sf::Vertex> m_merged;           ///< Scratch for merged batches.
+
+    static constexpr std::size_t kLayerCount = static_cast<std::size_t>(Layer::Count);
+    std::array<uint16_t, kLayerCount> m_runs{};  ///< Submission runs so far, per ordered layer.
+    std::array<uint64_t, kLayerCount> m_runKey{}; ///< Key (without run) of each layer's last command.
+
+    unsigned int m_drawCalls = 0;
+    unsigned int m_viewSwitches = 0;
+    std::size_t m_commandCount = 0;
+};
+
+#endif // RENDERQUEUE_H
@@ -0,0 +1,76 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "../Entities/Enemy.h"
+
+/**
+ * @brief Immutable description of one simulation tick, as seen by the renderer.
+ *
+ * The simulation thread fills a snapshot at the end of each tick and publishes
+ * it; the render thread interpolates between the previous and current positions
+ * stored in it. Nothing in here references live game objects.
+ */
+struct RenderSnapshot {
+    /**
+     * @brief A coloured world-space quad with its previous and current position.
+     */
+    struct Quad {
+        sf::Vector2f prev;  ///< Top-left at the previous tick.
+        sf::Vector2f cur;   ///< Top-left at the current tick.
+        sf::Vector2f size;  ///< Dimensions.
+        sf::Color color;    ///< Fill colour.
+        sf::FloatRect texRect; ///< Atlas rectangle (pixels).
+    };
+
+    /**
+     * @brief An enemy quad; the id keeps its slot in the render thread's EnemyRenderBuffer.
+     */
+    struct EnemyQuad {
+        uint64_t id = 0;
+        sf::Vector2f prev;  ///< Top-left at the previous tick (shake included).
+        sf::Vector2f cur;   ///< Top-left at the current tick (shake included).
+        sf::Vector2f size;
+        sf::Color color;
+        Enemy::Type type = Enemy::Default;
+    };
+
+    /**
+     * @brief A HUD string with its layout and colour.
+     */
+    struct Text {
+        std::string content;    ///< String to draw.
+        unsigned int size = 16; ///< Character size.
+        sf::Vector2f pos;       ///< Position (relative to the view's top-left if viewSpace).
+        sf::Color color;        ///< Fill colour.
+        bool viewSpace = false; ///< True for ViewSpace elements, false for ScreenSpace.
+    };
+
+    bool valid = false;            ///< False until the first publish.
+    sf::Time publishTime;          ///< Render-thread clock time at publish.
+    sf::Color clearColor = sf::Color::Black;
+
+    sf::View view;                 ///< Game view (size and viewport).
+    sf::Vector2f cameraPrev;       ///< Camera centre at the previous tick.
+    sf::Vector2f cameraCur;        ///< Camera centre at the current tick.
+    float gridCellSize = 50.f;     ///< Background grid cell size (0 disables the grid).
+
+    std::vector<EnemyQuad> enemies; ///< Visible enemies.
+    std::vector<Quad> entities;    ///< Visible players and bullets.
+    std::vector<sf::Vertex> effects; ///< Visible particle quads (not interpolated).
+    std::vector<Text> texts;       ///< Visible HUD strings.
+    std::vector<sf::Uint8> minimapPixels; ///< Minimap RGBA pixels (empty hides the map).
+
+    /// Empties all lists while keeping their capacity.
+    void clear() {
+        enemies.clear();
+        entities.clear();
+        effects.clear();
+        texts.clear();
+        minimapPixels.clear();
+    }
+};
+
+#endif // RENDERSNAPSHOT_H
@@ -0,0 +1,134 @@
+#include "RenderStats.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+RenderStats::RenderStats(sf::RenderWindow& window)
+    : m_window(window)
+{
+    m_recent.reserve(FRAME_WINDOW);
+}
+
+void RenderStats::setLogging(bool enabled, float intervalSeconds) {
+    m_logging = enabled;
+    m_logInterval = intervalSeconds;
+    m_logClock.restart();
+}
+
+//-------------------------------------------------------------------------
+// Instrumented Window Calls
+//-------------------------------------------------------------------------
+void RenderStats::beginFrame() {
+    m_current = FrameStats();
+    m_current.frameMs = m_frameStarted ? m_frameClock.getElapsedTime().asSeconds() * 1000.f : 0.f;
+    m_frameClock.restart();
+    m_frameStarted = true;
+    m_submitClock.restart();
+}
+
+void RenderStats::clear(const sf::Color& color) {
+    m_window.clear(color);
+}
+
+void RenderStats::setView(const sf::View& view) {
+    m_window.setView(view);
+    ++m_current.viewSwitches;
+}
+
+void RenderStats::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+    m_window.draw(drawable, states);
+    ++m_current.drawCalls;
+    if (dynamic_cast<const sf::Text*>(&drawable))
+        ++m_current.texts;
+    else if (const sf::VertexArray* array = dynamic_cast<const sf::VertexArray*>(&drawable))
+        m_current.vertices += static_cast<unsigned int>(array->getVertexCount());
+    else if (const sf::VertexBuffer* buffer = dynamic_cast<const sf::VertexBuffer*>(&drawable))
+        m_current.vertices += static_cast<unsigned int>(buffer->getVertexCount());
+}
+
+void RenderStats::draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states) {
+    m_window.draw(vertices, count, type, states);
+    ++m_current.drawCalls;
+    m_current.vertices += static_cast<unsigned int>(count);
+}
+
+void RenderStats::display() {
+    m_current.submitMs = m_submitClock.getElapsedTime().asSeconds() * 1000.f;
+    sf::Clock displayClock;
+    m_window.display();
+    m_current.displayMs = displayClock.getElapsedTime().asSeconds() * 1000.f;
+
+    m_last = m_current;
+    if (m_recent.size() < FRAME_WINDOW) {
+        m_recent.push_back(m_current);
+    } else {
+        m_recent[m_recentNext] = m_current;
+        m_recentNext = (m_recentNext + 1) % FRAME_WINDOW;
+    }
+    if (m_session.size() < MAX_SESSION_FRAMES)
+        m_session.push_back(m_current);
+
+    if (m_logging && m_logClock.getElapsedTime().asSeconds() >= m_logInterval) {
+        logSummary();
+        m_logClock.restart();
+    }
+}
+
+//-------------------------------------------------------------------------
+// Results
+//-------------------------------------------------------------------------
+double RenderStats::value(const FrameStats& f, Metric metric) {
+    switch (metric) {
+        case Metric::DrawCalls:    return f.drawCalls;
+        case Metric::Vertices:     return f.vertices;
+        case Metric::ViewSwitches: return f.viewSwitches;
+        case Metric::Texts:        return f.texts;
+        case Metric::SubmitMs:     return f.submitMs;
+        case Metric::DisplayMs:    return f.displayMs;
+        case Metric::FrameMs:      return f.frameMs;
+    }
+    return 0.0;
+}
+
+double RenderStats::getPercentile(Metric metric, double percentile) const {
+    if (m_recent.empty()) return 0.0;
+    m_scratch.clear();
+    for (const FrameStats& f : m_recent)
+        m_scratch.push_back(value(f, metric));
+    double clamped = std::min(100.0, std::max(0.0, percentile));
+    std::size_t rank = static_cast<std::size_t>(std::ceil(clamped / 100.0 * m_scratch.size()));
+    rank = rank == 0 ? 0 : rank - 1;
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + rank, m_scratch.end());
+    return m_scratch[rank];
+}
+
+void RenderStats::logSummary() {
+    std::cout << "[RENDER] p50/p95/p99"
+              << " frameMs=" << getPercentile(Metric::FrameMs, 50) << "/" << getPercentile(Metric::FrameMs, 95)
+              << "/" << getPercentile(Metric::FrameMs, 99)
+              << " submitMs=" << getPercentile(Metric::SubmitMs, 50) << "/" << getPercentile(Metric::SubmitMs, 95)
+              << "/" << getPercentile(Metric::SubmitMs, 99)
+              << " displayMs=" << getPercentile(Metric::DisplayMs, 50) << "/" << getPercentile(Metric::DisplayMs, 95)
+              << "/" << getPercentile(Metric::DisplayMs, 99)
+              << " draws=" << getPercentile(Metric::DrawCalls, 50) << "/" << getPercentile(Metric::DrawCalls, 95)
+              << "/" << getPercentile(Metric::DrawCalls, 99)
+              << " verts=" << getPercentile(Metric::Vertices, 50)
+              << " views=" << getPercentile(Metric::ViewSwitches, 50)
+              << " texts=" << getPercentile(Metric::Texts, 50) << std::endl;
+}
+
+bool RenderStats::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "frame,drawCalls,vertices,viewSwitches,texts,submitMs,displayMs,frameMs\n";
+    for (std::size_t i = 0; i < m_session.size(); ++i) {
+        const FrameStats& f = m_session[i];
+        out << i << ',' << f.drawCalls << ',' << f.vertices << ',' << f.viewSwitches << ',' << f.texts << ','
+            << f.submitMs << ',' << f.displayMs << ',' << f.frameMs << '\n';
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,104 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Instrumented pass-through around the game window.
+ *
+ * Every State::Render (and the render thread) draws through this object
+ * instead of the window. It forwards each call unchanged and records, per
+ * frame, the draw calls, vertices, setView calls and text objects drawn, plus
+ * CPU time spent submitting (beginFrame() to display()) and inside display().
+ *
+ * The last FRAME_WINDOW frames feed rolling percentiles; every frame of the
+ * session (up to a cap) is kept for writeCsv(), so runs can be compared across
+ * builds. Only one thread may use it at a time: whichever owns the GL context.
+ */
+class RenderStats {
+public:
+    /**
+     * @brief Per-frame counters.
+     */
+    struct FrameStats {
+        unsigned int drawCalls = 0;    ///< target.draw() calls.
+        unsigned int vertices = 0;     ///< Vertices submitted (raw arrays, vertex arrays and buffers, counted drawables).
+        unsigned int viewSwitches = 0; ///< setView() calls.
+        unsigned int texts = 0;        ///< sf::Text objects drawn.
+        float submitMs = 0.f;          ///< CPU time from beginFrame() to display().
+        float displayMs = 0.f;         ///< CPU time inside display() (includes vsync/limiter waits).
+        float frameMs = 0.f;           ///< Time since the previous frame began.
+    };
+
+    /**
+     * @brief Metrics that percentiles can be queried for.
+     */
+    enum class Metric { DrawCalls, Vertices, ViewSwitches, Texts, SubmitMs, DisplayMs, FrameMs };
+
+    static constexpr std::size_t FRAME_WINDOW = 1024;         ///< Frames used for rolling percentiles.
+    static constexpr std::size_t MAX_SESSION_FRAMES = 1 << 18; ///< Frames kept for the CSV (~73 min at 60 FPS).
+
+    explicit RenderStats(sf::RenderWindow& window);
+
+    //--------------------------------------------------------------------------
+    // Instrumented window calls
+    //--------------------------------------------------------------------------
+    void beginFrame();                                ///< Starts the counters and submission timer.
+    void clear(const sf::Color& color = sf::Color::Black);
+    void setView(const sf::View& view);
+    const sf::View& getView() const { return m_window.getView(); }
+    const sf::View& getDefaultView() const { return m_window.getDefaultView(); }
+    sf::Vector2u getSize() const { return m_window.getSize(); }
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+    /// Adds vertices a custom drawable submitted internally, which draw() cannot see.
+    void countVertices(std::size_t count) { m_current.vertices += static_cast<unsigned int>(count); }
+    void display();                                   ///< Presents and closes the frame record.
+
+    //--------------------------------------------------------------------------
+    // Results
+    //--------------------------------------------------------------------------
+    const FrameStats& getLastFrame() const { return m_last; }
+
+    /**
+     * @brief Rolling percentile over the last FRAME_WINDOW frames.
+     * @param metric Metric to query.
+     * @param percentile Value in [0, 100].
+     */
+    double getPercentile(Metric metric, double percentile) const;
+
+    /**
+     * @brief Writes every recorded frame of the session as CSV.
+     * @param path Output file.
+     * @return False if the file could not be written.
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /// Enables a periodic percentile summary on stdout.
+    void setLogging(bool enabled, float intervalSeconds = 10.f);
+
+private:
+    static double value(const FrameStats& f, Metric metric);
+    void logSummary();
+
+    sf::RenderWindow& m_window;
+    FrameStats m_current;
+    FrameStats m_last;
+    sf::Clock m_submitClock;
+    sf::Clock m_frameClock;
+    bool m_frameStarted = false;
+
+    std::vector<FrameStats> m_recent;  ///< Ring buffer of the last FRAME_WINDOW frames.
+    std::size_t m_recentNext = 0;
+    std::vector<FrameStats> m_session; ///< Every frame (capped) for the CSV dump.
+    mutable std::vector<double> m_scratch;
+
+    bool m_logging = false;
+    float m_logInterval = 10.f;
+    sf::Clock m_logClock;
+};
+
+#endif // RENDERSTATS_H
@@ -0,0 +1,176 @@
+#include "RenderThread.h"
+#include <algorithm>
+#include <iostream>
+
+//-------------------------------------------------------------------------
+// Constructor & Destructor
+//-------------------------------------------------------------------------
+RenderThread::RenderThread(sf::RenderWindow& window, RenderStats& stats, float fixedDt)
+    : m_window(window),
+      m_gfx(stats),
+      m_fixedDt(fixedDt),
+      m_screenText(m_font),
+      m_viewText(m_font)
+{
+    if (!m_font.loadFromFile("Roboto-Regular.ttf")) {
+        std::cerr << "[ERROR] Render thread failed to load font!" << std::endl;
+    }
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+//-------------------------------------------------------------------------
+// Thread Lifecycle
+//-------------------------------------------------------------------------
+void RenderThread::start() {
+    if (m_running) return;
+    m_snapshots.reset(); // Never show a snapshot left over from a previous session.
+    m_enemyBuffer.clear();
+    m_window.setActive(false);
+    m_running = true;
+    m_frameCount = 0;
+    m_thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    if (!m_running) return;
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    m_window.setActive(true);
+}
+
+void RenderThread::setSprites(const EntitySprites& sprites) {
+    m_atlas = sprites.texture;
+    m_enemyBuffer.setSprites(&sprites);
+    m_entityBatch.setTexture(m_atlas);
+    m_grid.setTexture(m_atlas, sprites.whiteTexel());
+}
+
+RenderThread::FrameCounters RenderThread::getFrameCounters() const {
+    FrameCounters c;
+    c.drawCalls = m_drawCalls;
+    c.viewSwitches = m_viewSwitches;
+    c.commands = m_commands;
+    c.textures = m_textures;
+    c.batchedQuads = m_batchedQuads;
+    c.enemyQuads = m_enemyQuads;
+    c.enemyRewritten = m_enemyRewritten;
+    c.enemyUploadedVerts = m_enemyUploadedVerts;
+    return c;
+}
+
+void RenderThread::publish() {
+    RenderSnapshot& snapshot = m_snapshots.back();
+    snapshot.valid = true;
+    snapshot.publishTime = m_clock.getElapsedTime();
+    m_snapshots.publish();
+}
+
+void RenderThread::run() {
+    m_window.setActive(true);
+    sf::Clock paceClock;
+
+    while (m_running) {
+        const float minFrame = m_minFrameSeconds;
+        if (minFrame > 0.f) {
+            float wait = minFrame - paceClock.getElapsedTime().asSeconds();
+            if (wait > 0.f) sf::sleep(sf::seconds(wait));
+        }
+        paceClock.restart();
+
+        m_gfx.beginFrame();
+        m_snapshots.acquire();
+        const RenderSnapshot& snapshot = m_snapshots.front();
+
+        if (snapshot.valid) {
+            float alpha = (m_clock.getElapsedTime() - snapshot.publishTime).asSeconds() / m_fixedDt;
+            drawSnapshot(snapshot, std::min(std::max(alpha, 0.f), 1.f));
+        } else {
+            m_gfx.clear(sf::Color::Black);
+        }
+        m_gfx.display(); // Paced by the window's framerate limit / vsync.
+
+        ++m_frameCount;
+    }
+
+    m_window.setActive(false);
+}
+
+//-------------------------------------------------------------------------
+// Drawing
+//-------------------------------------------------------------------------
+void RenderThread::drawSnapshot(const RenderSnapshot& snapshot, float alpha) {
+    sf::View camera = snapshot.view;
+    camera.setCenter(snapshot.cameraPrev + (snapshot.cameraCur - snapshot.cameraPrev) * alpha);
+
+    m_queue.begin();
+    RenderQueue::ViewId worldView = m_queue.registerView(camera);
+    RenderQueue::ViewId screenView = m_queue.registerView(m_window.getDefaultView());
+
+    if (snapshot.gridCellSize > 0.f) {
+        m_grid.setCellSize(snapshot.gridCellSize);
+        m_grid.submit(m_queue, RenderQueue::Layer::Background, worldView, camera);
+    }
+
+    // Enemies keep their slots across frames; only quads that moved are
+    // rewritten and only the dirty range is uploaded.
+    m_enemyBuffer.beginFrame();
+    for (const RenderSnapshot::EnemyQuad& q : snapshot.enemies)
+        m_enemyBuffer.submit(q.id, q.prev + (q.cur - q.prev) * alpha, q.size, q.color, q.type);
+    m_enemyBuffer.endFrame();
+    if (!m_enemyBuffer.empty())
+        m_queue.submitDrawable(RenderQueue::Layer::World, worldView, m_enemyBuffer, m_enemyBuffer.getTexture(),
+                               sf::RenderStates::Default, m_enemyBuffer.getVertexCount());
+    m_enemyQuads = m_enemyBuffer.getLiveCount();
+    m_enemyRewritten = m_enemyBuffer.getRewrittenQuads();
+    m_enemyUploadedVerts = m_enemyBuffer.getUploadedVertices();
+
+    m_entityBatch.begin();
+    for (const RenderSnapshot::Quad& q : snapshot.entities) {
+        sf::Vector2f pos = q.prev + (q.cur - q.prev) * alpha;
+        m_entityBatch.add(pos.x, pos.y, q.size, q.color, q.texRect);
+    }
+    m_entityBatch.submit(m_queue, RenderQueue::Layer::World, worldView);
+
+    if (!snapshot.effects.empty())
+        m_queue.submitVertices(RenderQueue::Layer::Effects, worldView, snapshot.effects.data(),
+                               snapshot.effects.size(), sf::Quads, m_atlas);
+
+    if (!snapshot.minimapPixels.empty()) {
+        m_minimap.setPixels(snapshot.minimapPixels);
+        m_minimap.submit(m_queue, screenView, m_window.getSize());
+    }
+
+    // HUD: view-space text is offset by the interpolated camera. Each stream
+    // draws once per character size in use.
+    if (m_textLayouts.size() < snapshot.texts.size())
+        m_textLayouts.resize(snapshot.texts.size());
+    sf::Vector2f viewTopLeft = camera.getCenter() - camera.getSize() * 0.5f;
+    m_screenText.begin();
+    m_viewText.begin();
+    for (std::size_t i = 0; i < snapshot.texts.size(); ++i) {
+        const RenderSnapshot::Text& t = snapshot.texts[i];
+        CachedText& cached = m_textLayouts[i];
+        if (cached.content != t.content || cached.size != t.size) {
+            cached.content = t.content;
+            cached.size = t.size;
+            m_screenText.layout(sf::String(t.content), t.size, cached.layout);
+        }
+        if (t.viewSpace)
+            m_viewText.append(cached.layout, viewTopLeft + t.pos, t.color);
+        else
+            m_screenText.append(cached.layout, t.pos, t.color);
+    }
+    m_viewText.submit(m_queue, RenderQueue::Layer::WorldUI, worldView);
+    m_screenText.submit(m_queue, RenderQueue::Layer::ScreenUI, screenView);
+
+    m_gfx.clear(snapshot.clearColor);
+    m_drawCalls = m_queue.flush(m_gfx);
+    m_viewSwitches = m_queue.getViewSwitches();
+    m_commands = m_queue.getCommandCount();
+    m_textures = m_queue.getTextureCount();
+    m_batchedQuads = m_entityBatch.getQuadCount();
+}
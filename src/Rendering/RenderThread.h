@@ -0,0 +1,145 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "RenderSnapshot.h"
+#include "EnemyRenderBuffer.h"
+#include "EntityBatch.h"
+#include "GridBackground.h"
+#include "RenderQueue.h"
+#include "EntitySprites.h"
+#include "Minimap.h"
+#include "RenderStats.h"
+#include "TextBatcher.h"
+#include "../Utils/TripleBuffer.h"
+
+/**
+ * @brief Dedicated thread that draws published simulation snapshots.
+ *
+ * The simulation thread writes into publishSlot() and calls publish() once per
+ * fixed tick. The render thread always draws the newest snapshot, interpolating
+ * between its previous and current positions using the time elapsed since it
+ * was published, so a slow tick never blocks presentation and a slow frame
+ * never stalls the simulation.
+ *
+ * While running, the render thread owns the window's OpenGL context; the
+ * owning thread must not draw, display or change the window's view. Window
+ * events are still polled by the thread that created the window, as SFML
+ * requires.
+ */
+class RenderThread {
+public:
+    /**
+     * @brief Constructor.
+     * @param window Window to render into.
+     * @param stats Instrumented wrapper around window; only touched by the render thread while running.
+     * @param fixedDt Simulation tick length in seconds.
+     */
+    RenderThread(sf::RenderWindow& window, RenderStats& stats, float fixedDt);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * @brief Releases the context on the calling thread and starts rendering.
+     */
+    void start();
+
+    /**
+     * @brief Stops and joins the render thread, then reclaims the context.
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Snapshot owned by the simulation thread, to be filled before publish().
+     * @return Back buffer (holds stale data; call clear() first).
+     */
+    RenderSnapshot& publishSlot() { return m_snapshots.back(); }
+
+    /**
+     * @brief Stamps and hands the filled snapshot to the render thread.
+     */
+    void publish();
+
+    /**
+     * @brief Sets the entity atlas used for all world quads. Call before start().
+     * @param sprites Sprite set (must outlive this object).
+     */
+    void setSprites(const EntitySprites& sprites);
+
+    /**
+     * @brief Minimum time between presented frames (zero for the window's own limit).
+     *
+     * Safe to call from the simulation thread; used to throttle an unfocused window.
+     */
+    void setMinFrameInterval(sf::Time interval) { m_minFrameSeconds = interval.asSeconds(); }
+
+    /// Frames presented since start().
+    unsigned long long getFrameCount() const { return m_frameCount; }
+
+    /// Counters of the last drawn frame, readable from any thread.
+    struct FrameCounters {
+        std::size_t drawCalls = 0;
+        std::size_t viewSwitches = 0;
+        std::size_t commands = 0;
+        std::size_t textures = 0;
+        std::size_t batchedQuads = 0;        ///< Player and bullet quads.
+        std::size_t enemyQuads = 0;          ///< Enemies with a slot in the enemy buffer.
+        std::size_t enemyRewritten = 0;      ///< Enemy quads rewritten.
+        std::size_t enemyUploadedVerts = 0;  ///< Enemy vertices uploaded.
+    };
+    FrameCounters getFrameCounters() const;
+
+private:
+    void run();
+    void drawSnapshot(const RenderSnapshot& snapshot, float alpha);
+
+    sf::RenderWindow& m_window;
+    RenderStats& m_gfx;
+    const float m_fixedDt;
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+    std::atomic<unsigned long long> m_frameCount{ 0 };
+    std::atomic<float> m_minFrameSeconds{ 0.f };
+
+    TripleBuffer<RenderSnapshot> m_snapshots; ///< Simulation -> render hand-off.
+    sf::Clock m_clock;                        ///< Shared time base for publish stamps.
+
+    // Render-thread-only resources.
+    sf::Font m_font;                ///< Private font so glyph caches are never shared across threads.
+    TextBatcher m_screenText;       ///< Screen-space HUD text stream.
+    TextBatcher m_viewText;         ///< View-space HUD text stream.
+
+    /**
+     * @brief Layout cache per snapshot text slot; re-laid out only when the string changes.
+     */
+    struct CachedText {
+        std::string content;
+        unsigned int size = 0;
+        TextBatcher::TextLayout layout;
+    };
+    std::vector<CachedText> m_textLayouts;
+    EnemyRenderBuffer m_enemyBuffer; ///< Persistent enemy quads, rewritten only where they moved.
+    EntityBatch m_entityBatch;      ///< Player and bullet quads.
+    GridBackground m_grid;          ///< Background grid.
+    RenderQueue m_queue;            ///< Draw queue for this thread.
+    Minimap m_minimap;              ///< Texture-owning copy of the simulation's minimap.
+    const sf::Texture* m_atlas = nullptr; ///< Entity atlas texture.
+
+    std::atomic<std::size_t> m_drawCalls{ 0 };
+    std::atomic<std::size_t> m_viewSwitches{ 0 };
+    std::atomic<std::size_t> m_commands{ 0 };
+    std::atomic<std::size_t> m_textures{ 0 };
+    std::atomic<std::size_t> m_batchedQuads{ 0 };
+    std::atomic<std::size_t> m_enemyQuads{ 0 };
+    std::atomic<std::size_t> m_enemyRewritten{ 0 };
+    std::atomic<std::size_t> m_enemyUploadedVerts{ 0 };
+};
+
+#endif // RENDERTHREAD_H
@@ -0,0 +1,118 @@
+#include "TextBatcher.h"
+#include <algorithm>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+TextBatcher::TextBatcher(const sf::Font& font)
+    : m_font(font)
+{
+}
+
+//-------------------------------------------------------------------------
+// Layout
+//-------------------------------------------------------------------------
+void TextBatcher::layout(const sf::String& string, unsigned int characterSize, TextLayout& out) const {
+    out.vertices.clear();
+    out.bounds = sf::FloatRect();
+    out.characterSize = characterSize;
+    if (string.isEmpty())
+        return;
+
+    // Same rules as sf::Text (regular style), on this size's glyph page.
+    const float whitespace = m_font.getGlyph(L' ', characterSize, false).advance;
+    const float lineSpacing = m_font.getLineSpacing(characterSize);
+
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    float minX = static_cast<float>(characterSize), minY = static_cast<float>(characterSize);
+    float maxX = 0.f, maxY = 0.f;
+    sf::Uint32 prev = 0;
+    out.vertices.reserve(string.getSize() * 6);
+
+    for (std::size_t i = 0; i < string.getSize(); ++i) {
+        sf::Uint32 c = string[i];
+        x += m_font.getKerning(prev, c, characterSize);
+        prev = c;
+
+        if (c == L' ' || c == L'\n' || c == L'\t') {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (c == L' ')       x += whitespace;
+            else if (c == L'\t') x += whitespace * 4.f;
+            else { y += lineSpacing; x = 0.f; }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        const sf::Glyph& glyph = m_font.getGlyph(c, characterSize, false);
+        const float left = x + glyph.bounds.left, top = y + glyph.bounds.top;
+        const float right = left + glyph.bounds.width, bottom = top + glyph.bounds.height;
+        const float u0 = static_cast<float>(glyph.textureRect.left);
+        const float v0 = static_cast<float>(glyph.textureRect.top);
+        const float u1 = u0 + glyph.textureRect.width;
+        const float v1 = v0 + glyph.textureRect.height;
+
+        const sf::Vertex quad[4] = {
+            sf::Vertex(sf::Vector2f(left, top), sf::Color::White, sf::Vector2f(u0, v0)),
+            sf::Vertex(sf::Vector2f(right, top), sf::Color::White, sf::Vector2f(u1, v0)),
+            sf::Vertex(sf::Vector2f(left, bottom), sf::Color::White, sf::Vector2f(u0, v1)),
+            sf::Vertex(sf::Vector2f(right, bottom), sf::Color::White, sf::Vector2f(u1, v1)),
+        };
+        out.vertices.insert(out.vertices.end(), { quad[0], quad[1], quad[2], quad[2], quad[1], quad[3] });
+
+        minX = std::min(minX, left);
+        maxX = std::max(maxX, right);
+        minY = std::min(minY, top);
+        maxY = std::max(maxY, bottom);
+        x += glyph.advance;
+    }
+
+    out.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+//-------------------------------------------------------------------------
+// Batching
+//-------------------------------------------------------------------------
+void TextBatcher::begin() {
+    for (Batch& batch : m_batches)
+        batch.vertices.clear();
+}
+
+TextBatcher::Batch& TextBatcher::batchFor(unsigned int characterSize) {
+    for (Batch& batch : m_batches) {
+        if (batch.characterSize == characterSize)
+            return batch;
+    }
+    m_batches.push_back({ characterSize, {} });
+    return m_batches.back();
+}
+
+void TextBatcher::append(const TextLayout& layout, const sf::Vector2f& position, const sf::Color& color) {
+    if (layout.vertices.empty()) return;
+    std::vector<sf::Vertex>& vertices = batchFor(layout.characterSize).vertices;
+    const std::size_t base = vertices.size();
+    vertices.resize(base + layout.vertices.size());
+    for (std::size_t i = 0; i < layout.vertices.size(); ++i) {
+        sf::Vertex& v = vertices[base + i];
+        v.position = layout.vertices[i].position + position;
+        v.color = color;
+        v.texCoords = layout.vertices[i].texCoords;
+    }
+}
+
+void TextBatcher::submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view) const {
+    for (const Batch& batch : m_batches) {
+        if (batch.vertices.empty()) continue;
+        queue.submitVertices(layer, view, batch.vertices.data(), batch.vertices.size(), sf::Triangles,
+                             &getTexture(batch.characterSize));
+    }
+}
+
+std::size_t TextBatcher::getVertexCount() const {
+    std::size_t count = 0;
+    for (const Batch& batch : m_batches)
+        count += batch.vertices.size();
+    return count;
+}
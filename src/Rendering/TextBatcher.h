@@ -0,0 +1,88 @@
+#ifndef TEXTBATCHER_H
+#define TEXTBATCHER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "RenderQueue.h"
+
+/**
+ * @brief Draws many strings in one vertex stream per character size.
+ *
+ * Each string is laid out against the font's glyph page for its own
+ * character size, so glyphs are sampled 1:1 and stay as sharp as sf::Text.
+ * Strings of the same size share a page and are drawn together: a HUD layer
+ * costs one draw call per distinct size, not one per string. Batches are
+ * submitted in the order their size was first appended this frame.
+ *
+ * Layout (glyph lookup, kerning, line breaks) happens only in layout(); the
+ * result is cached by the caller in a TextLayout and re-used every frame.
+ * append() just copies the cached vertices with an offset and a colour, so a
+ * hover colour change rewrites colours and nothing else.
+ */
+class TextBatcher {
+public:
+    /**
+     * @brief Cached geometry of one string at one character size.
+     */
+    struct TextLayout {
+        std::vector<sf::Vertex> vertices; ///< Glyph triangles relative to the text origin.
+        sf::FloatRect bounds;             ///< Local bounds of the laid-out glyphs.
+        unsigned int characterSize = 0;   ///< Glyph page the texture coordinates refer to.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param font Font to lay out with (must outlive the batcher).
+     */
+    explicit TextBatcher(const sf::Font& font);
+
+    /**
+     * @brief Lays out a string; call only when the string or size changed.
+     * @param string Text to lay out.
+     * @param characterSize Displayed character size.
+     * @param out Layout to overwrite (its storage is reused).
+     */
+    void layout(const sf::String& string, unsigned int characterSize, TextLayout& out) const;
+
+    /**
+     * @brief Starts a new frame, keeping each batch and its vertex capacity.
+     */
+    void begin();
+
+    /**
+     * @brief Copies a cached layout into this frame's stream.
+     * @param layout Layout from layout().
+     * @param position Text origin in the coordinates of the view it is drawn with.
+     * @param color Fill colour.
+     */
+    void append(const TextLayout& layout, const sf::Vector2f& position, const sf::Color& color);
+
+    /**
+     * @brief Queues everything appended since begin(), one command per character size.
+     * @param queue Render queue for this frame.
+     * @param layer Draw layer.
+     * @param view View id from RenderQueue::registerView().
+     */
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId view) const;
+
+    /// Glyph page layouts of the given character size sample from.
+    const sf::Texture& getTexture(unsigned int characterSize) const { return m_font.getTexture(characterSize); }
+
+    std::size_t getVertexCount() const;
+
+private:
+    /**
+     * @brief Vertices of one character size for the current frame.
+     */
+    struct Batch {
+        unsigned int characterSize;
+        std::vector<sf::Vertex> vertices;
+    };
+
+    Batch& batchFor(unsigned int characterSize);
+
+    const sf::Font& m_font;
+    std::vector<Batch> m_batches; ///< Few entries (one per size in use); searched linearly.
+};
+
+#endif // TEXTBATCHER_H
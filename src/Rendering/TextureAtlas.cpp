@@ -0,0 +1,99 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <numeric>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+TextureAtlas::TextureAtlas(unsigned int maxSize, unsigned int padding)
+    : m_maxSize(maxSize),
+      m_padding(padding)
+{
+}
+
+//-------------------------------------------------------------------------
+// Registration & Lookup
+//-------------------------------------------------------------------------
+TextureAtlas::RegionId TextureAtlas::add(const std::string& name, const sf::Image& image) {
+    if (m_built) return INVALID_REGION;
+    Region region;
+    region.name = name;
+    region.image = image;
+    m_regions.push_back(std::move(region));
+    return m_regions.size() - 1;
+}
+
+TextureAtlas::RegionId TextureAtlas::find(const std::string& name) const {
+    for (std::size_t i = 0; i < m_regions.size(); ++i) {
+        if (m_regions[i].name == name) return i;
+    }
+    return INVALID_REGION;
+}
+
+//-------------------------------------------------------------------------
+// Packing
+//-------------------------------------------------------------------------
+bool TextureAtlas::build() {
+    sf::Clock buildClock;
+    if (m_built || m_regions.empty()) return m_built;
+
+    // Tallest images first keeps shelves tight.
+    std::vector<std::size_t> order(m_regions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return m_regions[a].image.getSize().y > m_regions[b].image.getSize().y;
+    });
+
+    // Start with the smallest power-of-two width that could hold the total area.
+    std::size_t area = 0;
+    unsigned int widest = 0;
+    for (const Region& r : m_regions) {
+        sf::Vector2u s = r.image.getSize();
+        area += static_cast<std::size_t>(s.x + m_padding * 2) * (s.y + m_padding * 2);
+        widest = std::max(widest, s.x + m_padding * 2);
+    }
+    unsigned int width = 64;
+    while (width < widest || static_cast<std::size_t>(width) * width < area) width *= 2;
+
+    std::vector<sf::Vector2u> positions(m_regions.size());
+    unsigned int height = 0;
+    for (;;) {
+        if (width > m_maxSize) return false;
+        unsigned int x = 0, y = 0, shelfHeight = 0;
+        for (std::size_t idx : order) {
+            sf::Vector2u s = m_regions[idx].image.getSize();
+            unsigned int w = s.x + m_padding * 2;
+            unsigned int h = s.y + m_padding * 2;
+            if (x + w > width) {
+                y += shelfHeight;
+                x = 0;
+                shelfHeight = 0;
+            }
+            positions[idx] = sf::Vector2u(x + m_padding, y + m_padding);
+            x += w;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        height = y + shelfHeight;
+        if (height <= width) break;
+        width *= 2; // Too tall for a square atlas: widen and repack.
+    }
+    unsigned int texHeight = 64;
+    while (texHeight < height) texHeight *= 2;
+
+    sf::Image packed;
+    packed.create(width, texHeight, sf::Color::Transparent);
+    for (std::size_t i = 0; i < m_regions.size(); ++i) {
+        Region& r = m_regions[i];
+        sf::Vector2u s = r.image.getSize();
+        packed.copy(r.image, positions[i].x, positions[i].y);
+        r.texRect = sf::FloatRect(static_cast<float>(positions[i].x), static_cast<float>(positions[i].y),
+                                  static_cast<float>(s.x), static_cast<float>(s.y));
+        r.image = sf::Image(); // Pixels now live on the GPU.
+    }
+
+    if (!m_texture.loadFromImage(packed)) return false;
+    m_texture.setSmooth(false);
+    m_built = true;
+    m_buildTime = buildClock.getElapsedTime();
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Packs many small images into one texture so their quads can share a bind.
+ *
+ * Images are registered with add() and packed once by build() using a shelf
+ * packer (tallest first). After building, each region is addressed by the id
+ * returned from add() and exposes its texture rectangle in pixels, the unit
+ * sf::Vertex::texCoords expects. Source images are released after upload.
+ */
+class TextureAtlas {
+public:
+    using RegionId = std::size_t;
+    static constexpr RegionId INVALID_REGION = static_cast<RegionId>(-1);
+
+    /**
+     * @brief Constructor.
+     * @param maxSize Largest allowed texture edge in pixels.
+     * @param padding Empty pixels around each region (prevents bleeding).
+     */
+    explicit TextureAtlas(unsigned int maxSize = 2048, unsigned int padding = 1);
+
+    /**
+     * @brief Registers an image to be packed. Only valid before build().
+     * @param name Lookup name.
+     * @param image Source pixels (copied).
+     * @return Region id, or INVALID_REGION if the atlas is already built.
+     */
+    RegionId add(const std::string& name, const sf::Image& image);
+
+    /**
+     * @brief Packs all registered images and uploads the texture.
+     * @return False if the images do not fit in maxSize x maxSize or upload fails.
+     */
+    bool build();
+
+    /**
+     * @brief Finds a region by name.
+     * @return Region id, or INVALID_REGION.
+     */
+    RegionId find(const std::string& name) const;
+
+    /// Texture rectangle (pixels) of a built region.
+    const sf::FloatRect& getTexRect(RegionId id) const { return m_regions[id].texRect; }
+
+    const sf::Texture& getTexture() const { return m_texture; } ///< Packed texture.
+    bool isBuilt() const { return m_built; }                    ///< True after a successful build().
+    sf::Vector2u getSize() const { return m_texture.getSize(); } ///< Texture size in pixels.
+    std::size_t getRegionCount() const { return m_regions.size(); }
+    sf::Time getBuildTime() const { return m_buildTime; }       ///< CPU time of the last build().
+
+    /// Approximate GPU memory of the packed texture (RGBA8).
+    std::size_t getMemoryBytes() const { return static_cast<std::size_t>(getSize().x) * getSize().y * 4; }
+
+private:
+    struct Region {
+        std::string name;
+        sf::Image image;        ///< Released after build().
+        sf::FloatRect texRect;  ///< Packed location in pixels.
+    };
+
+    unsigned int m_maxSize;
+    unsigned int m_padding;
+    std::vector<Region> m_regions;
+    sf::Texture m_texture;
+    sf::Time m_buildTime;
+    bool m_built = false;
+};
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,101 @@
+#include "UIScene.h"
+#include <cmath>
+#include <iostream>
+
+//-------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------
+UIScene::UIScene(const sf::Color& background)
+    : m_background(background)
+{
+}
+
+//-------------------------------------------------------------------------
+// Node Management
+//-------------------------------------------------------------------------
+UIScene::NodeId UIScene::addRect(const sf::FloatRect& rect, const sf::Color& fill,
+                                 const sf::Color& outline, float outlineThickness) {
+    Node node;
+    node.rect = rect;
+    node.fill = fill;
+    node.outline = outline;
+    node.outlineThickness = outlineThickness;
+    m_nodes.push_back(node);
+    m_dirty = true;
+    return static_cast<NodeId>(m_nodes.size() - 1);
+}
+
+void UIScene::setRect(NodeId id, const sf::FloatRect& rect) {
+    if (m_nodes[id].rect != rect) {
+        m_nodes[id].rect = rect;
+        m_dirty = true;
+    }
+}
+
+void UIScene::setFill(NodeId id, const sf::Color& fill) {
+    if (m_nodes[id].fill != fill) {
+        m_nodes[id].fill = fill;
+        m_dirty = true;
+    }
+}
+
+void UIScene::setVisible(NodeId id, bool visible) {
+    if (m_nodes[id].visible != visible) {
+        m_nodes[id].visible = visible;
+        m_dirty = true;
+    }
+}
+
+void UIScene::setBackground(const sf::Color& background) {
+    if (m_background != background) {
+        m_background = background;
+        m_dirty = true;
+    }
+}
+
+//-------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------
+void UIScene::submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId viewId, const sf::View& screen) {
+    const sf::Vector2f viewSize = screen.getSize();
+    const sf::Vector2u size(static_cast<unsigned int>(std::ceil(viewSize.x)),
+                            static_cast<unsigned int>(std::ceil(viewSize.y)));
+    if (size.x == 0 || size.y == 0)
+        return;
+    if (m_dirty || size != m_cacheSize)
+        compose(size);
+
+    queue.submitVertices(layer, viewId, m_quad, 4, sf::Quads, &m_cache.getTexture());
+}
+
+void UIScene::compose(const sf::Vector2u& size) {
+    if (size != m_cacheSize) {
+        if (!m_cache.create(size.x, size.y)) {
+            std::cerr << "[ERROR] UIScene failed to create a " << size.x << "x" << size.y << " cache" << std::endl;
+            return;
+        }
+        m_cacheSize = size;
+
+        const float w = static_cast<float>(size.x), h = static_cast<float>(size.y);
+        m_quad[0] = sf::Vertex(sf::Vector2f(0.f, 0.f), sf::Color::White, sf::Vector2f(0.f, 0.f));
+        m_quad[1] = sf::Vertex(sf::Vector2f(w, 0.f), sf::Color::White, sf::Vector2f(w, 0.f));
+        m_quad[2] = sf::Vertex(sf::Vector2f(w, h), sf::Color::White, sf::Vector2f(w, h));
+        m_quad[3] = sf::Vertex(sf::Vector2f(0.f, h), sf::Color::White, sf::Vector2f(0.f, h));
+    }
+
+    m_cache.clear(m_background);
+    sf::RectangleShape shape;
+    for (const Node& node : m_nodes) {
+        if (!node.visible) continue;
+        shape.setPosition(node.rect.left, node.rect.top);
+        shape.setSize(sf::Vector2f(node.rect.width, node.rect.height));
+        shape.setFillColor(node.fill);
+        shape.setOutlineColor(node.outline);
+        shape.setOutlineThickness(node.outlineThickness);
+        m_cache.draw(shape);
+    }
+    m_cache.display();
+
+    m_dirty = false;
+    ++m_composeCount;
+}
@@ -0,0 +1,76 @@
+#ifndef UISCENE_H
+#define UISCENE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "RenderQueue.h"
+
+/**
+ * @brief Retained set of static UI shapes composed into a cached texture.
+ *
+ * Menu and lobby states add their panels (header bar, slot frames) once, in
+ * their constructors, and afterwards only change them through the setters,
+ * which mark the scene dirty when a value actually differs. The background colour (transparent by default, so
+ * the window clear shows through) and every visible node are rendered into an
+ * sf::RenderTexture when the scene is dirty or the screen size changed; every
+ * other frame the cache is queued as one textured quad.
+ */
+class UIScene {
+public:
+    using NodeId = uint16_t;
+
+    explicit UIScene(const sf::Color& background = sf::Color::Transparent);
+
+    /**
+     * @brief Adds a rectangle node.
+     * @param rect Rectangle in screen coordinates.
+     * @param fill Fill colour.
+     * @param outline Outline colour.
+     * @param outlineThickness Outline thickness in pixels (0 for none).
+     * @return Id used by the setters.
+     */
+    NodeId addRect(const sf::FloatRect& rect, const sf::Color& fill,
+                   const sf::Color& outline = sf::Color::Transparent, float outlineThickness = 0.f);
+
+    void setRect(NodeId id, const sf::FloatRect& rect);
+    void setFill(NodeId id, const sf::Color& fill);
+    void setVisible(NodeId id, bool visible);
+    void setBackground(const sf::Color& background);
+
+    /**
+     * @brief Re-composes the cache if needed and queues it as one quad.
+     * @param queue Render queue for this frame.
+     * @param layer Draw layer (usually UIBackground).
+     * @param viewId Id of the screen view in the queue.
+     * @param screen Screen view; the cache covers its full area.
+     */
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, RenderQueue::ViewId viewId, const sf::View& screen);
+
+    /// Number of times the cache has been re-rendered (for diagnostics).
+    unsigned int getComposeCount() const { return m_composeCount; }
+
+private:
+    /**
+     * @brief A filled, optionally outlined rectangle.
+     */
+    struct Node {
+        sf::FloatRect rect;
+        sf::Color fill;
+        sf::Color outline;
+        float outlineThickness = 0.f;
+        bool visible = true;
+    };
+
+    void compose(const sf::Vector2u& size);
+
+    std::vector<Node> m_nodes;
+    sf::Color m_background;
+    sf::RenderTexture m_cache;   ///< Composed static layer.
+    sf::Vector2u m_cacheSize;    ///< Size the cache was composed at.
+    sf::Vertex m_quad[4];        ///< Screen quad sampling the cache.
+    bool m_dirty = true;
+    unsigned int m_composeCount = 0;
+};
+
+#endif // UISCENE_H
@@ -10,19 +10,19 @@ GameOverState::GameOverState(CubeGame* game) : State(game) {
     game->GetHUD().addElement("gameOver", "Game Over", 36, 
                                sf::Vector2f(SCREEN_WIDTH / 2.f - 100.f, 150.f), 
                                GameState::GameOver, HUD::RenderMode::ViewSpace, false);
-    game->GetHUD().updateBaseColor("gameOver", sf::Color::Red);
+    game->GetHUD().updateBaseColor("gameOver"_hud, sf::Color::Red);
 
     // Add and configure leaderboard element.
-    game->GetHUD().addElement("leaderboard", "Leaderboard:\n", 24, 
+    leaderboardText = game->GetHUD().addElement("leaderboard", "Leaderboard:\n", 24, 
                                sf::Vector2f(SCREEN_WIDTH / 2.f - 150.f, 200.f), 
                                GameState::GameOver, HUD::RenderMode::ViewSpace, false);
-    game->GetHUD().updateBaseColor("leaderboard", sf::Color::White);
+    game->GetHUD().updateBaseColor(leaderboardText, sf::Color::White);
 
     // Add and configure instruction element for returning to the lobby.
     game->GetHUD().addElement("return", "Press Enter to Continue or M to Return to Lobby", 20, 
                                sf::Vector2f(SCREEN_WIDTH / 2.f - 200.f, SCREEN_HEIGHT - 100.f), 
                                GameState::GameOver, HUD::RenderMode::ViewSpace, false);
-    game->GetHUD().updateBaseColor("return", sf::Color::Yellow);
+    game->GetHUD().updateBaseColor("return"_hud, sf::Color::Yellow);
 }
 
 //---------------------------------------------------------
@@ -36,20 +36,23 @@ void GameOverState::Update(float dt) {
 // Render: Draw game over screen elements
 //---------------------------------------------------------
 void GameOverState::Render() {
-    game->GetWindow().clear(sf::Color::Black);
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
+    RenderQueue::ViewId worldView = queue.registerView(game->GetWindow().getView());
 
-    // Render all player shapes (frozen state).
+    // All player shapes (frozen state).
     for (const auto& player : game->GetPlayers()) {
-        game->GetWindow().draw(player.second.shape);
-    }
-    // Render all enemy shapes (frozen state).
-    for (const auto& enemy : game->GetEnemies()) {
-        game->GetWindow().draw(enemy.second.shape);
+        queue.submitDrawable(RenderQueue::Layer::World, worldView, player.second.shape);
     }
 
-    // Render HUD elements for Game Over.
-    game->GetHUD().render(game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
-    game->GetWindow().display();
+    // HUD elements for Game Over.
+    game->GetHUD().submit(queue, game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
+
+    gfx.clear(sf::Color::Black);
+    queue.flush(gfx);
+    gfx.display();
 }
 
 //---------------------------------------------------------
@@ -60,12 +63,8 @@ void GameOverState::ProcessEvent(const sf::Event& event) {
         if (event.key.code == sf::Keyboard::Return || event.key.code == sf::Keyboard::M) {
             if (game->IsHost()) {
                 game->ReturnToLobby();
-                char buffer[64];
-                int bytes = snprintf(buffer, sizeof(buffer), "S|LOBBY");
-                if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                    game->GetNetworkManager()->SendGameplayMessage(std::string(buffer));
-                    std::cout << "[DEBUG] Host sent S|LOBBY to return to lobby" << std::endl;
-                }
+                game->GetNetworkManager()->SendGameplayMessage(Wire::LobbyReturn());
+                std::cout << "[DEBUG] Host sent LobbyReturn to return to lobby" << std::endl;
             }
         }
     }
@@ -75,18 +74,26 @@ void GameOverState::ProcessEvent(const sf::Event& event) {
 // UpdateLeaderboard: Refresh and update leaderboard text
 //---------------------------------------------------------
 void GameOverState::UpdateLeaderboard() {
-    std::string leaderboard = "Leaderboard:\n";
+    PersonaNameCache& names = game->GetPersonaNames();
+    leaderboardScratch.clear();
     for (const auto& player : game->GetPlayers()) {
-        const char* steamName = SteamFriends() ? SteamFriends()->GetFriendPersonaName(player.second.steamID) : "Unknown";
-        if (!steamName || steamName[0] == '\0') {
-            steamName = "Unknown"; // Fallback if name is empty.
-        }
-        leaderboard += std::string(steamName) +
-                       ": Kills=" + std::to_string(player.second.kills) +
-                       ", Money=" + std::to_string(player.second.money) +
-                       (player.second.isAlive ? " (Alive)" : " (Dead)") + "\n";
+        const Player& p = player.second;
+        leaderboardScratch.push_back({ p.steamID, p.kills, p.money, p.isAlive });
+    }
+    if (leaderboardBuilt && leaderboardScratch == leaderboardRows && leaderboardNamesVersion == names.getVersion())
+        return;
+    leaderboardRows.swap(leaderboardScratch);
+    leaderboardNamesVersion = names.getVersion();
+    leaderboardBuilt = true;
+
+    std::string leaderboard = "Leaderboard:\n";
+    for (const LeaderboardRow& row : leaderboardRows) {
+        leaderboard += names.get(row.id) +
+                       ": Kills=" + std::to_string(row.kills) +
+                       ", Money=" + std::to_string(row.money) +
+                       (row.alive ? " (Alive)" : " (Dead)") + "\n";
     }
-    game->GetHUD().updateText("leaderboard", leaderboard);
+    game->GetHUD().updateText(leaderboardText, leaderboard);
 }
 void GameOverState::Interpolate(float alpha) {
     // No interpolation needed for a static lobby search screen
@@ -3,6 +3,7 @@
 
 #include "State.h"
 #include <steam/steam_api.h>
+#include <vector>
 
 /**
  * @brief Represents the game state when the game is over.
@@ -27,8 +28,26 @@ public:
     void ProcessEvent(const sf::Event& event) override;
     void Interpolate(float alpha) override;
 private:
-    /// Update the leaderboard displayed on the HUD.
+    /// Update the leaderboard displayed on the HUD (only when a shown value changed).
     void UpdateLeaderboard();
+
+    /**
+     * @brief Leaderboard values last written to the HUD.
+     */
+    struct LeaderboardRow {
+        CSteamID id;
+        int kills;
+        int money;
+        bool alive;
+        bool operator==(const LeaderboardRow& o) const {
+            return id == o.id && kills == o.kills && money == o.money && alive == o.alive;
+        }
+    };
+    std::vector<LeaderboardRow> leaderboardRows;    ///< Rows currently displayed.
+    std::vector<LeaderboardRow> leaderboardScratch; ///< Reused per tick for comparison.
+    uint32_t leaderboardNamesVersion = 0;           ///< PersonaNameCache version the text was built with.
+    bool leaderboardBuilt = false;
+    HUD::Handle leaderboardText = HUD::InvalidHandle; ///< HUD element showing the leaderboard.
 };
 
 #endif // GAMEOVERSTATE_H
@@ -1,5 +1,7 @@
 #include "GameplayState.h"
 #include "../Hud/HUD.h"
+#include "../Utils/FastHash.h"
+#include "../Rendering/RenderThread.h"
 #include <cmath>
 #include <random>
 #include <iostream>
@@ -15,20 +17,41 @@ GameplayState::GameplayState(CubeGame* game)
       enemyUpdateRate(0.01f),
       menuVisible(false)
 {
-    // Host spawns initial enemies and performs a full enemy sync before the game starts.
+    // Host spawns initial enemies before the game starts; snapshots replicate them.
     if (game->IsHost() && !game->IsGameStarted()) {
         game->GetEntityManager()->spawnEnemies(game->GetEnemiesPerWave(),
                                                  game->GetPlayers(),
                                                  game->GetLocalPlayer().steamID.ConvertToUint64());
-        game->GetNetworkManager()->SyncEnemiesFull();
     }
     
+    gridBackground.setCellSize(gridSize);
+
+    // Every world quad samples the shared entity atlas, so the world is one texture bind.
+    const EntitySprites& sprites = game->GetSprites();
+    entityBatch.setTexture(sprites.texture);
+    entityBatch.setStyle(EntityBatch::Kind::Player, { sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE), sf::Color::Blue, sprites.player });
+    entityBatch.setStyle(EntityBatch::Kind::Bullet, { sf::Vector2f(BULLET_SIZE, BULLET_SIZE), sf::Color::Yellow, sprites.bullet });
+    enemyBuffer.setSprites(&sprites);
+    particles.setTexture(sprites.texture, sprites.particle);
+    gridBackground.setTexture(sprites.texture, sprites.whiteTexel());
+    cameraCenter = game->GetView().getCenter();
+    previousCameraCenter = cameraCenter;
+
+    game->GetEntityManager()->setEnemySplitCallback([this](const Enemy& enemy) {
+        SpawnEnemyEffect(ParticleEffect::Split, enemy);
+    });
+
     // Configure HUD elements for gameplay and store.
     sf::Vector2u winSize = game->GetWindow().getSize();
     game->GetHUD().configureGameplayHUD(winSize);
     game->GetHUD().configureStoreHUD(winSize);
 }
 
+GameplayState::~GameplayState() {
+    // The entity manager outlives this state; drop the callback capturing it.
+    game->GetEntityManager()->setEnemySplitCallback(nullptr);
+}
+
 //---------------------------------------------------------
 // Update Function
 //---------------------------------------------------------
@@ -43,18 +66,16 @@ void GameplayState::Update(float dt) {
             static float lastTimerSync = 0.0f;
             lastTimerSync += dt;
             if (lastTimerSync >= 0.5f) {
-                char buffer[64];
-                int bytes = snprintf(buffer, sizeof(buffer), "S|TIMER|%.1f", nextLevelTimer);
-                if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                    game->GetNetworkManager()->SendGameplayMessage(std::string(buffer));
-                }
+                Wire::Timer timer;
+                timer.remaining = nextLevelTimer;
+                game->GetNetworkManager()->SendGameplayMessage(timer);
                 lastTimerSync = 0.0f;
             }
             if (nextLevelTimer <= 0) {
                 nextLevelTimer = 0;
                 timerActive = false;
                 if (game->IsHost()) {
-                    game->GetNetworkManager()->SpawnEnemiesAndBroadcast();
+                    game->GetNetworkManager()->SpawnEnemyWave();
                 }
             }
         }
@@ -64,25 +85,33 @@ void GameplayState::Update(float dt) {
             [](const auto& pair) { return !pair.second.isAlive; });
         if (allDead && game->GetCurrentState() != GameState::GameOver) {
             game->SetCurrentState(GameState::GameOver);
-            char gameOverBuffer[32];
-            int goBytes = snprintf(gameOverBuffer, sizeof(gameOverBuffer), "S|GAMEOVER");
-            if (goBytes > 0 && static_cast<size_t>(goBytes) < sizeof(gameOverBuffer)) {
-                game->GetNetworkManager()->broadcastMessage(std::string(gameOverBuffer));
-            }
+            game->GetNetworkManager()->broadcastMessage(Wire::GameOver());
             return;
         }
     }
 
+    // Advance the simulation once per fixed tick (previously once per rendered frame).
+    game->GetEntityManager()->updateEntities(dt);
+    particles.update(dt);
+    minimap.update(dt, *game->GetEntityManager(), cameraCenter,
+                   sf::Vector2f(game->GetLocalPlayer().x, game->GetLocalPlayer().y));
+
     // Update playing state logic
     if (game->GetCurrentState() == GameState::Playing && !menuVisible) {
         UpdatePlayingState(dt);
     }
 
-    // Update HUD content (logic, not rendering)
-    sf::Vector2u winSize = game->GetWindow().getSize();
-    game->GetHUD().refreshHUDContent(game->GetCurrentState(), menuVisible, shopOpen, winSize, game->GetLocalPlayer());
-    game->GetHUD().refreshGameInfo(winSize, game->GetCurrentLevel(), game->GetEnemies().size(),
-                                   game->GetLocalPlayer(), nextLevelTimer, game->GetPlayers());
+    // Feed the HUD model; only fields whose displayed value changed are reformatted.
+    const Player& local = game->GetLocalPlayer();
+    hudModel.setWindowSize(game->GetWindow().getSize());
+    hudModel.setLevel(game->GetCurrentLevel());
+    hudModel.setEnemyCount(game->GetEnemies().size());
+    hudModel.setLocalStats(local.health, local.kills, local.money);
+    hudModel.setNextWaveTimer(nextLevelTimer);
+    hudModel.setMenuVisible(menuVisible && game->GetCurrentState() == GameState::Playing);
+    hudModel.setShopOpen(shopOpen);
+    hudModel.setScoreboard(game->GetPlayers(), game->GetPersonaNames().getVersion());
+    game->GetHUD().applyModel(hudModel, game->GetPersonaNames());
 }
 
 void GameplayState::Interpolate(float alpha) {
@@ -104,11 +133,9 @@ void GameplayState::StartNextLevelTimer(float duration) {
         nextLevelTimer = duration;
         timerActive = true;
         if (game->IsHost()) {
-            char buffer[64];
-            int bytes = snprintf(buffer, sizeof(buffer), "S|NEXT|%.1f", duration);
-            if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                game->GetNetworkManager()->SendGameplayMessage(std::string(buffer));
-            }
+            Wire::NextLevel next;
+            next.duration = duration;
+            game->GetNetworkManager()->SendGameplayMessage(next);
         }
     }
 }
@@ -139,19 +166,23 @@ void GameplayState::UpdatePlayingState(float dt) {
     // Check for collisions between bullets and enemies, and between players and enemies.
     game->GetEntityManager()->checkCollisions(
         [&](const Bullet& b, uint64_t enemyId) {
-            uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count();
+            if (game->GetEnemies().count(enemyId))
+                SpawnEffect(ParticleEffect::Hit, sf::Vector2f(b.renderedX, b.renderedY), game->GetEnemies()[enemyId].color);
             int damage = 10;
-            char hitBuffer[128];
-            snprintf(hitBuffer, sizeof(hitBuffer), "H|%llu|%llu|%llu|%d|%llu",
-                     b.id, enemyId, game->GetLocalPlayer().steamID.ConvertToUint64(), damage, timestamp);
-            game->GetNetworkManager()->SendGameplayMessage(std::string(hitBuffer));
+            Wire::Hit hit;
+            hit.shooter = game->GetLocalPlayer().steamID;
+            hit.bulletIndex = static_cast<uint32_t>(b.id);
+            hit.enemyId = enemyId;
+            hit.damage = damage;
+            hit.tick = game->GetNetworkManager()->currentTick();
+            game->GetNetworkManager()->SendGameplayMessage(hit, sf::Vector2f(b.renderedX, b.renderedY));
     
             // Client-side prediction: Reduce enemy health only, no stats update
             if (!game->IsHost() && game->GetEnemies().count(enemyId)) {
                 Enemy& enemy = game->GetEnemies()[enemyId];
                 enemy.health -= damage;
                 if (enemy.health <= 0) {
+                    SpawnEnemyEffect(ParticleEffect::Death, enemy);
                     game->GetEntityManager()->getEnemies().erase(enemyId);
                 }
             }
@@ -166,23 +197,7 @@ void GameplayState::UpdatePlayingState(float dt) {
                         player.isAlive = false;
                         std::cout << "[DEBUG] Player " << playerId.ConvertToUint64() << " died" << std::endl;
                         // Send updated player state to network.
-                        char buffer[256];
-                        int bytes = snprintf(buffer, sizeof(buffer),
-                                             "P|%llu|%.1f|%.1f|%.1f|%.1f|%d|%d|%d|%d|%.1f|%d",
-                                             player.steamID.ConvertToUint64(), player.x, player.y,
-                                             player.renderedX, player.renderedY, player.health,
-                                             player.kills, player.ready ? 1 : 0, player.money, player.speed, player.isAlive ? 1 : 0);
-                        if (bytes > 0 && static_cast<size_t>(bytes) < sizeof(buffer)) {
-                            if (game->IsHost()) {
-                                game->GetNetworkManager()->broadcastMessage(std::string(buffer));
-                            } else {
-                                const char* hostStr = SteamMatchmaking()->GetLobbyData(game->GetCurrentLobby(), "host_steam_id");
-                                if (hostStr && *hostStr) {
-                                    CSteamID hostID(std::stoull(hostStr));
-                                    game->GetNetworkManager()->sendMessage(hostID, std::string(buffer));
-                                }
-                            }
-                        }
+                        game->GetNetworkManager()->SendGameplayMessage(game->MakePlayerUpdate(player));
                         game->GetLocalPlayer() = player;
                     }
                 }
@@ -195,13 +210,13 @@ void GameplayState::UpdatePlayingState(float dt) {
         it->retryTimer -= dt;
         if (it->retryTimer <= 0) {
             if (game->GetEnemies().count(it->enemyId)) {
-                uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now().time_since_epoch()).count();
-                int damage = 10;
-                char hitBuffer[128];
-                snprintf(hitBuffer, sizeof(hitBuffer), "H|%llu|%llu|%llu|%d|%llu",
-                         it->bulletId, it->enemyId, it->shooterSteamID, damage, timestamp);
-                game->GetNetworkManager()->SendGameplayMessage(std::string(hitBuffer));
+                Wire::Hit hit;
+                hit.shooter = CSteamID(it->shooterSteamID);
+                hit.bulletIndex = static_cast<uint32_t>(it->bulletId);
+                hit.enemyId = it->enemyId;
+                hit.damage = 10;
+                hit.tick = game->GetNetworkManager()->currentTick();
+                game->GetNetworkManager()->SendGameplayMessage(hit);
                 it->retryTimer = 0.5f;
                 ++it;
             } else {
@@ -242,88 +257,221 @@ void GameplayState::ProcessEvent(const sf::Event& event) {
 //---------------------------------------------------------
 void GameplayState::UpdateCamera(float dt) {
     const Player& localPlayer = game->GetLocalPlayer();
-    sf::View view = game->GetView();
-    view.setCenter(localPlayer.renderedX, localPlayer.renderedY);
-    game->GetWindow().setView(view);
+    previousCameraCenter = cameraCenter;
+    cameraCenter = sf::Vector2f(localPlayer.renderedX, localPlayer.renderedY);
+
+    // The render thread reads the camera from snapshots instead.
+    if (!game->IsRenderThreadActive()) {
+        sf::View view = game->GetView();
+        view.setCenter(cameraCenter);
+        game->GetWindow().setView(view);
+    }
 }
 
 //---------------------------------------------------------
 // Rendering Functions
 //---------------------------------------------------------
 void GameplayState::Render() {
-    game->GetWindow().clear(sf::Color::Black);
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
     sf::View currentView = game->GetWindow().getView();
-    RenderGrid(game->GetWindow(), currentView);
-    RenderPlayers();
+    worldViewId = queue.registerView(currentView);
+
+    RenderGrid(currentView);
+    CullWorld(currentView);
     RenderEnemies();
+
+    // Players and bullets share one vertex stream and go out in a single draw.
+    entityBatch.begin();
+    RenderPlayers();
     RenderBullets();
-    game->GetHUD().render(game->GetWindow(), currentView, game->GetCurrentState());
-    game->GetWindow().display();
+    entityBatch.submit(queue, RenderQueue::Layer::World, worldViewId);
+    RenderEffects();
+    RenderMinimap();
+
+    game->GetHUD().submit(queue, game->GetWindow(), currentView, game->GetCurrentState());
+
+    gfx.clear(sf::Color::Black);
+    drawCallCount = queue.flush(gfx);
+    gfx.display();
+
+    ReportRenderStats();
+}
+
+void GameplayState::CullWorld(const sf::View& camera) {
+    // Margin covers entity extents and the Splitter shake offset.
+    const float margin = 64.f;
+    sf::Vector2f size = camera.getSize();
+    sf::Vector2f topLeft = camera.getCenter() - size * 0.5f;
+    cullRect = sf::FloatRect(topLeft.x - margin, topLeft.y - margin,
+                             size.x + 2.f * margin, size.y + 2.f * margin);
+
+    visibleEnemyIds.clear();
+    visibleBulletIds.clear();
+    game->GetEntityManager()->queryRegion(cullRect, visibleEnemyIds, visibleBulletIds);
 }
 
 void GameplayState::RenderPlayers() {
+    visiblePlayerCount = 0;
     for (auto& playerPair : game->GetPlayers()) {
-        Player& player = playerPair.second;
-        if (!std::isnan(player.renderedX) && !std::isnan(player.renderedY)) {
-            player.shape.setPosition(player.renderedX, player.renderedY);
-            game->GetWindow().draw(player.shape);
-        }
+        const Player& player = playerPair.second;
+        if (std::isnan(player.renderedX) || std::isnan(player.renderedY)) continue;
+        if (!cullRect.intersects(sf::FloatRect(player.renderedX, player.renderedY, PLAYER_SIZE, PLAYER_SIZE)))
+            continue;
+        entityBatch.add(EntityBatch::Kind::Player, player.renderedX, player.renderedY);
+        ++visiblePlayerCount;
     }
 }
 
 void GameplayState::RenderEnemies() {
     updateEnemyVertices();
-    game->GetWindow().draw(enemyVertices);
+    if (!enemyBuffer.empty())
+        game->GetRenderQueue().submitDrawable(RenderQueue::Layer::World, worldViewId, enemyBuffer, enemyBuffer.getTexture(),
+                                              sf::RenderStates::Default, enemyBuffer.getVertexCount());
 }
 
 void GameplayState::RenderBullets() {
-    for (auto& bulletPair : game->GetEntityManager()->getBullets()) {
-        Bullet& bullet = bulletPair.second;
+    auto& bullets = game->GetEntityManager()->getBullets();
+    for (uint64_t id : visibleBulletIds) {
+        auto it = bullets.find(id);
+        if (it == bullets.end()) continue;
+        const Bullet& bullet = it->second;
         if (!std::isnan(bullet.renderedX) && !std::isnan(bullet.renderedY)) {
-            bullet.shape.setPosition(bullet.renderedX, bullet.renderedY);
-            game->GetWindow().draw(bullet.shape);
+            entityBatch.add(EntityBatch::Kind::Bullet, bullet.renderedX, bullet.renderedY);
         }
     }
 }
 
+void GameplayState::RenderEffects() {
+    particles.submit(game->GetRenderQueue(), RenderQueue::Layer::Effects, worldViewId, cullRect);
+}
+
+void GameplayState::RenderMinimap() {
+    RenderQueue& queue = game->GetRenderQueue();
+    minimap.submit(queue, queue.registerView(game->GetWindow().getDefaultView()), game->GetWindow().getSize());
+}
+
+void GameplayState::SpawnEffect(ParticleEffect effect, const sf::Vector2f& position, const sf::Color& color) {
+    particles.emit(effect, position, color);
+}
+
+void GameplayState::SpawnEnemyEffect(ParticleEffect effect, const Enemy& enemy) {
+    if (std::isnan(enemy.renderedX) || std::isnan(enemy.renderedY)) return;
+    sf::Vector2f center(enemy.renderedX + enemy.size.x * 0.5f, enemy.renderedY + enemy.size.y * 0.5f);
+    particles.emit(effect, center, enemy.color);
+}
+
 //---------------------------------------------------------
-// Grid Rendering (for debugging or visual effect)
+// Render Snapshot (render-thread path)
 //---------------------------------------------------------
-void GameplayState::RenderGrid(sf::RenderWindow& window, const sf::View& camera) {
-    const float gridSize = 50.f;
-    const int maxLines = 1000;
-    sf::Vector2f camCenter = camera.getCenter();
-    sf::Vector2f camSize = camera.getSize();
-
-    int startX = static_cast<int>(std::floor((camCenter.x - camSize.x / 2) / gridSize)) - 1;
-    int endX = static_cast<int>(std::ceil((camCenter.x + camSize.x / 2) / gridSize)) + 1;
-    int startY = static_cast<int>(std::floor((camCenter.y - camSize.y / 2) / gridSize)) - 1;
-    int endY = static_cast<int>(std::ceil((camCenter.y + camSize.y / 2) / gridSize)) + 1;
-
-    int numVertical = endX - startX + 1;
-    int numHorizontal = endY - startY + 1;
-    if (numVertical * numHorizontal > maxLines) {
-        float factor = std::sqrt(static_cast<float>(maxLines) / (numVertical * numHorizontal));
-        int newWidth = static_cast<int>(numVertical * factor);
-        int newHeight = static_cast<int>(numHorizontal * factor);
-        startX = static_cast<int>(camCenter.x / gridSize) - newWidth / 2;
-        endX = startX + newWidth;
-        startY = static_cast<int>(camCenter.y / gridSize) - newHeight / 2;
-        endY = startY + newHeight;
+void GameplayState::PublishSnapshot(RenderSnapshot& snapshot) {
+    snapshot.clear();
+    snapshot.clearColor = sf::Color::Black;
+    snapshot.view = game->GetView();
+    snapshot.cameraPrev = previousCameraCenter;
+    snapshot.cameraCur = cameraCenter;
+    snapshot.gridCellSize = gridSize;
+    ++snapshotTick;
+
+    sf::View camera = snapshot.view;
+    camera.setCenter(cameraCenter);
+    CullWorld(camera);
+
+    auto& enemies = game->GetEnemies();
+    for (uint64_t id : visibleEnemyIds) {
+        auto it = enemies.find(id);
+        if (it == enemies.end()) continue;
+        const Enemy& enemy = it->second;
+        if (enemy.health <= 0 || std::isnan(enemy.x) || std::isnan(enemy.y)) continue;
+
+        sf::Vector2f shake(0.f, 0.f);
+        if (enemy.isSplitting && enemy.shakeTimer > 0) {
+            float amount = enemy.shakeTimer / enemy.shakeDuration;
+            shake.x = hashJitter(id, snapshotTick, 0) * amount;
+            shake.y = hashJitter(id, snapshotTick, 1) * amount;
+        }
+        snapshot.enemies.push_back({ id, sf::Vector2f(enemy.lastX, enemy.lastY) + shake,
+                                     sf::Vector2f(enemy.x, enemy.y) + shake,
+                                     enemy.size, enemy.color, enemy.type });
     }
 
-    sf::VertexArray lines(sf::Lines);
-    for (int x = startX; x <= endX; ++x) {
-        float lineX = x * gridSize;
-        lines.append(sf::Vertex(sf::Vector2f(lineX, startY * gridSize), sf::Color(50, 50, 50)));
-        lines.append(sf::Vertex(sf::Vector2f(lineX, endY * gridSize), sf::Color(50, 50, 50)));
+    visiblePlayerCount = 0;
+    for (const auto& [id, player] : game->GetPlayers()) {
+        if (std::isnan(player.x) || std::isnan(player.y)) continue;
+        if (!cullRect.intersects(sf::FloatRect(player.x, player.y, PLAYER_SIZE, PLAYER_SIZE))) continue;
+        snapshot.entities.push_back({ sf::Vector2f(player.lastX, player.lastY), sf::Vector2f(player.x, player.y),
+                                      sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE), sf::Color::Blue, game->GetSprites().player });
+        ++visiblePlayerCount;
     }
-    for (int y = startY; y <= endY; ++y) {
-        float lineY = y * gridSize;
-        lines.append(sf::Vertex(sf::Vector2f(startX * gridSize, lineY), sf::Color(50, 50, 50)));
-        lines.append(sf::Vertex(sf::Vector2f(endX * gridSize, lineY), sf::Color(50, 50, 50)));
+
+    auto& bullets = game->GetEntityManager()->getBullets();
+    for (uint64_t id : visibleBulletIds) {
+        auto it = bullets.find(id);
+        if (it == bullets.end()) continue;
+        const Bullet& bullet = it->second;
+        if (std::isnan(bullet.x) || std::isnan(bullet.y)) continue;
+        snapshot.entities.push_back({ sf::Vector2f(bullet.lastX, bullet.lastY), sf::Vector2f(bullet.x, bullet.y),
+                                      sf::Vector2f(BULLET_SIZE, BULLET_SIZE), sf::Color::Yellow, game->GetSprites().bullet });
+    }
+
+    particles.buildVertices(cullRect, snapshot.effects);
+    snapshot.minimapPixels = minimap.getPixels();
+
+    game->GetHUD().collectTexts(game->GetWindow(), game->GetCurrentState(), snapshot.texts);
+
+    ReportRenderStats();
+}
+
+//---------------------------------------------------------
+// Render Statistics
+//---------------------------------------------------------
+void GameplayState::ReportRenderStats() {
+    // Frame-level timings and draw counts are logged by RenderStats; this adds
+    // the gameplay-side culling and buffer counters. The enemy buffer and draw
+    // counts come from whichever thread draws gameplay.
+    const float reportInterval = 10.0f;
+    if (statsReportClock.getElapsedTime().asSeconds() < reportInterval) return;
+
+    if (game->IsDebugMode()) {
+        const bool threaded = game->IsRenderThreadActive();
+        RenderThread::FrameCounters frame;
+        if (threaded) {
+            frame = game->GetRenderThread()->getFrameCounters();
+        } else {
+            frame.drawCalls = drawCallCount;
+            frame.viewSwitches = game->GetRenderQueue().getViewSwitches();
+            frame.commands = game->GetRenderQueue().getCommandCount();
+            frame.textures = game->GetRenderQueue().getTextureCount();
+            frame.batchedQuads = entityBatch.getQuadCount();
+            frame.enemyQuads = enemyBuffer.getLiveCount();
+            frame.enemyRewritten = enemyBuffer.getRewrittenQuads();
+            frame.enemyUploadedVerts = enemyBuffer.getUploadedVertices();
+        }
+        std::cout << "[RENDER] path=" << (threaded ? "threaded" : "main")
+                  << " drawCalls=" << frame.drawCalls
+                  << " viewSwitches=" << frame.viewSwitches
+                  << " commands=" << frame.commands
+                  << " textures=" << frame.textures
+                  << " batchedQuads=" << frame.batchedQuads
+                  << " visibleEnemies=" << visibleEnemyIds.size() << "/" << game->GetEnemies().size()
+                  << " visibleBullets=" << visibleBulletIds.size() << "/" << game->GetEntityManager()->getBullets().size()
+                  << " visiblePlayers=" << visiblePlayerCount << "/" << game->GetPlayers().size()
+                  << " particles=" << particles.getLiveCount() << "/" << particles.getCapacity()
+                  << " particlesDropped=" << particles.getDropped()
+                  << " enemyQuads=" << frame.enemyQuads
+                  << " enemyRewritten=" << frame.enemyRewritten
+                  << " enemyUploadedVerts=" << frame.enemyUploadedVerts << std::endl;
     }
-    window.draw(lines);
+    statsReportClock.restart();
+}
+
+//---------------------------------------------------------
+// Grid Rendering (for debugging or visual effect)
+//---------------------------------------------------------
+void GameplayState::RenderGrid(const sf::View& camera) {
+    gridBackground.submit(game->GetRenderQueue(), RenderQueue::Layer::Background, worldViewId, camera);
 }
 
 //---------------------------------------------------------
@@ -333,16 +481,14 @@ void GameplayState::NextLevel() {
     game->GetCurrentLevel() += 1;
     game->GetEnemiesPerWave() += 2;
     StartNextLevelTimer(5.0f);
-    if (game->IsHost()) {
-        game->GetNetworkManager()->SyncEnemiesFull();
-    }
 }
 
 void GameplayState::HandleStorePurchase() {
     sf::Vector2i mousePos = sf::Mouse::getPosition(game->GetWindow());
     sf::Vector2f viewPos = game->GetWindow().mapPixelToCoords(mousePos, game->GetView());
-    const sf::Text& buttonText = game->GetHUD().getElements().at("speedBoostButton").text;
-    if (buttonText.getGlobalBounds().contains(viewPos) && game->GetLocalPlayer().money >= 50) {
+    HUD::Handle button = game->GetHUD().find("speedBoostButton"_hud);
+    if (button == HUD::InvalidHandle) return;
+    if (game->GetHUD().getElementBounds(button).contains(viewPos) && game->GetLocalPlayer().money >= 50) {
         Player& localPlayer = game->GetLocalPlayer();
         localPlayer.money -= 50;
         localPlayer.speed += 50.f;
@@ -355,29 +501,12 @@ void GameplayState::HandleStorePurchase() {
 // Enemy Vertex Update for Batch Rendering
 //---------------------------------------------------------
 void GameplayState::updateEnemyVertices() {
-    enemyVertices.clear();
-    enemyVertices.setPrimitiveType(sf::Quads);
-    enemyVertices.resize(game->GetEnemies().size() * 4);
-    size_t i = 0;
-    for (const auto& [id, enemy] : game->GetEnemies()) {
-        if (enemy.health <= 0 || std::isnan(enemy.renderedX) || std::isnan(enemy.renderedY))
-            continue;
-        float x = enemy.renderedX;
-        float y = enemy.renderedY;
-        if (enemy.isSplitting && enemy.shakeTimer > 0) {
-            float shake = enemy.shakeTimer / enemy.shakeDuration;
-            x += (rand() % 10 - 5) * shake;
-            y += (rand() % 10 - 5) * shake;
-        }
-        float w = enemy.size.x, h = enemy.size.y;
-        sf::Color c = enemy.color;
-        enemyVertices[i * 4 + 0].position = {x, y};
-        enemyVertices[i * 4 + 1].position = {x + w, y};
-        enemyVertices[i * 4 + 2].position = {x + w, y + h};
-        enemyVertices[i * 4 + 3].position = {x, y + h};
-        for (int j = 0; j < 4; ++j)
-            enemyVertices[i * 4 + j].color = c;
-        ++i;
+    enemyBuffer.beginFrame();
+    auto& enemies = game->GetEnemies();
+    for (uint64_t id : visibleEnemyIds) {
+        auto it = enemies.find(id);
+        if (it != enemies.end())
+            enemyBuffer.submit(it->second);
     }
-    enemyVertices.resize(i * 4); // Trim unused vertices
+    enemyBuffer.endFrame();
 }
@@ -6,6 +6,13 @@
 #include <cmath>
 #include <steam/steam_api.h>
 #include "../Utils/Config.h"
+#include "../Rendering/EntityBatch.h"
+#include "../Rendering/EnemyRenderBuffer.h"
+#include "../Rendering/GridBackground.h"
+#include "../Rendering/RenderSnapshot.h"
+#include "../Rendering/ParticleSystem.h"
+#include "../Rendering/Minimap.h"
+#include "../Hud/HudModel.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -32,6 +39,7 @@ public:
      * @param game Pointer to the main CubeGame instance.
      */
     GameplayState(CubeGame* game);
+    ~GameplayState() override;
 
     /// Update game logic.
     void Update(float dt) override;
@@ -42,10 +50,19 @@ public:
     /// Process input events.
     void ProcessEvent(const sf::Event& event) override;
 
+    /// Spawn a particle effect at a world position.
+    void SpawnEffect(ParticleEffect effect, const sf::Vector2f& position, const sf::Color& color);
+
+    /// Spawn a particle effect centred on an enemy, in its colour.
+    void SpawnEnemyEffect(ParticleEffect effect, const Enemy& enemy);
+
+    /// Fill a render snapshot with the visible state of the last tick (render-thread path).
+    void PublishSnapshot(RenderSnapshot& snapshot);
+
     /// Spawn enemies (wrapper function, if needed).
     void SpawnEnemies();
 
-    /// Update enemy vertex data for batch rendering.
+    /// Refresh the persistent enemy vertex buffer (only changed quads are rewritten).
     void updateEnemyVertices();
     void Interpolate(float alpha) override; // Add interpolation method
 
@@ -56,7 +73,7 @@ public:
     void CheckAndAdvanceLevel();
 
     // Public state variables.
-    sf::VertexArray enemyVertices; ///< Vertex array for enemy rendering.
+    EnemyRenderBuffer enemyBuffer; ///< Persistent enemy vertex buffer (main-thread path; RenderThread owns its own).
     bool storeVisible = false;     ///< Flag indicating whether the store UI is visible.
     float nextLevelTimer;          ///< Timer for the next wave.
     bool timerActive = false;      ///< Indicates if the next-level timer is active.
@@ -77,11 +94,15 @@ private:
     //===============================================================
     // Rendering Helper Methods
     //===============================================================
-    void RenderPlayers();   ///< Draw all player entities.
-    void RenderEnemies();   ///< Draw all enemy entities.
-    void RenderBullets();   ///< Draw all bullet entities.
+    void RenderPlayers();   ///< Append visible player entities to the entity batch.
+    void RenderEnemies();   ///< Queue visible enemy entities.
+    void RenderBullets();   ///< Append visible bullet entities to the entity batch.
+    void RenderEffects();   ///< Queue visible particles.
+    void RenderMinimap();   ///< Queue the density minimap.
+    void CullWorld(const sf::View& camera); ///< Query the spatial index for entities inside the view.
     void RenderStoreUI();   ///< Draw store UI elements.
-    void RenderGrid(sf::RenderWindow& window, const sf::View& camera); ///< Draw grid overlay.
+    void RenderGrid(const sf::View& camera); ///< Queue the grid overlay.
+    void ReportRenderStats();  ///< Periodically log culling and buffer counters (debug mode).
 
     //===============================================================
     // Action Helper Methods
@@ -118,8 +139,30 @@ private:
     const float enemyUpdateRate = 0.2f; ///< Interval for enemy update sync.
     float gridSize = 50.f;        ///< Grid square size for rendering grid overlay.
     bool showHealthBars = false;  ///< Option to display enemy health bars.
-    sf::RectangleShape arrowShape; ///< Optional shape for directional indicators.
+
+    //===============================================================
+    // Batched Rendering & Render Statistics
+    //===============================================================
+    EntityBatch entityBatch;          ///< Shared vertex stream for players and bullets.
+    ParticleSystem particles;         ///< Hit, split and death effects.
+    Minimap minimap;                  ///< Enemy density map built from the collision grid.
+    HUDModel hudModel;                ///< HUD values with dirty tracking.
+    GridBackground gridBackground;    ///< Cached background grid, rebuilt only on resize/zoom.
+    unsigned int drawCallCount = 0;   ///< Draw calls issued by the last frame.
+    RenderQueue::ViewId worldViewId = 0; ///< Camera view id in this frame's render queue.
+    sf::FloatRect cullRect;           ///< View rectangle (plus margin) used for culling.
+    std::vector<uint64_t> visibleEnemyIds;  ///< Enemies inside cullRect this frame.
+    std::vector<uint64_t> visibleBulletIds; ///< Bullets inside cullRect this frame.
+    size_t visiblePlayerCount = 0;    ///< Players inside cullRect this frame.
+    sf::Clock statsReportClock;             ///< Clock driving the periodic stats report.
     int spectatedPlayerIndex = -1; ///< Index of player being spectated (if applicable).
+
+    //===============================================================
+    // Camera & Snapshot State
+    //===============================================================
+    sf::Vector2f cameraCenter;          ///< Camera centre after the last tick.
+    sf::Vector2f previousCameraCenter;  ///< Camera centre after the tick before.
+    uint32_t snapshotTick = 0;          ///< Snapshots published (drives Splitter shake).
 };
 
 #endif // GAMEPLAYSTATE_H
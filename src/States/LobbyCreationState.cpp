@@ -5,11 +5,13 @@
 // Constructor: Initialize lobby creation UI and HUD elements
 //---------------------------------------------------------
 LobbyCreationState::LobbyCreationState(CubeGame* game) : State(game) {
+    scene.addRect(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, 60.f), sf::Color(70, 130, 180)); // Steel blue header.
+
     // Clear any existing lobby name input.
     game->GetLobbyNameInput().clear();
 
     // Update HUD prompt for lobby name entry.
-    game->GetHUD().updateText("lobbyPrompt", "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
+    game->GetHUD().updateText("lobbyPrompt"_hud, "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
     std::cout << "[DEBUG] LobbyCreationState constructed\n";
 
     // Add HUD element for lobby name prompt.
@@ -25,7 +27,7 @@ LobbyCreationState::LobbyCreationState(CubeGame* game) : State(game) {
         32, sf::Vector2f(SCREEN_WIDTH * 0.4f, 20.f),
         GameState::LobbyCreation, 
         HUD::RenderMode::ScreenSpace, true);
-    game->GetHUD().updateBaseColor("status", sf::Color::Black);
+    game->GetHUD().updateBaseColor("status"_hud, sf::Color::Black);
 }
 
 //---------------------------------------------------------
@@ -44,20 +46,22 @@ void LobbyCreationState::Render() {
         return;
     }
 
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
+    RenderQueue::ViewId screenView = queue.registerView(game->GetWindow().getDefaultView());
+
+    // Cached static panels (header bar).
+    scene.submit(queue, RenderQueue::Layer::UIBackground, screenView, game->GetWindow().getDefaultView());
+
+    // HUD elements (e.g., "lobbyPrompt" and "status").
+    game->GetHUD().submit(queue, game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
+
     // Clear window with white background.
-    game->GetWindow().clear(sf::Color::White);
-    game->GetWindow().setView(game->GetWindow().getDefaultView());
-
-    // Draw a header bar.
-    sf::RectangleShape headerBar;
-    headerBar.setSize(sf::Vector2f(SCREEN_WIDTH, 60.f));
-    headerBar.setFillColor(sf::Color(70, 130, 180)); // Steel blue color.
-    headerBar.setPosition(0.f, 0.f);
-    game->GetWindow().draw(headerBar);
-
-    // Render HUD elements (e.g., "lobbyPrompt" and "status").
-    game->GetHUD().render(game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
-    game->GetWindow().display();
+    gfx.clear(sf::Color::White);
+    queue.flush(gfx);
+    gfx.display();
 }
 
 //---------------------------------------------------------
@@ -78,20 +82,20 @@ void LobbyCreationState::ProcessEvents(const sf::Event& event) {
                 CreateLobby(game->GetLobbyNameInput());
                 std::cout << "[DEBUG] Creating lobby: " << game->GetLobbyNameInput() << "\n";
             } else {
-                game->GetHUD().updateText("lobbyPrompt", 
+                game->GetHUD().updateText("lobbyPrompt"_hud, 
                     "Lobby name cannot be empty! (Enter to Create, ESC to Cancel): ");
             }
         }
         // Handle Backspace: remove last character.
         else if (event.text.unicode == '\b' && !game->GetLobbyNameInput().empty()) {
             game->GetLobbyNameInput().pop_back();
-            game->GetHUD().updateText("lobbyPrompt", 
+            game->GetHUD().updateText("lobbyPrompt"_hud, 
                 "Enter Lobby Name (Press Enter to Create, ESC to Cancel): " + game->GetLobbyNameInput());
         }
         // Handle printable ASCII characters.
         else if (event.text.unicode >= 32 && event.text.unicode < 128) {
             game->GetLobbyNameInput() += static_cast<char>(event.text.unicode);
-            game->GetHUD().updateText("lobbyPrompt", 
+            game->GetHUD().updateText("lobbyPrompt"_hud, 
                 "Enter Lobby Name (Press Enter to Create, ESC to Cancel): " + game->GetLobbyNameInput());
         }
     }
@@ -115,7 +119,7 @@ void LobbyCreationState::CreateLobby(const std::string& lobbyName) {
     game->GetLobbyNameInput() = lobbyName;
 
     // Call Steam API to create a public lobby with up to 10 members.
-    SteamAPICall_t call = SteamMatchmaking()->CreateLobby(k_ELobbyTypePublic, 10);
+    SteamAPICall_t call = SteamMatchmaking()->CreateLobby(k_ELobbyTypePublic, MAX_LOBBY_MEMBERS);
     if (call == k_uAPICallInvalid) {
         std::cerr << "[LOBBY] CreateLobby call failed immediately.\n";
         game->SetCurrentState(GameState::MainMenu);
@@ -2,6 +2,7 @@
 #define LOBBYCREATIONSTATE_H
 
 #include "State.h"
+#include "../Rendering/UIScene.h"
 
 /**
  * @brief State for creating a new lobby.
@@ -26,6 +27,7 @@ public:
     void ProcessEvent(const sf::Event& event) override;
 
 private:
+    UIScene scene; ///< Retained static panels, cached between frames.
     /// Internal handler for processing SFML events.
     void ProcessEvents(const sf::Event& event);
     
@@ -6,8 +6,7 @@
 // Constructor: Initiate lobby search and set up HUD elements.
 //---------------------------------------------------------
 LobbySearchState::LobbySearchState(CubeGame* game) : State(game) {
-    // Start searching for lobbies.
-    SearchLobbies();
+    scene.addRect(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, 60.f), sf::Color(70, 130, 180)); // Steel blue header.
 
     // Add HUD element to show search status.
     game->GetHUD().addElement("searchStatus", "Searching...", 18, 
@@ -20,38 +19,29 @@ LobbySearchState::LobbySearchState(CubeGame* game) : State(game) {
                                GameState::LobbySearch, 
                                HUD::RenderMode::ScreenSpace, false);
     // Reset lobby list display text.
-    game->GetHUD().updateText("lobbyList", "Available Lobbies:\n");
+    game->GetHUD().updateText("lobbyList"_hud, "Available Lobbies:\n");
+
+    // Start background refreshing; results cached from an earlier visit show immediately.
+    SearchLobbies();
+    UpdateLobbyListDisplay();
 }
 
 //---------------------------------------------------------
-// SearchLobbies: Request available lobbies from Steam.
+// SearchLobbies: Start the background lobby browser.
 //---------------------------------------------------------
 void LobbySearchState::SearchLobbies() {
     if (game->IsInLobby()) return; // Do not search if already in a lobby.
-    game->GetLobbyList().clear();
-
-    // Filter lobbies for this game using the game's GAME_ID.
-    SteamMatchmaking()->AddRequestLobbyListStringFilter("game_id", CubeGame::GAME_ID, k_ELobbyComparisonEqual);
-    SteamMatchmaking()->AddRequestLobbyListStringFilter("name", "", k_ELobbyComparisonNotEqual);
-
-    // Request the lobby list.
-    SteamAPICall_t call = SteamMatchmaking()->RequestLobbyList();
-    if (call == k_uAPICallInvalid) {
-        std::cerr << "[LOBBY] RequestLobbyList failed.\n";
-        game->GetHUD().updateText("searchStatus", "Failed to search lobbies");
-    } else {
-        game->GetHUD().updateText("searchStatus", "Searching...");
-    }
+    game->GetLobbyBrowser().start(CubeGame::GAME_ID, LobbyBrowser::clockSeconds());
 }
 
 //---------------------------------------------------------
-// Update: Refresh lobby list display if updated.
+// Update: Drive the browser and refresh the display when it changed.
 //---------------------------------------------------------
 void LobbySearchState::Update(float dt) {
-    if (game->IsLobbyListUpdated()) { 
+    LobbyBrowser& browser = game->GetLobbyBrowser();
+    browser.update(LobbyBrowser::clockSeconds());
+    if (browser.getVersion() != shownVersion || browser.hasResults() != shownResults) {
         UpdateLobbyListDisplay();
-        // Reset the update flag (ensure lobbyListUpdated is accessible)
-        game->lobbyListUpdated = false;
     }
 }
 
@@ -59,19 +49,21 @@ void LobbySearchState::Update(float dt) {
 // Render: Draw the lobby search screen.
 //---------------------------------------------------------
 void LobbySearchState::Render() {
-    game->GetWindow().clear(sf::Color::White);
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
+    RenderQueue::ViewId screenView = queue.registerView(game->GetWindow().getDefaultView());
 
-    // Draw a header bar for visual separation.
-    sf::RectangleShape headerBar;
-    headerBar.setSize(sf::Vector2f(SCREEN_WIDTH, 60.f));
-    headerBar.setFillColor(sf::Color(70, 130, 180)); // Steel blue
-    headerBar.setPosition(0.f, 0.f);
-    game->GetWindow().draw(headerBar);
+    // Cached static panels (header bar).
+    scene.submit(queue, RenderQueue::Layer::UIBackground, screenView, game->GetWindow().getDefaultView());
 
-    // Render HUD elements (search status and lobby list).
-    game->GetHUD().render(game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
+    // HUD elements (search status and lobby list).
+    game->GetHUD().submit(queue, game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
 
-    game->GetWindow().display();
+    gfx.clear(sf::Color::White);
+    queue.flush(gfx);
+    gfx.display();
 }
 
 //---------------------------------------------------------
@@ -86,11 +78,18 @@ void LobbySearchState::ProcessEvent(const sf::Event& event) {
 //---------------------------------------------------------
 void LobbySearchState::ProcessEvents(const sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
-        // If number keys (0-9) are pressed, attempt to join the corresponding lobby.
+        // If number keys (0-9) are pressed, attempt to join the corresponding lobby on this page.
         if (event.key.code >= sf::Keyboard::Num0 && event.key.code <= sf::Keyboard::Num9) {
             int index = event.key.code - sf::Keyboard::Num0;
             JoinLobbyByIndex(index);
-        } 
+        }
+        // Arrow keys and PageUp/PageDown flip through pages.
+        else if (event.key.code == sf::Keyboard::Right || event.key.code == sf::Keyboard::PageDown) {
+            game->GetLobbyBrowser().nextPage();
+        }
+        else if (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::PageUp) {
+            game->GetLobbyBrowser().prevPage();
+        }
         // Escape key returns to the main menu.
         else if (event.key.code == sf::Keyboard::Escape) {
             game->ReturnToMainMenu();
@@ -99,18 +98,41 @@ void LobbySearchState::ProcessEvents(const sf::Event& event) {
 }
 
 //---------------------------------------------------------
-// UpdateLobbyListDisplay: Refresh the HUD with lobby list info.
+// UpdateLobbyListDisplay: Refresh the HUD with the current page.
 //---------------------------------------------------------
 void LobbySearchState::UpdateLobbyListDisplay() {
-    std::string lobbyText = "Available Lobbies (Press 0-9 to join, ESC to cancel):\n";
-    const auto& lobbies = game->GetLobbyList();
-    for (size_t i = 0; i < lobbies.size() && i < 10; ++i) {
-        lobbyText += std::to_string(i) + ": " + lobbies[i].second + "\n";
+    const LobbyBrowser& browser = game->GetLobbyBrowser();
+    shownVersion = browser.getVersion();
+    shownResults = browser.hasResults();
+    shownLobbies.clear();
+
+    if (!browser.hasResults()) {
+        game->GetHUD().updateText("searchStatus"_hud, "Searching...");
+        return;
     }
-    if (lobbies.empty()) {
+    game->GetHUD().updateText("searchStatus"_hud, "Lobby Search");
+
+    std::string lobbyText = "Available Lobbies (Press 0-9 to join, Left/Right for pages, ESC to cancel):\n";
+    for (std::size_t i = 0; i < browser.getConfig().pageSize; ++i) {
+        const LobbyBrowser::Entry* entry = browser.getEntry(i);
+        if (!entry) break;
+        shownLobbies.push_back(entry->id);
+        lobbyText += std::to_string(i) + ": " + entry->name + "   " +
+                     std::to_string(entry->members) + "/" + std::to_string(entry->memberLimit);
+        if (entry->isFull())
+            lobbyText += "   full";
+        else if (entry->pingMs >= 0.f)
+            lobbyText += "   " + std::to_string(static_cast<int>(entry->pingMs + 0.5f)) + " ms";
+        else if (entry->failedPings >= browser.getConfig().maxFailedPings)
+            lobbyText += "   unreachable";
+        lobbyText += "\n";
+    }
+    if (browser.getEntries().empty()) {
         lobbyText += "No lobbies available.";
+    } else {
+        lobbyText += "Page " + std::to_string(browser.getPage() + 1) + "/" + std::to_string(browser.getPageCount());
     }
-    game->GetHUD().updateText("lobbyList", lobbyText);
+    game->GetHUD().updateText("lobbyList"_hud, lobbyText);
 }
 
 //---------------------------------------------------------
@@ -118,6 +140,7 @@ void LobbySearchState::UpdateLobbyListDisplay() {
 //---------------------------------------------------------
 void LobbySearchState::JoinLobby(CSteamID lobby) {
     if (game->IsInLobby()) return;
+    game->GetLobbyBrowser().stop();
     // Set the game as a client.
     game->SetIsHost(false);
     SteamAPICall_t call = SteamMatchmaking()->JoinLobby(lobby);
@@ -129,14 +152,14 @@ void LobbySearchState::JoinLobby(CSteamID lobby) {
 }
 
 //---------------------------------------------------------
-// JoinLobbyByIndex: Join a lobby by its index in the list.
+// JoinLobbyByIndex: Join the lobby shown at an index on screen.
 //---------------------------------------------------------
 void LobbySearchState::JoinLobbyByIndex(int index) {
-    const auto& lobbies = game->GetLobbyList();
-    if (index >= 0 && index < static_cast<int>(lobbies.size())) {
-        JoinLobby(lobbies[index].first);
+    // The browser may have changed since the page was drawn; join what the player saw.
+    if (index >= 0 && static_cast<std::size_t>(index) < shownLobbies.size()) {
+        JoinLobby(shownLobbies[index]);
     } else {
-        game->GetHUD().updateText("searchStatus", "Invalid lobby selection");
+        game->GetHUD().updateText("searchStatus"_hud, "Invalid lobby selection");
     }
 }
 void LobbySearchState::Interpolate(float alpha) {
@@ -2,12 +2,15 @@
 #define LOBBYSEARCHSTATE_H
 
 #include "State.h"
+#include <vector>
+#include "../Rendering/UIScene.h"
 
 /**
  * @brief State for searching and joining lobbies.
  *
- * Displays a list of available lobbies and allows the user to select one
- * using number keys. Also handles returning to the main menu.
+ * Displays a page of the cached lobby browser (sorted by measured host
+ * latency) and allows the user to select one using number keys. Also
+ * handles paging and returning to the main menu.
  */
 class LobbySearchState : public State {
 public:
@@ -27,19 +30,23 @@ public:
     void ProcessEvent(const sf::Event& event) override;
 
 private:
+    UIScene scene; ///< Retained static panels, cached between frames.
+    uint32_t shownVersion = ~0u; ///< LobbyBrowser version last written to the HUD.
+    bool shownResults = false;
+    std::vector<CSteamID> shownLobbies; ///< Lobby ids on the displayed page, by number key.
     /// Internal method to process events.
     void ProcessEvents(const sf::Event& event);
 
     /// Update the HUD element displaying the lobby list.
     void UpdateLobbyListDisplay();
 
-    /// Initiate a lobby search via the Steam API.
+    /// Start background lobby refreshing.
     void SearchLobbies();
 
     /// Attempt to join a specific lobby.
     void JoinLobby(CSteamID lobby);
 
-    /// Join a lobby by its index in the displayed list.
+    /// Join the lobby displayed at an index on the page.
     void JoinLobbyByIndex(int index);
 };
 
@@ -8,8 +8,12 @@
 // Constructor: Set up lobby HUD elements and player slots.
 //---------------------------------------------------------
 LobbyState::LobbyState(CubeGame* game)
-    : State(game)
+    : State(game),
+      // Virtualised member list below the header; only the rows that fit exist.
+      roster(game->GetHUD(), scene, sf::FloatRect(SCREEN_WIDTH * 0.5f - 330.f, 120.f, 660.f, SCREEN_HEIGHT - 260.f))
 {
+    scene.addRect(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, 60.f), sf::Color(70, 130, 180)); // Steel blue header.
+
     // Retrieve lobby name from Steam; default to "Lobby" if empty.
     std::string lobbyName = SteamMatchmaking()->GetLobbyData(game->GetLobbyID(), "name");
     if (lobbyName.empty()) {
@@ -17,7 +21,7 @@ LobbyState::LobbyState(CubeGame* game)
     }
 
     // Add header element with lobby name.
-    game->GetHUD().addElement(
+    HUD::Handle header = game->GetHUD().addElement(
          "lobbyHeader",
          lobbyName,
          32, 
@@ -26,75 +30,10 @@ LobbyState::LobbyState(CubeGame* game)
          HUD::RenderMode::ScreenSpace,
          true
     );
-    game->GetHUD().updateBaseColor("lobbyHeader", sf::Color::White);
-
-    // Create 12 player slot placeholders arranged in a 3×4 grid.
-    const int rows = 4;
-    const int cols = 3;
-    const float slotWidth  = 220.f;
-    const float slotHeight = 60.f;
-    const float spacing    = 40.f;
-
-    float totalWidth  = cols * slotWidth + (cols - 1) * spacing;
-    float totalHeight = rows * slotHeight + (rows - 1) * spacing;
-
-    float xStart = (SCREEN_WIDTH  - totalWidth ) * 0.5f;
-    float yStart = 120.f; // Gap below header
-
-    int slotIndex = 0;
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            float xPos = xStart + c * (slotWidth + spacing);
-            float yPos = yStart + r * (slotHeight + spacing);
-
-            // Configure slot background.
-            sf::RectangleShape& rect = m_playerSlotRects[slotIndex];
-            rect.setSize(sf::Vector2f(slotWidth, slotHeight));
-            rect.setFillColor(sf::Color(100, 149, 237)); // CornflowerBlue.
-            rect.setOutlineColor(sf::Color::Black);
-            rect.setOutlineThickness(2.f);
-            rect.setPosition(xPos, yPos);
-
-            // Add HUD element for player's name in this slot.
-            {
-                std::string nameId = "playerNameSlot" + std::to_string(slotIndex);
-                float nameX = xPos + slotWidth * 0.3f;
-                float nameY = yPos + slotHeight * 0.3f;
-                game->GetHUD().addElement(
-                    nameId,
-                    "Empty", 
-                    22,
-                    sf::Vector2f(nameX, nameY),
-                    GameState::Lobby,
-                    HUD::RenderMode::ScreenSpace,
-                    true
-                );
-                game->GetHUD().updateBaseColor(nameId, sf::Color::Black);
-            }
-
-            // Add HUD element for player's ready status in this slot.
-            {
-                std::string readyId = "playerReadySlot" + std::to_string(slotIndex);
-                float readyX = xPos + slotWidth * 0.3f;
-                float readyY = yPos + slotHeight * 0.6f;
-                game->GetHUD().addElement(
-                    readyId,
-                    "",  // Will be set to "Ready"/"Not Ready"
-                    20,
-                    sf::Vector2f(readyX, readyY),
-                    GameState::Lobby,
-                    HUD::RenderMode::ScreenSpace,
-                    true
-                );
-                game->GetHUD().updateBaseColor(readyId, sf::Color::Black);
-            }
-
-            ++slotIndex;
-        }
-    }
+    game->GetHUD().updateBaseColor(header, sf::Color::White);
 
     // Add HUD prompts near the bottom.
-    game->GetHUD().addElement(
+    startGameText = game->GetHUD().addElement(
         "startGame",
         "",
         24,
@@ -103,9 +42,9 @@ LobbyState::LobbyState(CubeGame* game)
         HUD::RenderMode::ScreenSpace,
         true
     );
-    game->GetHUD().updateBaseColor("startGame", sf::Color::Black);
+    game->GetHUD().updateBaseColor(startGameText, sf::Color::Black);
 
-    game->GetHUD().addElement(
+    returnMainText = game->GetHUD().addElement(
         "returnMain",
         "",
         24,
@@ -114,7 +53,7 @@ LobbyState::LobbyState(CubeGame* game)
         HUD::RenderMode::ScreenSpace,
         true
     );
-    game->GetHUD().updateBaseColor("returnMain", sf::Color::Black);
+    game->GetHUD().updateBaseColor(returnMainText, sf::Color::Black);
 }
 
 //---------------------------------------------------------
@@ -140,88 +79,58 @@ void LobbyState::Update(float dt)
     // For non-host clients, send PLAYER_LOADED message once when fully loaded.
     if (!game->IsHost() && IsFullyLoaded() && !loadedMessageSent) {
         loadedMessageSent = true;
-        std::string loadedMsg = "PLAYER_LOADED|" + std::to_string(game->GetLocalPlayer().steamID.ConvertToUint64());
-        const char* hostStr = SteamMatchmaking()->GetLobbyData(game->GetLobbyID(), "host_steam_id");
-        if (hostStr && *hostStr) {
-            CSteamID hostID(std::stoull(hostStr));
-            game->GetNetworkManager()->sendMessage(hostID, loadedMsg);
-            std::cout << "[DEBUG] Client sent PLAYER_LOADED message to host: " << loadedMsg << "\n";
+        Wire::PlayerLoaded loaded;
+        loaded.player = game->GetLocalPlayer().steamID;
+        CSteamID hostID = game->GetNetworkManager()->lobbyHost();
+        if (hostID.IsValid()) {
+            game->GetNetworkManager()->sendMessage(hostID, loaded);
+            std::cout << "[DEBUG] Client sent PlayerLoaded message to host for " << loaded.player.ConvertToUint64() << "\n";
         }
     }
 
-    // Assign up to 12 players to the 12 slots.
-    int i = 0;
-    for (auto& playerPair : game->GetPlayers()) {
-        if (i >= 12) break;
-
-        const auto& player = playerPair.second;
-        const char* steamName = (SteamFriends()) ? SteamFriends()->GetFriendPersonaName(player.steamID) : "Unknown";
-
-        // Update HUD for player's name.
-        std::string nameId = "playerNameSlot" + std::to_string(i);
-        game->GetHUD().updateText(nameId, steamName);
-
-        // Update HUD for player's ready status.
-        std::string readyId = "playerReadySlot" + std::to_string(i);
-        game->GetHUD().updateText(readyId, player.ready ? "Ready" : "Not Ready");
-
-        ++i;
-    }
-
-    // Clear remaining slots.
-    for (; i < 12; ++i)
-    {
-        std::string nameId  = "playerNameSlot" + std::to_string(i);
-        std::string readyId = "playerReadySlot" + std::to_string(i);
-        game->GetHUD().updateText(nameId, "Empty");
-        game->GetHUD().updateText(readyId, "");
-    }
+    // Rows are only re-bound when membership, names or the scroll offset change.
+    roster.sync(game->GetLobbyMembers(), game->GetPersonaNames());
 
     // Set prompts based on host status.
-    if (game->GetLocalPlayer().steamID == SteamMatchmaking()->GetLobbyOwner(game->GetLobbyID()))
+    if (game->GetLobbyMembers().isOwner(game->GetLocalPlayer().steamID))
     {
-        game->GetHUD().updateText("startGame", "Press S to Start Game (Host Only)");
-        game->GetHUD().updateText("returnMain", "Press M to Return to Main Menu");
+        game->GetHUD().updateText(startGameText, "Press S to Start Game (Host Only)");
+        game->GetHUD().updateText(returnMainText, "Press M to Return to Main Menu");
     }
     else
     {
-        game->GetHUD().updateText("startGame", "");
-        game->GetHUD().updateText("returnMain", "Press M to Return to Main Menu");
+        game->GetHUD().updateText(startGameText, "");
+        game->GetHUD().updateText(returnMainText, "Press M to Return to Main Menu");
     }
 }
 
 //---------------------------------------------------------
-// Render: Draw the lobby UI including header, player slots, and HUD.
+// Render: Draw the lobby UI including header, roster rows, and HUD.
 //---------------------------------------------------------
 void LobbyState::Render()
 {
-    // Clear window.
-    game->GetWindow().clear(sf::Color::White);
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
+    RenderQueue::ViewId worldView = queue.registerView(game->GetWindow().getView());
+    RenderQueue::ViewId screenView = queue.registerView(game->GetWindow().getDefaultView());
 
     // Optionally draw in-world player shapes.
     for (const auto& player : game->GetPlayers()) {
-        game->GetWindow().draw(player.second.shape);
+        queue.submitDrawable(RenderQueue::Layer::World, worldView, player.second.shape);
     }
 
-    // Set view to default for UI rendering.
-    game->GetWindow().setView(game->GetWindow().getDefaultView());
-
-    // Draw header bar.
-    sf::RectangleShape headerBar;
-    headerBar.setSize(sf::Vector2f(SCREEN_WIDTH, 60.f));
-    headerBar.setFillColor(sf::Color(70, 130, 180)); // Steel blue.
-    headerBar.setPosition(0.f, 0.f);
-    game->GetWindow().draw(headerBar);
+    // Cached static panels (header bar and roster row frames), above the
+    // world shapes and below the HUD text.
+    scene.submit(queue, RenderQueue::Layer::UIBackground, screenView, game->GetWindow().getDefaultView());
 
-    // Draw all player slot rectangles.
-    for (auto& rect : m_playerSlotRects) {
-        game->GetWindow().draw(rect);
-    }
-
-    // Render HUD elements.
-    game->GetHUD().render(game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
+    // HUD elements.
+    game->GetHUD().submit(queue, game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
 
-    game->GetWindow().display();
+    gfx.clear(sf::Color::White);
+    queue.flush(gfx);
+    gfx.display();
 }
 
 //---------------------------------------------------------
@@ -237,6 +146,8 @@ void LobbyState::ProcessEvent(const sf::Event& event)
 //---------------------------------------------------------
 void LobbyState::ProcessEvents(const sf::Event& event)
 {
+    roster.handleEvent(event);
+
     if (event.type == sf::Event::KeyPressed)
     {
         // Toggle ready state when "R" is pressed.
@@ -246,7 +157,7 @@ void LobbyState::ProcessEvents(const sf::Event& event)
         }
         // Start game (host only) when "S" is pressed.
         else if (event.key.code == sf::Keyboard::S &&
-                 game->GetLocalPlayer().steamID == SteamMatchmaking()->GetLobbyOwner(game->GetLobbyID()))
+                 game->GetLobbyMembers().isOwner(game->GetLocalPlayer().steamID))
         {
             if(game->GetPlayersAreLoaded() == false){
                 std::cout << "[DEBUG] Not all players are loaded \n";
@@ -276,39 +187,31 @@ void LobbyState::UpdateLobbyMembers()
 {
     if (!game->IsInLobby()) return;
 
-    int memberCount = SteamMatchmaking()->GetNumLobbyMembers(game->GetLobbyID());
+    // The cache is maintained by lobby callbacks; nothing to do until it changes.
+    const LobbyMembershipCache& members = game->GetLobbyMembers();
+    if (members.getVersion() == syncedMembersVersion) return;
+    syncedMembersVersion = members.getVersion();
 
-    // Add new players not yet in the list.
-    for (int i = 0; i < memberCount; ++i)
+    // Add new players and copy ready flags.
+    auto& players = game->GetPlayers();
+    for (const LobbyMembershipCache::Member& member : members.getMembers())
     {
-        CSteamID member = SteamMatchmaking()->GetLobbyMemberByIndex(game->GetLobbyID(), i);
-        if (!game->GetPlayers().count(member))
+        auto it = players.find(member.id);
+        if (it == players.end())
         {
             Player p;
             p.initialize();
-            p.steamID = member;
-            game->GetPlayers()[member] = p;
+            p.steamID = member.id;
+            it = players.emplace(member.id, p).first;
         }
-
-        // Update ready status from lobby data.
-        const char* readyState = SteamMatchmaking()->GetLobbyMemberData(game->GetLobbyID(), member, "ready");
-        game->GetPlayers()[member].ready = (readyState && std::string(readyState) == "1");
+        it->second.ready = member.ready;
     }
 
     // Remove players who have left the lobby.
-    for (auto it = game->GetPlayers().begin(); it != game->GetPlayers().end();)
+    for (auto it = players.begin(); it != players.end();)
     {
-        bool found = false;
-        for (int i = 0; i < memberCount; ++i)
-        {
-            if (SteamMatchmaking()->GetLobbyMemberByIndex(game->GetLobbyID(), i) == it->first)
-            {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
-            it = game->GetPlayers().erase(it);
+        if (!members.contains(it->first))
+            it = players.erase(it);
         else
             ++it;
     }
@@ -2,13 +2,14 @@
 #define LOBBYSTATE_H
 
 #include "State.h"
+#include "../Rendering/UIScene.h"
+#include "../Hud/LobbyRoster.h"
 #include "../Core/CubeGame.h"
 #include <SFML/Graphics.hpp>
-#include <array>
 /**
  * @brief Manages the lobby screen.
  *
- * Displays a header, player slots, and prompts for starting the game or returning to the main menu.
+ * Displays a header, a scrollable member roster, and prompts for starting the game or returning to the main menu.
  */
 class LobbyState : public State {
 public:
@@ -29,9 +30,13 @@ public:
     bool IsFullyLoaded();
 
 private:
+    UIScene scene; ///< Retained static panels, cached between frames.
     bool loadedMessageSent = false; ///< Flag to ensure PLAYER_LOADED message is sent once.
 
-    std::array<sf::RectangleShape, 12> m_playerSlotRects; ///< Rectangles for up to 12 player slots.
+    LobbyRoster roster; ///< Virtualised member list (declared after scene, which it draws into).
+    HUD::Handle startGameText = HUD::InvalidHandle;
+    HUD::Handle returnMainText = HUD::InvalidHandle;
+    uint32_t syncedMembersVersion = ~0u; ///< LobbyMembershipCache version last copied into the player map.
     
     /// Internal event processing.
     void ProcessEvents(const sf::Event& event);
@@ -6,12 +6,14 @@
 // Constructor: Set up HUD elements and invisible button areas.
 //---------------------------------------------------------
 MainMenuState::MainMenuState(CubeGame* game) : State(game) {
+    scene.addRect(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, 60.f), sf::Color(70, 130, 180)); // Steel blue header.
+
     std::cout << "[DEBUG] MainMenuState constructor called\n";
 
     // Clear any existing text for title, create, and search options.
-    game->GetHUD().updateText("title", "");
-    game->GetHUD().updateText("createLobby", "");
-    game->GetHUD().updateText("searchLobby", "");
+    game->GetHUD().updateText("title"_hud, "");
+    game->GetHUD().updateText("createLobby"_hud, "");
+    game->GetHUD().updateText("searchLobby"_hud, "");
 
     // Add header text ("status") with black text on a steel blue header.
     game->GetHUD().addElement(
@@ -23,7 +25,7 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
         HUD::RenderMode::ScreenSpace, 
         true
     );
-    game->GetHUD().updateBaseColor("status", sf::Color::Black);
+    game->GetHUD().updateBaseColor("status"_hud, sf::Color::Black);
 
     // Add "Leave Lobby" prompt.
     game->GetHUD().addElement(
@@ -35,7 +37,7 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
         HUD::RenderMode::ScreenSpace, 
         true
     );
-    game->GetHUD().updateBaseColor("leaveLobby", sf::Color::Black);
+    game->GetHUD().updateBaseColor("leaveLobby"_hud, sf::Color::Black);
 
     // Add "Create Lobby" option.
     game->GetHUD().addElement(
@@ -47,7 +49,7 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
         HUD::RenderMode::ScreenSpace, 
         true
     );
-    game->GetHUD().updateBaseColor("createLobbyText", sf::Color::Black);
+    game->GetHUD().updateBaseColor("createLobbyText"_hud, sf::Color::Black);
 
     // Add "Search Lobbies" option.
     game->GetHUD().addElement(
@@ -59,7 +61,7 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
         HUD::RenderMode::ScreenSpace, 
         true
     );
-    game->GetHUD().updateBaseColor("searchLobbiesText", sf::Color::Black);
+    game->GetHUD().updateBaseColor("searchLobbiesText"_hud, sf::Color::Black);
 
     // Add "Exit Game" option.
     game->GetHUD().addElement(
@@ -71,7 +73,7 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
         HUD::RenderMode::ScreenSpace, 
         true
     );
-    game->GetHUD().updateBaseColor("exitGameText", sf::Color::Black);
+    game->GetHUD().updateBaseColor("exitGameText"_hud, sf::Color::Black);
 
     // Set up invisible clickable areas.
     createLobbyButton.setSize(sf::Vector2f(300.f, 40.f));
@@ -92,20 +94,20 @@ MainMenuState::MainMenuState(CubeGame* game) : State(game) {
 void MainMenuState::Update(float dt) {
     // Update header status.
     if (!game->IsSteamInitialized()) {
-        game->GetHUD().updateText("status", "Loading Steam... please wait");
+        game->GetHUD().updateText("status"_hud, "Loading Steam... please wait");
     } else {
         std::string status = "Main Menu";
         if (game->IsInLobby()) {
             status += " (In Lobby)";
         }
-        game->GetHUD().updateText("status", status);
+        game->GetHUD().updateText("status"_hud, status);
     }
 
     // Show "Leave Lobby" prompt if currently in a lobby.
     if (game->IsInLobby()) {
-        game->GetHUD().updateText("leaveLobby", "Press ESC to Leave Lobby");
+        game->GetHUD().updateText("leaveLobby"_hud, "Press ESC to Leave Lobby");
     } else {
-        game->GetHUD().updateText("leaveLobby", "");
+        game->GetHUD().updateText("leaveLobby"_hud, "");
     }
 }
 
@@ -115,19 +117,21 @@ void MainMenuState::Update(float dt) {
 void MainMenuState::Render() {
     if (game->GetCurrentState() != GameState::MainMenu) return;
 
-    game->GetWindow().clear(sf::Color::White);
-    game->GetWindow().setView(game->GetWindow().getDefaultView());
+    RenderStats& gfx = game->GetRenderStats();
+    gfx.beginFrame();
+    RenderQueue& queue = game->GetRenderQueue();
+    queue.begin();
+    RenderQueue::ViewId screenView = queue.registerView(game->GetWindow().getDefaultView());
+
+    // Cached static panels (header bar).
+    scene.submit(queue, RenderQueue::Layer::UIBackground, screenView, game->GetWindow().getDefaultView());
 
-    // Draw header bar.
-    sf::RectangleShape headerBar;
-    headerBar.setSize(sf::Vector2f(SCREEN_WIDTH, 60.f));
-    headerBar.setFillColor(sf::Color(70, 130, 180)); // Steel blue.
-    headerBar.setPosition(0.f, 0.f);
-    game->GetWindow().draw(headerBar);
+    // HUD.
+    game->GetHUD().submit(queue, game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
 
-    // Render HUD.
-    game->GetHUD().render(game->GetWindow(), game->GetWindow().getDefaultView(), game->GetCurrentState());
-    game->GetWindow().display();
+    gfx.clear(sf::Color::White);
+    queue.flush(gfx);
+    gfx.display();
 }
 
 //---------------------------------------------------------
@@ -144,13 +148,13 @@ void MainMenuState::ProcessEvents(const sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Num1 && !game->IsInLobby()) {
             if (!game->IsSteamInitialized()) {
-                game->GetHUD().updateText("status", "Waiting for Steam handshake. Please try again soon");
+                game->GetHUD().updateText("status"_hud, "Waiting for Steam handshake. Please try again soon");
                 return;
             }
             // Enter Lobby Creation state.
             game->SetCurrentState(GameState::LobbyCreation);
             game->GetLobbyNameInput().clear();
-            game->GetHUD().updateText("lobbyPrompt", "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
+            game->GetHUD().updateText("lobbyPrompt"_hud, "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
             std::cout << "[DEBUG] Entering Lobby Creation state\n";
         }
         else if (event.key.code == sf::Keyboard::Num2 && !game->IsInLobby()) {
@@ -161,6 +165,8 @@ void MainMenuState::ProcessEvents(const sf::Event& event) {
         else if (event.key.code == sf::Keyboard::Escape && game->IsInLobby()) {
             // Leave lobby.
             SteamMatchmaking()->LeaveLobby(game->GetLobbyID());
+            game->GetLobbyMembers().clear();
+            game->GetNetworkManager()->leftLobby();
             game->SetCurrentState(GameState::MainMenu);
             game->GetPlayers().clear();
             std::cout << "[DEBUG] Left lobby from main menu.\n";
@@ -176,13 +182,13 @@ void MainMenuState::ProcessEvents(const sf::Event& event) {
         if (!game->IsInLobby()) {
             if (createLobbyButton.getGlobalBounds().contains(worldPos)) {
                 if (!game->IsSteamInitialized()) {
-                    game->GetHUD().updateText("status", "Waiting for Steam handshake. Please try again soon");
+                    game->GetHUD().updateText("status"_hud, "Waiting for Steam handshake. Please try again soon");
                     return;
                 }
                 // Enter Lobby Creation state via mouse click.
                 game->SetCurrentState(GameState::LobbyCreation);
                 game->GetLobbyNameInput().clear();
-                game->GetHUD().updateText("lobbyPrompt", "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
+                game->GetHUD().updateText("lobbyPrompt"_hud, "Enter Lobby Name (Press Enter to Create, ESC to Cancel): ");
                 std::cout << "[DEBUG] Clicked Create Lobby: Entering Lobby Creation state\n";
             } 
             else if (searchLobbiesButton.getGlobalBounds().contains(worldPos)) {
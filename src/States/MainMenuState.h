@@ -2,6 +2,7 @@
 #define MAINMENUSTATE_H
 
 #include "State.h"
+#include "../Rendering/UIScene.h"
 #include "../Hud/Hud.h"
 
 /**
@@ -25,6 +26,7 @@ public:
     void ProcessEvent(const sf::Event& event) override;
 
 private:
+    UIScene scene; ///< Retained static panels, cached between frames.
     /// Internal method for processing events.
     void ProcessEvents(const sf::Event& event);
 
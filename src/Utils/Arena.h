@@ -0,0 +1,21 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <algorithm>
+#include "Config.h"
+
+/**
+ * @brief Keeps a simulated position inside the arena.
+ *
+ * Positions go over the wire as 16-bit offsets from ARENA_ORIGIN_X/Y, which
+ * cannot represent anything farther than about 16384 px away. Players and
+ * enemies are clamped here, inside that range, so remote peers never see an
+ * entity pinned at the edge of the encoding. Bullets are not clamped; they
+ * expire long before they could leave the range.
+ */
+inline void clampToArena(float& x, float& y) {
+    x = std::clamp(x, ARENA_ORIGIN_X - ARENA_HALF_EXTENT, ARENA_ORIGIN_X + ARENA_HALF_EXTENT);
+    y = std::clamp(y, ARENA_ORIGIN_Y - ARENA_HALF_EXTENT, ARENA_ORIGIN_Y + ARENA_HALF_EXTENT);
+}
+
+#endif // ARENA_H
@@ -8,14 +8,26 @@
 // Player configuration
 #define PLAYER_SPEED 100.0f
 #define PLAYER_HEALTH 10000
+#define PLAYER_SIZE 20.0f
 
 // Enemy configuration
 #define ENEMY_SPEED 70.0f
+#define ENEMY_TYPE_COUNT 7          // Number of Enemy::Type values; checked in Enemy.h
 
 // Bullet configuration
 #define BULLET_SPEED 400.0f
+#define BULLET_SIZE 5.0f
 
 // Spawning configuration
 #define SPAWN_RADIUS 300.0f
 
+// Lobby configuration
+#define MAX_LOBBY_MEMBERS 64
+
+// Network configuration
+#define ARENA_ORIGIN_X (SCREEN_WIDTH / 2.0f)   // Positions are quantised relative to the spawn point
+#define ARENA_ORIGIN_Y (SCREEN_HEIGHT / 2.0f)
+#define NET_POSITION_QUANTUM 0.5f              // 16-bit positions cover +-16384 px around the origin
+#define ARENA_HALF_EXTENT 16000.0f             // Players and enemies are kept this close to the origin (see Arena.h)
+
 #endif // CONFIG_H
@@ -0,0 +1,45 @@
+#ifndef FAST_HASH_H
+#define FAST_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Cheap 64-bit to 32-bit integer mix (SplitMix64 finaliser).
+ *
+ * Used where visual randomness must be deterministic and allocation-free,
+ * e.g. shake offsets that are re-evaluated every frame.
+ */
+inline uint32_t hash32(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint32_t>(x ^ (x >> 31));
+}
+
+/**
+ * @brief Deterministic jitter in [-5, 4], matching the old `rand() % 10 - 5`.
+ * @param seed Per-entity seed (usually the entity id).
+ * @param tick Animation tick; a new value every tick gives a new offset.
+ * @param axis 0 for X, 1 for Y.
+ */
+inline int hashJitter(uint64_t seed, uint32_t tick, int axis) {
+    uint32_t h = hash32(seed ^ (static_cast<uint64_t>(tick) << 32) ^ static_cast<uint64_t>(axis));
+    return static_cast<int>(h % 10u) - 5;
+}
+
+/**
+ * @brief 32-bit FNV-1a over a byte string; constexpr so literal names hash at compile time.
+ * @param s Characters to hash.
+ * @param n Number of characters.
+ */
+constexpr uint32_t fnv1a32(const char* s, std::size_t n) {
+    uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= static_cast<uint8_t>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+#endif // FAST_HASH_H
@@ -2,7 +2,9 @@
 #define STEAM_HELPERS_H
 
 #include <steam/steam_api.h>
+#include <charconv>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <unordered_map>
 
@@ -17,4 +19,19 @@ struct CSteamIDHash {
     }
 };
 
+/**
+ * @brief Parses a decimal Steam ID (e.g. the "host_steam_id" lobby data).
+ *
+ * Uses std::from_chars: no allocation and no exceptions on bad input.
+ * @return k_steamIDNil if the string is null, empty, not fully numeric or out of range.
+ */
+inline CSteamID parseSteamID(const char* s) {
+    if (!s || !*s) return k_steamIDNil;
+    const char* end = s + std::strlen(s);
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(s, end, value);
+    if (ec != std::errc() || ptr != end) return k_steamIDNil;
+    return CSteamID(static_cast<uint64>(value));
+}
+
 #endif // STEAM_HELPERS_H
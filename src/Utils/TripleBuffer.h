@@ -0,0 +1,59 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free single-producer/single-consumer triple buffer.
+ *
+ * The producer fills back() and calls publish(); the consumer calls acquire()
+ * and reads front(). Neither side ever blocks: the producer always has a free
+ * buffer to write, and the consumer always sees the most recently published
+ * value (intermediate values may be skipped).
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /// Buffer owned by the producer. Holds stale data from an earlier publish.
+    T& back() { return m_buffers[m_back]; }
+
+    /// Makes the back buffer the latest published value.
+    void publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH_BIT), std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Swaps in the latest published value, if any.
+     * @return True if front() changed.
+     */
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_acquire) & FRESH_BIT) == 0) return false;
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    /// Buffer owned by the consumer.
+    const T& front() const { return m_buffers[m_front]; }
+
+    /// Restores all buffers to T{}. Only call while neither side is active.
+    void reset() {
+        for (T& buffer : m_buffers) buffer = T{};
+        m_back = 0;
+        m_middle.store(1, std::memory_order_relaxed);
+        m_front = 2;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    T m_buffers[3];
+    uint8_t m_back = 0;                 ///< Producer-owned index.
+    std::atomic<uint8_t> m_middle{ 1 }; ///< Shared index plus "fresh" flag.
+    uint8_t m_front = 2;                ///< Consumer-owned index.
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,339 @@
+//==============================================================================
+// LobbyBrowser tests, driven by a fake matchmaking backend and a synthetic clock.
+//
+// Results are fed through onListReceived() and probe replies through onPong(),
+// exactly as the LobbyMatchList_t callback and the Pong handler would.
+//==============================================================================
+#include "../src/Networking/LobbyBrowser.h"
+#include "TestSupport.h"
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /**
+     * @brief A lobby as the fake matchmaking service lists it.
+     */
+    struct FakeLobby {
+        CSteamID id;
+        std::string name;
+        std::string host;   ///< "host_steam_id" lobby data.
+        int members = 1;
+        int memberLimit = 4;
+    };
+
+    /**
+     * @brief In-process matchmaking service: serves whatever is in `lobbies`.
+     */
+    class FakeLobbyList : public LobbyListBackend {
+    public:
+        std::vector<FakeLobby> lobbies;
+        std::string lastGameId;
+        int requests = 0;
+
+        bool requestList(const char* gameId) override {
+            lastGameId = gameId;
+            ++requests;
+            return true;
+        }
+        CSteamID getLobbyByIndex(int index) override {
+            return index >= 0 && index < static_cast<int>(lobbies.size()) ? lobbies[index].id : k_steamIDNil;
+        }
+        const char* getLobbyData(CSteamID lobby, const char* key) override {
+            const FakeLobby* l = find(lobby);
+            if (!l) return "";
+            if (std::string(key) == "name") return l->name.c_str();
+            if (std::string(key) == "host_steam_id") return l->host.c_str();
+            return "";
+        }
+        int getNumMembers(CSteamID lobby) override {
+            const FakeLobby* l = find(lobby);
+            return l ? l->members : 0;
+        }
+        int getMemberLimit(CSteamID lobby) override {
+            const FakeLobby* l = find(lobby);
+            return l ? l->memberLimit : 0;
+        }
+
+        FakeLobby* find(CSteamID lobby) {
+            for (FakeLobby& l : lobbies)
+                if (l.id == lobby) return &l;
+            return nullptr;
+        }
+        uint32_t count() const { return static_cast<uint32_t>(lobbies.size()); }
+    };
+
+    CSteamID lobbyId(uint64_t n) { return CSteamID(static_cast<uint64>(109775240000000000ull + n)); }
+    CSteamID hostId(uint64_t n) { return CSteamID(static_cast<uint64>(76561197960265728ull + n)); }
+
+    FakeLobby makeLobby(uint64_t n, const std::string& name, int members = 1, int memberLimit = 4) {
+        FakeLobby l;
+        l.id = lobbyId(n);
+        l.name = name;
+        l.host = std::to_string(hostId(n).ConvertToUint64());
+        l.members = members;
+        l.memberLimit = memberLimit;
+        return l;
+    }
+
+    const LobbyBrowser::Entry* findEntry(const LobbyBrowser& browser, const std::string& name) {
+        for (const LobbyBrowser::Entry& e : browser.getEntries())
+            if (e.name == name) return &e;
+        return nullptr;
+    }
+
+    std::vector<std::string> names(const LobbyBrowser& browser) {
+        std::vector<std::string> out;
+        for (const LobbyBrowser::Entry& e : browser.getEntries())
+            out.push_back(e.name);
+        return out;
+    }
+
+    bool near(float a, float b) { return std::fabs(a - b) < 0.01f; }
+
+    /// Records the probes a browser sends.
+    struct ProbeLog {
+        std::vector<std::pair<CSteamID, uint32_t>> sent;
+
+        LobbyBrowser::PingSender sender() {
+            return [this](CSteamID host, uint32_t nonce) {
+                sent.emplace_back(host, nonce);
+                return true;
+            };
+        }
+        uint32_t lastNonceTo(CSteamID host) const {
+            for (auto it = sent.rbegin(); it != sent.rend(); ++it)
+                if (it->first == host) return it->second;
+            return 0;
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    // List diffing
+    //--------------------------------------------------------------------------
+    void testListDiffing() {
+        auto backend = std::make_unique<FakeLobbyList>();
+        FakeLobbyList& fake = *backend;
+        LobbyBrowser browser(std::move(backend));
+
+        browser.start("cube", 0.0);
+        CHECK_EQ(fake.requests, 1);
+        CHECK_EQ(fake.lastGameId, std::string("cube"));
+        CHECK(browser.isRefreshing());
+        CHECK(!browser.hasResults());
+
+        fake.lobbies = { makeLobby(1, "Alpha"), makeLobby(2, "Bravo"), makeLobby(3, "Charlie"),
+                         makeLobby(4, "") }; // Unnamed lobbies are not listed.
+        browser.onListReceived(fake.count(), 0.5);
+        CHECK(!browser.isRefreshing());
+        CHECK(browser.hasResults());
+        CHECK_EQ(browser.getEntries().size(), 3u);
+        CHECK_EQ(browser.getLastDiff().added, 3u);
+        CHECK_EQ(browser.getLastDiff().removed, 0u);
+        CHECK_EQ(browser.getLastDiff().changed, 0u);
+        CHECK(findEntry(browser, "Bravo") && findEntry(browser, "Bravo")->host == hostId(2));
+        const uint32_t afterFirst = browser.getVersion();
+
+        // Bravo closes, Charlie gains a member, Delta opens.
+        fake.lobbies = { makeLobby(1, "Alpha"), makeLobby(3, "Charlie", 2), makeLobby(5, "Delta") };
+        browser.onListReceived(fake.count(), 1.0);
+        CHECK_EQ(browser.getLastDiff().added, 1u);
+        CHECK_EQ(browser.getLastDiff().removed, 1u);
+        CHECK_EQ(browser.getLastDiff().changed, 1u);
+        CHECK((names(browser) == std::vector<std::string>{ "Alpha", "Charlie", "Delta" }));
+        CHECK(findEntry(browser, "Charlie") && findEntry(browser, "Charlie")->members == 2);
+        CHECK(browser.getVersion() != afterFirst);
+
+        // An identical list is not a visible change.
+        const uint32_t afterSecond = browser.getVersion();
+        browser.onListReceived(fake.count(), 1.5);
+        CHECK_EQ(browser.getLastDiff().added, 0u);
+        CHECK_EQ(browser.getLastDiff().removed, 0u);
+        CHECK_EQ(browser.getLastDiff().changed, 0u);
+        CHECK_EQ(browser.getVersion(), afterSecond);
+
+        // The next request goes out refreshInterval after the last results.
+        browser.update(1.5 + browser.getConfig().refreshInterval - 0.1);
+        CHECK_EQ(fake.requests, 1);
+        browser.update(1.5 + browser.getConfig().refreshInterval);
+        CHECK_EQ(fake.requests, 2);
+
+        // Stopping keeps the cached entries but issues no more requests.
+        browser.stop();
+        browser.update(100.0);
+        CHECK_EQ(fake.requests, 2);
+        CHECK_EQ(browser.getEntries().size(), 3u);
+    }
+
+    //--------------------------------------------------------------------------
+    // Pagination
+    //--------------------------------------------------------------------------
+    void testPagination() {
+        LobbyBrowser::Config config;
+        config.pageSize = 3;
+        auto backend = std::make_unique<FakeLobbyList>();
+        FakeLobbyList& fake = *backend;
+        LobbyBrowser browser(std::move(backend), config);
+
+        browser.start("cube", 0.0);
+        CHECK_EQ(browser.getPageCount(), 1u);
+        CHECK(browser.getEntry(0) == nullptr);
+
+        for (uint64_t i = 0; i < 7; ++i)
+            fake.lobbies.push_back(makeLobby(i + 1, "L" + std::to_string(i)));
+        browser.onListReceived(fake.count(), 0.0);
+        CHECK_EQ(browser.getPageCount(), 3u);
+        CHECK_EQ(browser.getPage(), 0u);
+        CHECK(browser.getEntry(0) && browser.getEntry(0)->name == "L0");
+        CHECK(browser.getEntry(2) && browser.getEntry(2)->name == "L2");
+        CHECK(browser.getEntry(3) == nullptr); // Past the page size.
+
+        browser.nextPage();
+        CHECK_EQ(browser.getPage(), 1u);
+        CHECK(browser.getEntry(0) && browser.getEntry(0)->name == "L3");
+
+        browser.nextPage();
+        CHECK_EQ(browser.getPage(), 2u);
+        CHECK(browser.getEntry(0) && browser.getEntry(0)->name == "L6");
+        CHECK(browser.getEntry(1) == nullptr);
+
+        // Paging past either end is a no-op and not a visible change.
+        const uint32_t version = browser.getVersion();
+        browser.nextPage();
+        CHECK_EQ(browser.getPage(), 2u);
+        CHECK_EQ(browser.getVersion(), version);
+
+        browser.prevPage();
+        CHECK_EQ(browser.getPage(), 1u);
+        CHECK(browser.getVersion() != version);
+
+        // A shorter list pulls the current page back into range.
+        fake.lobbies.resize(2);
+        browser.onListReceived(fake.count(), 1.0);
+        CHECK_EQ(browser.getPageCount(), 1u);
+        CHECK_EQ(browser.getPage(), 0u);
+        CHECK(browser.getEntry(1) && browser.getEntry(1)->name == "L1");
+    }
+
+    //--------------------------------------------------------------------------
+    // Probe timeouts
+    //--------------------------------------------------------------------------
+    void testProbeTimeouts() {
+        LobbyBrowser::Config config;
+        config.pingCandidates = 2;
+        config.pingTimeout = 2.f;
+        config.maxFailedPings = 2;
+        auto backend = std::make_unique<FakeLobbyList>();
+        FakeLobbyList& fake = *backend;
+        LobbyBrowser browser(std::move(backend), config);
+        ProbeLog probes;
+        browser.setPingSender(probes.sender());
+
+        browser.start("cube", 0.0);
+        fake.lobbies = { makeLobby(1, "Aaa", 4, 4), makeLobby(2, "Bravo"), makeLobby(3, "Charlie"),
+                         makeLobby(4, "Delta") };
+        browser.onListReceived(fake.count(), 0.0);
+
+        // Full lobbies are skipped; only the best pingCandidates hosts are probed.
+        CHECK_EQ(probes.sent.size(), 2u);
+        CHECK(probes.lastNonceTo(hostId(2)) != 0);
+        CHECK(probes.lastNonceTo(hostId(3)) != 0);
+        CHECK_EQ(probes.lastNonceTo(hostId(1)), 0u);
+        CHECK_EQ(probes.lastNonceTo(hostId(4)), 0u);
+        const uint32_t firstBravoNonce = probes.lastNonceTo(hostId(2));
+
+        browser.update(1.0);
+        CHECK_EQ(probes.sent.size(), 2u);
+        CHECK(findEntry(browser, "Bravo")->pendingNonce != 0);
+
+        // Unanswered past pingTimeout: the probe counts as lost.
+        const uint32_t version = browser.getVersion();
+        browser.update(2.5);
+        CHECK_EQ(findEntry(browser, "Bravo")->pendingNonce, 0u);
+        CHECK_EQ(findEntry(browser, "Bravo")->failedPings, 1);
+        CHECK_EQ(findEntry(browser, "Charlie")->failedPings, 1);
+        CHECK(browser.getVersion() != version);
+        CHECK_EQ(probes.sent.size(), 2u); // Not re-probed in the same update.
+
+        // A reply to the expired probe no longer matches.
+        CHECK(!browser.onPong(hostId(2), firstBravoNonce, 3.0));
+
+        // Unmeasured hosts are retried after pingTimeout.
+        browser.update(4.5);
+        CHECK_EQ(probes.sent.size(), 4u);
+        CHECK(probes.lastNonceTo(hostId(2)) != firstBravoNonce);
+
+        // A second loss reaches maxFailedPings: the next candidate is probed instead.
+        browser.update(7.0);
+        CHECK_EQ(findEntry(browser, "Bravo")->failedPings, 2);
+        CHECK_EQ(findEntry(browser, "Charlie")->failedPings, 2);
+        CHECK_EQ(probes.sent.size(), 5u);
+        CHECK_EQ(probes.sent.back().first, hostId(4));
+
+        // Unreachable hosts sort after unmeasured ones, full lobbies last.
+        browser.onListReceived(fake.count(), 7.5);
+        CHECK((names(browser) == std::vector<std::string>{ "Delta", "Bravo", "Charlie", "Aaa" }));
+    }
+
+    //--------------------------------------------------------------------------
+    // Probe replies
+    //--------------------------------------------------------------------------
+    void testPong() {
+        auto backend = std::make_unique<FakeLobbyList>();
+        FakeLobbyList& fake = *backend;
+        LobbyBrowser browser(std::move(backend));
+        ProbeLog probes;
+        browser.setPingSender(probes.sender());
+
+        browser.start("cube", 0.0);
+        fake.lobbies = { makeLobby(1, "Alpha"), makeLobby(2, "Bravo") };
+        browser.onListReceived(fake.count(), 0.0);
+        CHECK_EQ(probes.sent.size(), 2u);
+        const uint32_t alphaNonce = probes.lastNonceTo(hostId(1));
+        const uint32_t bravoNonce = probes.lastNonceTo(hostId(2));
+
+        // Wrong nonce, unknown host and the zero nonce are ignored.
+        CHECK(!browser.onPong(hostId(1), alphaNonce + 100, 0.05));
+        CHECK(!browser.onPong(hostId(9), alphaNonce, 0.05));
+        CHECK(!browser.onPong(hostId(1), 0, 0.05));
+
+        const uint32_t version = browser.getVersion();
+        CHECK(browser.onPong(hostId(2), bravoNonce, 0.080));
+        CHECK(near(findEntry(browser, "Bravo")->pingMs, 80.f));
+        CHECK_EQ(findEntry(browser, "Bravo")->pendingNonce, 0u);
+        CHECK(browser.getVersion() != version);
+        CHECK(!browser.onPong(hostId(2), bravoNonce, 0.090)); // Duplicate reply.
+
+        CHECK(browser.onPong(hostId(1), alphaNonce, 0.120));
+        CHECK(near(findEntry(browser, "Alpha")->pingMs, 120.f));
+
+        // Replies update pings in place; rows only move when the next list arrives.
+        CHECK((names(browser) == std::vector<std::string>{ "Alpha", "Bravo" }));
+        browser.onListReceived(fake.count(), 1.0);
+        CHECK((names(browser) == std::vector<std::string>{ "Bravo", "Alpha" }));
+        CHECK(near(findEntry(browser, "Bravo")->pingMs, 80.f)); // Kept across lists.
+
+        // Measured hosts are probed again after repingInterval and the samples smoothed.
+        const double reping = 0.2 + browser.getConfig().repingInterval;
+        browser.update(reping);
+        CHECK_EQ(probes.sent.size(), 4u);
+        CHECK(browser.onPong(hostId(2), probes.lastNonceTo(hostId(2)), reping + 0.180));
+        CHECK(near(findEntry(browser, "Bravo")->pingMs, 80.f + (180.f - 80.f) * 0.3f));
+
+        // A new host invalidates the measurement.
+        fake.lobbies[1].host = std::to_string(hostId(7).ConvertToUint64());
+        browser.onListReceived(fake.count(), reping + 1.0);
+        CHECK_EQ(browser.getLastDiff().changed, 1u);
+        CHECK(findEntry(browser, "Bravo")->host == hostId(7));
+        CHECK(findEntry(browser, "Bravo")->pingMs < 0.f);
+    }
+}
+
+int main() {
+    RUN_TEST(testListDiffing);
+    RUN_TEST(testPagination);
+    RUN_TEST(testProbeTimeouts);
+    RUN_TEST(testPong);
+    return testFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+//==============================================================================
+// LobbyMembershipCache tests, driven by a fake lobby backend.
+//
+// Membership and data changes are applied to the fake and then announced
+// through onChatUpdate()/onDataUpdate(), as the LobbyChatUpdate_t and
+// LobbyDataUpdate_t callbacks would.
+//==============================================================================
+#include "../src/Networking/LobbyMembershipCache.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @brief In-process lobby: a member list, per-member data and an owner.
+     */
+    class FakeLobbyBackend : public LobbyBackend {
+    public:
+        std::vector<CSteamID> members;
+        std::map<std::pair<uint64, std::string>, std::string> memberData;
+        CSteamID owner = k_steamIDNil;
+        int ownerQueries = 0;
+
+        int getNumMembers(CSteamID /*lobby*/) override { return static_cast<int>(members.size()); }
+        CSteamID getMemberByIndex(CSteamID /*lobby*/, int index) override { return members[index]; }
+        CSteamID getLobbyOwner(CSteamID /*lobby*/) override {
+            ++ownerQueries;
+            return owner;
+        }
+        const char* getMemberData(CSteamID /*lobby*/, CSteamID member, const char* key) override {
+            auto it = memberData.find({ member.ConvertToUint64(), key });
+            return it != memberData.end() ? it->second.c_str() : "";
+        }
+
+        void setReady(CSteamID member, bool ready) { memberData[{ member.ConvertToUint64(), "ready" }] = ready ? "1" : "0"; }
+        void leave(CSteamID member) { members.erase(std::remove(members.begin(), members.end(), member), members.end()); }
+    };
+
+    const CSteamID kLobby(static_cast<uint64>(109775240000000001ull));
+    const CSteamID kOtherLobby(static_cast<uint64>(109775240000000002ull));
+    CSteamID user(uint64_t n) { return CSteamID(static_cast<uint64>(76561197960265728ull + n)); }
+
+    std::vector<CSteamID> ids(const LobbyMembershipCache& cache) {
+        std::vector<CSteamID> out;
+        for (const LobbyMembershipCache::Member& m : cache.getMembers())
+            out.push_back(m.id);
+        return out;
+    }
+
+    //--------------------------------------------------------------------------
+    // Membership
+    //--------------------------------------------------------------------------
+    void testMembership() {
+        auto backend = std::make_unique<FakeLobbyBackend>();
+        FakeLobbyBackend& fake = *backend;
+        LobbyMembershipCache cache(std::move(backend));
+
+        fake.members = { user(1), user(2), user(3) };
+        fake.owner = user(1);
+        fake.setReady(user(2), true);
+        cache.reset(kLobby);
+        CHECK(cache.getLobby() == kLobby);
+        CHECK((ids(cache) == std::vector<CSteamID>{ user(1), user(2), user(3) }));
+        CHECK(!cache.isReady(user(1)));
+        CHECK(cache.isReady(user(2)));
+        CHECK(!cache.allReady());
+
+        // Joins are appended; leaves keep the remaining members in join order.
+        uint32_t version = cache.getVersion();
+        fake.members.push_back(user(4));
+        cache.onChatUpdate(kLobby, user(4), k_EChatMemberStateChangeEntered);
+        CHECK((ids(cache) == std::vector<CSteamID>{ user(1), user(2), user(3), user(4) }));
+        CHECK(cache.getVersion() != version);
+
+        version = cache.getVersion();
+        fake.leave(user(2));
+        cache.onChatUpdate(kLobby, user(2), k_EChatMemberStateChangeDisconnected);
+        CHECK((ids(cache) == std::vector<CSteamID>{ user(1), user(3), user(4) }));
+        CHECK(!cache.contains(user(2)));
+        CHECK(cache.getVersion() != version);
+
+        // Repeated or foreign events change nothing.
+        version = cache.getVersion();
+        cache.onChatUpdate(kLobby, user(4), k_EChatMemberStateChangeEntered);
+        cache.onChatUpdate(kOtherLobby, user(9), k_EChatMemberStateChangeEntered);
+        CHECK_EQ(cache.getMembers().size(), 3u);
+        CHECK_EQ(cache.getVersion(), version);
+
+        // Ready flags are re-read when the member's data changes.
+        for (uint64_t n : { 1, 3, 4 })
+            fake.setReady(user(n), true);
+        cache.onDataUpdate(kLobby, user(1));
+        cache.onDataUpdate(kLobby, user(3));
+        CHECK(!cache.allReady());
+        cache.refreshMember(user(4));
+        CHECK(cache.allReady());
+        CHECK(cache.getVersion() != version);
+
+        cache.clear();
+        CHECK(cache.getMembers().empty());
+        CHECK(cache.getLobby() == k_steamIDNil);
+    }
+
+    //--------------------------------------------------------------------------
+    // Owner
+    //--------------------------------------------------------------------------
+    void testOwner() {
+        auto backend = std::make_unique<FakeLobbyBackend>();
+        FakeLobbyBackend& fake = *backend;
+        LobbyMembershipCache cache(std::move(backend));
+
+        CHECK(cache.getOwner() == k_steamIDNil);
+        CHECK(!cache.isOwner(k_steamIDNil));
+
+        fake.members = { user(1), user(2), user(3) };
+        fake.owner = user(1);
+        cache.reset(kLobby);
+        CHECK(cache.getOwner() == user(1));
+        CHECK(cache.isOwner(user(1)));
+        CHECK(!cache.isOwner(user(2)));
+
+        // Reads are served from the cache.
+        const int queries = fake.ownerQueries;
+        for (int i = 0; i < 100; ++i)
+            CHECK(cache.isOwner(user(1)));
+        CHECK_EQ(fake.ownerQueries, queries);
+
+        // The owner leaves and Steam migrates ownership.
+        uint32_t version = cache.getVersion();
+        fake.leave(user(1));
+        fake.owner = user(2);
+        cache.onChatUpdate(kLobby, user(1), k_EChatMemberStateChangeLeft);
+        CHECK(cache.isOwner(user(2)));
+        CHECK(!cache.isOwner(user(1)));
+        CHECK(cache.getVersion() != version);
+
+        // Ownership moved without a membership change shows up as lobby data.
+        version = cache.getVersion();
+        fake.owner = user(3);
+        cache.onDataUpdate(kLobby, kLobby);
+        CHECK(cache.isOwner(user(3)));
+        CHECK(cache.getVersion() != version);
+
+        // Lobby data that leaves the owner alone is not a visible change.
+        version = cache.getVersion();
+        cache.onDataUpdate(kLobby, kLobby);
+        CHECK_EQ(cache.getVersion(), version);
+
+        // Other lobbies are ignored.
+        fake.owner = user(2);
+        cache.onDataUpdate(kOtherLobby, kOtherLobby);
+        CHECK(cache.isOwner(user(3)));
+
+        cache.clear();
+        CHECK(cache.getOwner() == k_steamIDNil);
+        CHECK(!cache.isOwner(user(3)));
+    }
+}
+
+int main() {
+    RUN_TEST(testMembership);
+    RUN_TEST(testOwner);
+    return testFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+//==============================================================================
+// Link-time stand-ins for the steam_api exports the lobby classes reference.
+//
+// The tests drive LobbyBrowser and LobbyMembershipCache through fake backends
+// and call their handlers directly, so no Steam client is involved. The
+// STEAM_CALLBACK members still register themselves on construction, and the
+// default Steam backends are still compiled in; these stubs satisfy both.
+// SteamMatchmaking() resolves to nullptr.
+//==============================================================================
+#include <steam/steam_api.h>
+
+namespace {
+    void* g_nullInterface = nullptr;
+}
+
+S_API void S_CALLTYPE SteamAPI_RegisterCallback(class CCallbackBase* /*pCallback*/, int /*iCallback*/) {}
+S_API void S_CALLTYPE SteamAPI_UnregisterCallback(class CCallbackBase* /*pCallback*/) {}
+S_API void S_CALLTYPE SteamAPI_RegisterCallResult(class CCallbackBase* /*pCallback*/, SteamAPICall_t /*hAPICall*/) {}
+S_API void S_CALLTYPE SteamAPI_UnregisterCallResult(class CCallbackBase* /*pCallback*/, SteamAPICall_t /*hAPICall*/) {}
+
+S_API HSteamUser S_CALLTYPE SteamAPI_GetHSteamUser() { return 0; }
+
+S_API void* S_CALLTYPE SteamInternal_ContextInit(void* /*pContextInitData*/) {
+    // Interface accessors dereference the returned context as their cached pointer.
+    return &g_nullInterface;
+}
+
+S_API void* S_CALLTYPE SteamInternal_FindOrCreateUserInterface(HSteamUser /*hSteamUser*/, const char* /*pszVersion*/) {
+    return nullptr;
+}
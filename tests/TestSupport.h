@@ -0,0 +1,35 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <iostream>
+
+/**
+ * @brief Minimal assertion helpers for the standalone test executables.
+ *
+ * CHECK() logs a failure and keeps going so one run reports every broken
+ * expectation; a test's main() returns testFailures() as its exit code.
+ */
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::cerr << "[ERROR] " << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed\n"; \
+            ++testFailures();                                                           \
+        }                                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
+
+/// Runs one test function and reports its name.
+#define RUN_TEST(fn)                                                                    \
+    do {                                                                                \
+        const int before = testFailures();                                              \
+        fn();                                                                           \
+        std::cout << (testFailures() == before ? "[ OK ] " : "[FAIL] ") << #fn << "\n"; \
+    } while (0)
+
+#endif // TESTSUPPORT_H
@@ -0,0 +1,255 @@
+//==============================================================================
+// render_bench: draw calls, vertices and submission time of the entity passes.
+//
+//  entities  Players and bullets: one sf::RectangleShape draw per entity, as
+//            GameplayState::RenderPlayers/RenderBullets did before EntityBatch,
+//            next to EntityBatch submitted through the RenderQueue.
+//  enemies   A large wave: the sf::VertexArray rebuilt every frame by the old
+//            updateEnemyVertices(), next to EnemyRenderBuffer, with a varying
+//            share of the enemies moving each frame.
+//
+// Every frame goes through RenderStats, the counters the game writes to
+// render_stats.csv. The tables show its per-frame draw calls and vertices and
+// the median / 95th percentile submission time (beginFrame() to display()).
+// "uploaded" is vertex data sent to the GPU per frame: all of it for a client
+// array, the dirty range for EnemyRenderBuffer. The scenes are synthetic.
+// A borderless window is opened for the GL context.
+// Usage: render_bench [frames]
+//==============================================================================
+#include "../src/Entities/Enemy.h"
+#include "../src/Rendering/EnemyRenderBuffer.h"
+#include "../src/Rendering/EntityBatch.h"
+#include "../src/Rendering/RenderQueue.h"
+#include "../src/Rendering/RenderStats.h"
+#include "../src/Utils/Config.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct Result {
+        unsigned int drawCalls = 0;
+        unsigned int vertices = 0;
+        std::size_t uploaded = 0;
+        double submitP50 = 0.0;
+        double submitP95 = 0.0;
+    };
+
+    void printRow(const char* path, const Result& r) {
+        std::printf("    %-8s %6u draws %8u vertices %8zu uploaded   submit p50 %7.3f ms  p95 %7.3f ms\n",
+                    path, r.drawCalls, r.vertices, r.uploaded, r.submitP50, r.submitP95);
+    }
+
+    Result finish(const RenderStats& gfx, std::size_t uploaded) {
+        Result r;
+        r.drawCalls = gfx.getLastFrame().drawCalls;
+        r.vertices = gfx.getLastFrame().vertices;
+        r.uploaded = uploaded;
+        r.submitP50 = gfx.getPercentile(RenderStats::Metric::SubmitMs, 50.0);
+        r.submitP95 = gfx.getPercentile(RenderStats::Metric::SubmitMs, 95.0);
+        return r;
+    }
+
+    /// Position of entity `index` on a circle, advancing with `frame`.
+    sf::Vector2f orbit(std::size_t index, int frame, float radius) {
+        const float angle = static_cast<float>(index) * 0.37f + static_cast<float>(frame) * 0.02f;
+        return sf::Vector2f(640.f + radius * std::cos(angle), 360.f + radius * std::sin(angle));
+    }
+
+    //--------------------------------------------------------------------------
+    // entities
+    //--------------------------------------------------------------------------
+    Result entitiesPerShape(sf::RenderWindow& window, std::size_t players, std::size_t bullets, int frames) {
+        RenderStats gfx(window);
+        sf::RectangleShape playerShape(sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE));
+        playerShape.setFillColor(sf::Color::Blue);
+        sf::RectangleShape bulletShape(sf::Vector2f(BULLET_SIZE, BULLET_SIZE));
+        bulletShape.setFillColor(sf::Color::Yellow);
+
+        for (int frame = 0; frame < frames; ++frame) {
+            gfx.beginFrame();
+            gfx.clear(sf::Color::Black);
+            gfx.setView(window.getDefaultView());
+            for (std::size_t i = 0; i < players; ++i) {
+                playerShape.setPosition(orbit(i, frame, 200.f));
+                gfx.draw(playerShape);
+                gfx.countVertices(4); // A filled rectangle without outline.
+            }
+            for (std::size_t i = 0; i < bullets; ++i) {
+                bulletShape.setPosition(orbit(i, frame * 4, 320.f));
+                gfx.draw(bulletShape);
+                gfx.countVertices(4);
+            }
+            gfx.display();
+        }
+        return finish(gfx, gfx.getLastFrame().vertices);
+    }
+
+    Result entitiesBatched(sf::RenderWindow& window, std::size_t players, std::size_t bullets, int frames) {
+        RenderStats gfx(window);
+        RenderQueue queue;
+        EntityBatch batch;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            gfx.beginFrame();
+            queue.begin();
+            const RenderQueue::ViewId view = queue.registerView(window.getDefaultView());
+            batch.begin();
+            for (std::size_t i = 0; i < players; ++i) {
+                const sf::Vector2f p = orbit(i, frame, 200.f);
+                batch.add(EntityBatch::Kind::Player, p.x, p.y);
+            }
+            for (std::size_t i = 0; i < bullets; ++i) {
+                const sf::Vector2f p = orbit(i, frame * 4, 320.f);
+                batch.add(EntityBatch::Kind::Bullet, p.x, p.y);
+            }
+            batch.submit(queue, RenderQueue::Layer::World, view);
+            gfx.clear(sf::Color::Black);
+            queue.flush(gfx);
+            gfx.display();
+        }
+        return finish(gfx, gfx.getLastFrame().vertices);
+    }
+
+    void benchEntities(sf::RenderWindow& window, int frames) {
+        // 8 players firing every 0.2 s with 2 s bullets keep ~80 bullets alive.
+        const std::size_t bulletCounts[] = { 80, 800, 4000 };
+        std::printf("entities (8 players, %d frames)\n", frames);
+        for (std::size_t bullets : bulletCounts) {
+            std::printf("  %zu bullets\n", bullets);
+            printRow("before", entitiesPerShape(window, 8, bullets, frames));
+            printRow("after", entitiesBatched(window, 8, bullets, frames));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // enemies
+    //--------------------------------------------------------------------------
+    std::unordered_map<uint64_t, Enemy> makeWave(std::size_t count) {
+        std::unordered_map<uint64_t, Enemy> enemies;
+        enemies.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Enemy e = Enemy(); // Value-initialised: members without defaults start at zero.
+            e.id = i + 1;
+            e.type = static_cast<Enemy::Type>(i % ENEMY_TYPE_COUNT);
+            e.health = 30;
+            e.size = sf::Vector2f(20.f, 20.f);
+            e.color = sf::Color::Red;
+            const sf::Vector2f p = orbit(i, 0, 100.f + static_cast<float>(i % 500));
+            e.x = e.renderedX = p.x;
+            e.y = e.renderedY = p.y;
+            e.isSplitting = false;
+            e.shakeTimer = 0.f;
+            enemies.emplace(e.id, e);
+        }
+        return enemies;
+    }
+
+    /// Moves every `stride`-th enemy (a different subset each frame); stride 0 moves none.
+    void moveEnemies(std::unordered_map<uint64_t, Enemy>& enemies, std::size_t stride, int frame) {
+        if (stride == 0) return;
+        for (auto& [id, e] : enemies) {
+            if ((id + static_cast<uint64_t>(frame)) % stride == 0) {
+                e.renderedX += 0.5f;
+                e.renderedY -= 0.25f;
+            }
+        }
+    }
+
+    /// The per-frame rebuild GameplayState::updateEnemyVertices() did before EnemyRenderBuffer.
+    void rebuildEnemyVertices(const std::unordered_map<uint64_t, Enemy>& enemies, sf::VertexArray& vertices) {
+        vertices.clear();
+        vertices.setPrimitiveType(sf::Quads);
+        vertices.resize(enemies.size() * 4);
+        std::size_t i = 0;
+        for (const auto& [id, enemy] : enemies) {
+            if (enemy.health <= 0 || std::isnan(enemy.renderedX) || std::isnan(enemy.renderedY))
+                continue;
+            float x = enemy.renderedX;
+            float y = enemy.renderedY;
+            if (enemy.isSplitting && enemy.shakeTimer > 0) {
+                float shake = enemy.shakeTimer / enemy.shakeDuration;
+                x += (std::rand() % 10 - 5) * shake;
+                y += (std::rand() % 10 - 5) * shake;
+            }
+            float w = enemy.size.x, h = enemy.size.y;
+            sf::Color c = enemy.color;
+            vertices[i * 4 + 0].position = { x, y };
+            vertices[i * 4 + 1].position = { x + w, y };
+            vertices[i * 4 + 2].position = { x + w, y + h };
+            vertices[i * 4 + 3].position = { x, y + h };
+            for (int j = 0; j < 4; ++j)
+                vertices[i * 4 + j].color = c;
+            ++i;
+        }
+        vertices.resize(i * 4);
+    }
+
+    Result enemiesRebuilt(sf::RenderWindow& window, std::size_t count, std::size_t stride, int frames) {
+        RenderStats gfx(window);
+        std::unordered_map<uint64_t, Enemy> enemies = makeWave(count);
+        sf::VertexArray vertices;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            moveEnemies(enemies, stride, frame);
+            gfx.beginFrame();
+            gfx.clear(sf::Color::Black);
+            gfx.setView(window.getDefaultView());
+            rebuildEnemyVertices(enemies, vertices);
+            gfx.draw(vertices);
+            gfx.display();
+        }
+        // Client-side arrays are streamed in full on every draw.
+        return finish(gfx, vertices.getVertexCount());
+    }
+
+    Result enemiesBuffered(sf::RenderWindow& window, std::size_t count, std::size_t stride, int frames) {
+        RenderStats gfx(window);
+        RenderQueue queue;
+        std::unordered_map<uint64_t, Enemy> enemies = makeWave(count);
+        EnemyRenderBuffer buffer;
+        std::size_t uploaded = 0;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            moveEnemies(enemies, stride, frame);
+            gfx.beginFrame();
+            queue.begin();
+            const RenderQueue::ViewId view = queue.registerView(window.getDefaultView());
+            buffer.beginFrame();
+            for (const auto& [id, enemy] : enemies)
+                buffer.submit(enemy);
+            buffer.endFrame();
+            queue.submitDrawable(RenderQueue::Layer::World, view, buffer, buffer.getTexture(),
+                                 sf::RenderStates::Default, buffer.getVertexCount());
+            gfx.clear(sf::Color::Black);
+            queue.flush(gfx);
+            gfx.display();
+            uploaded = buffer.getUploadedVertices();
+        }
+        return finish(gfx, uploaded);
+    }
+
+    void benchEnemies(sf::RenderWindow& window, std::size_t count, int frames) {
+        struct Share { const char* label; std::size_t stride; };
+        const Share shares[] = { { "all moving", 1 }, { "1 in 10 moving", 10 }, { "none moving", 0 } };
+        std::printf("enemies (%zu, %d frames)\n", count, frames);
+        for (const Share& share : shares) {
+            std::printf("  %s\n", share.label);
+            printRow("before", enemiesRebuilt(window, count, share.stride, frames));
+            printRow("after", enemiesBuffered(window, count, share.stride, frames));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 600;
+
+    sf::RenderWindow window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "render_bench", sf::Style::None);
+    window.setVerticalSyncEnabled(false);
+
+    benchEntities(window, frames);
+    benchEnemies(window, 20000, frames);
+    return 0;
+}
@@ -0,0 +1,269 @@
+//==============================================================================
+// wire_bench: sizes and throughput of the binary wire protocol.
+//
+//  sizes   Frame bytes of the hot messages next to the pipe-separated text
+//          they replaced (same values, formatted as the old senders did).
+//  schema  Encode and decode time per message type.
+//  parse   Receive path on a coalesced packet mix: version check, framing,
+//          dispatch and decode, as in NetworkManager::receiveMessages().
+//
+// The inputs are synthetic; nothing here replays a recorded session.
+// Usage: wire_bench [iterations]
+//==============================================================================
+#include "../src/Networking/PacketCoalescer.h"
+#include "../src/Networking/WireProtocol.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const CSteamID kPeer(76561197960287930ULL);
+    const CSteamID kOther(76561198012345678ULL);
+
+    volatile std::size_t g_sink = 0; ///< Keeps the optimiser from dropping decoded results.
+
+    double nsPer(Clock::duration elapsed, std::size_t count) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+    }
+
+    //--------------------------------------------------------------------------
+    // Sample messages
+    //--------------------------------------------------------------------------
+    Wire::PlayerUpdate samplePlayer() {
+        Wire::PlayerUpdate m;
+        m.player = kPeer;
+        m.x = m.renderedX = 812.5f;
+        m.y = m.renderedY = -140.25f;
+        m.health = 95;
+        m.kills = 12;
+        m.money = 340;
+        m.speed = 150.f;
+        m.ready = true;
+        return m;
+    }
+
+    Wire::EnemySpawn sampleSpawn() {
+        Wire::EnemySpawn m;
+        m.id = 0x2A00013Bull;
+        m.x = 1304.7f;
+        m.y = 988.2f;
+        m.health = 40;
+        m.spawnDelay = 1.5f;
+        m.type = 1;
+        m.tick = 40213;
+        return m;
+    }
+
+    Wire::EnemyUpdate sampleUpdate() {
+        Wire::EnemyUpdate m;
+        m.id = 0x2A00013Bull;
+        m.x = 1296.4f;
+        m.y = 979.9f;
+        m.health = 30;
+        m.tick = 40215;
+        return m;
+    }
+
+    Wire::EnemyDeath sampleDeath() {
+        Wire::EnemyDeath m;
+        m.id = 0x2A00013Bull;
+        m.tick = 40230;
+        m.killer = kOther;
+        return m;
+    }
+
+    Wire::BulletFire sampleFire() {
+        Wire::BulletFire m;
+        m.messageId = 5120;
+        m.shooter = kPeer;
+        m.bulletIndex = 733;
+        m.startX = 812.5f;
+        m.startY = -140.25f;
+        m.targetX = 1296.4f;
+        m.targetY = 979.9f;
+        m.lifetime = 2.f;
+        return m;
+    }
+
+    Wire::Hit sampleHit() {
+        Wire::Hit m;
+        m.shooter = kPeer;
+        m.bulletIndex = 733;
+        m.enemyId = 0x2A00013Bull;
+        m.damage = 10;
+        m.tick = 40229;
+        return m;
+    }
+
+    template <typename Msg>
+    std::size_t frameSize(const Msg& msg) {
+        Wire::ByteWriter w;
+        Wire::encode(w, msg);
+        return w.size();
+    }
+
+    //--------------------------------------------------------------------------
+    // sizes
+    //--------------------------------------------------------------------------
+    void printSize(const char* name, std::size_t binary, int textLength) {
+        const std::size_t text = static_cast<std::size_t>(textLength) + 1; // The old senders included the NUL.
+        std::printf("  %-14s %4zu B   text %4zu B   %5.1f%%\n", name, binary, text,
+                    100.0 * static_cast<double>(binary) / static_cast<double>(text));
+    }
+
+    void benchSizes() {
+        // The text messages carried wall-clock milliseconds where frames carry a 16-bit tick.
+        const unsigned long long stamp = 1760870400123ull;
+        char text[256];
+        std::printf("sizes (binary frame vs. old text message)\n");
+
+        const Wire::PlayerUpdate p = samplePlayer();
+        printSize("PlayerUpdate", frameSize(p),
+                  std::snprintf(text, sizeof(text), "P|%llu|%.1f|%.1f|%.1f|%.1f|%d|%d|%d|%d|%.1f|%d",
+                                static_cast<unsigned long long>(p.player.ConvertToUint64()), p.x, p.y,
+                                p.renderedX, p.renderedY, p.health, p.kills, p.ready ? 1 : 0, p.money, p.speed,
+                                p.alive ? 1 : 0));
+
+        const Wire::EnemyUpdate u = sampleUpdate();
+        printSize("EnemyUpdate", frameSize(u),
+                  std::snprintf(text, sizeof(text), "E|UPDATE|%llu|%.1f|%.1f|%d|%.2f|%llu",
+                                static_cast<unsigned long long>(u.id), u.x, u.y, u.health, u.spawnDelay, stamp));
+
+        const Wire::EnemySpawn s = sampleSpawn();
+        printSize("EnemySpawn", frameSize(s),
+                  std::snprintf(text, sizeof(text), "E|SPAWN|%llu|%.1f|%.1f|%d|%.2f|%d|%llu",
+                                static_cast<unsigned long long>(s.id), s.x, s.y, s.health, s.spawnDelay,
+                                static_cast<int>(s.type), stamp));
+
+        const Wire::EnemyDeath d = sampleDeath();
+        printSize("EnemyDeath", frameSize(d),
+                  std::snprintf(text, sizeof(text), "E|DEATH|%llu|%llu|%llu",
+                                static_cast<unsigned long long>(d.id), stamp,
+                                static_cast<unsigned long long>(d.killer.ConvertToUint64())));
+
+        const Wire::BulletFire f = sampleFire();
+        printSize("BulletFire", frameSize(f),
+                  std::snprintf(text, sizeof(text), "B|fire|%u|%llu|%d|%.1f|%.1f|%.1f|%.1f|%.1f",
+                                f.messageId, static_cast<unsigned long long>(f.shooter.ConvertToUint64()),
+                                static_cast<int>(f.bulletIndex), f.startX, f.startY, f.targetX, f.targetY,
+                                f.lifetime));
+
+        const Wire::Hit h = sampleHit();
+        printSize("Hit", frameSize(h),
+                  std::snprintf(text, sizeof(text), "H|%llu|%llu|%llu|%d|%llu",
+                                static_cast<unsigned long long>(h.bulletId()),
+                                static_cast<unsigned long long>(h.enemyId),
+                                static_cast<unsigned long long>(h.shooter.ConvertToUint64()), h.damage, stamp));
+    }
+
+    //--------------------------------------------------------------------------
+    // schema
+    //--------------------------------------------------------------------------
+    template <typename Msg>
+    void benchSchema(const char* name, const Msg& msg, std::size_t iterations) {
+        Wire::ByteWriter w;
+        const Clock::time_point encodeStart = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Wire::encode(w, msg);
+            g_sink = g_sink + w.size();
+        }
+        const Clock::duration encodeTime = Clock::now() - encodeStart;
+
+        Msg decoded;
+        const Clock::time_point decodeStart = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Wire::ByteReader r(w.data() + 1, w.size() - 1);
+            if (!Wire::decode(r, decoded)) std::abort();
+            g_sink = g_sink + r.remaining();
+        }
+        const Clock::duration decodeTime = Clock::now() - decodeStart;
+
+        std::printf("  %-14s %3zu B   encode %6.1f ns   decode %6.1f ns\n", name, w.size(),
+                    nsPer(encodeTime, iterations), nsPer(decodeTime, iterations));
+    }
+
+    //--------------------------------------------------------------------------
+    // parse
+    //--------------------------------------------------------------------------
+    struct CountingReceiver {
+        std::size_t messages = 0;
+        template <typename Msg>
+        void HandleMessage(const Msg& /*msg*/, CSteamID /*sender*/) { ++messages; }
+    };
+
+    constexpr auto kHandlers = Wire::makeDispatchTable<CountingReceiver>();
+
+    void benchParse(std::size_t iterations) {
+        // One host tick in a busy wave: enemy updates dominate, with a few
+        // spawns, deaths, shots, hits and the player states.
+        PacketCoalescer coalescer;
+        Wire::ByteWriter w;
+        std::size_t frames = 0;
+        auto add = [&](const auto& msg) {
+            Wire::encode(w, msg);
+            coalescer.queue(kPeer, w);
+            ++frames;
+        };
+        Wire::EnemyUpdate update = sampleUpdate();
+        for (int i = 0; i < 120; ++i) {
+            update.id += 1;
+            update.x += 7.f;
+            add(update);
+        }
+        for (int i = 0; i < 6; ++i) add(sampleSpawn());
+        for (int i = 0; i < 6; ++i) add(sampleDeath());
+        for (int i = 0; i < 10; ++i) add(sampleFire());
+        for (int i = 0; i < 10; ++i) add(sampleHit());
+        for (int i = 0; i < 4; ++i) add(samplePlayer());
+
+        std::vector<std::vector<uint8_t>> packets;
+        std::size_t bytes = 0;
+        coalescer.flush([&](CSteamID, const uint8_t* data, std::size_t size) {
+            packets.emplace_back(data, data + size);
+            bytes += size;
+            return true;
+        });
+
+        CountingReceiver receiver;
+        const std::size_t rounds = iterations / frames + 1;
+        const Clock::time_point start = Clock::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (const std::vector<uint8_t>& packet : packets) {
+                PacketCoalescer::forEachFrame(packet.data(), packet.size(), [&](const uint8_t* frame, std::size_t size) {
+                    const auto handler = frame[0] < kHandlers.size() ? kHandlers[frame[0]] : nullptr;
+                    Wire::ByteReader reader(frame + 1, size - 1);
+                    if (!handler || !handler(receiver, reader, kPeer)) std::abort();
+                });
+            }
+        }
+        const Clock::duration elapsed = Clock::now() - start;
+
+        std::printf("parse (%zu messages in %zu packets, %zu B per tick)\n", frames, packets.size(), bytes);
+        std::printf("  %.1f ns per message, %.2f us per tick, %.0f MB/s\n",
+                    nsPer(elapsed, rounds * frames), nsPer(elapsed, rounds) / 1000.0,
+                    static_cast<double>(rounds * bytes) / std::chrono::duration<double, std::micro>(elapsed).count());
+        g_sink = g_sink + receiver.messages;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000ull;
+
+    benchSizes();
+
+    std::printf("schema (%zu iterations)\n", iterations);
+    benchSchema("PlayerUpdate", samplePlayer(), iterations);
+    benchSchema("EnemySpawn", sampleSpawn(), iterations);
+    benchSchema("EnemyUpdate", sampleUpdate(), iterations);
+    benchSchema("EnemyDeath", sampleDeath(), iterations);
+    benchSchema("BulletFire", sampleFire(), iterations);
+    benchSchema("Hit", sampleHit(), iterations);
+    benchSchema("SnapshotAck", Wire::SnapshotAck(), iterations);
+
+    benchParse(iterations);
+    return 0;
+}
@@ -0,0 +1,221 @@
+//==============================================================================
+// wire_fuzz: fuzz target for the receive path.
+//
+// Every input is treated as one received P2P packet and goes through the same
+// steps as NetworkManager::receiveMessages(): PacketCoalescer::forEachFrame()
+// framing, then the generated Wire dispatch table. SnapshotPart bodies are
+// additionally applied with readSnapshotDelta(). Nothing here needs Steam to
+// be running; CSteamID is header-only.
+//
+// Built with CUBEGAME_WIRE_LIBFUZZER (clang), libFuzzer drives
+// LLVMFuzzerTestOneInput(). Otherwise main() mutates a corpus of valid packets
+// itself: wire_fuzz [iterations] [seed].
+//==============================================================================
+#include "../src/Networking/PacketCoalescer.h"
+#include "../src/Networking/WireProtocol.h"
+#include "../src/Networking/WorldSnapshot.h"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    struct FuzzReceiver {
+        std::size_t decoded = 0;
+        std::size_t snapshotBodies = 0;
+
+        template <typename Msg>
+        void HandleMessage(const Msg& /*msg*/, CSteamID /*sender*/) { ++decoded; }
+
+        void HandleMessage(const Wire::SnapshotPart& msg, CSteamID /*sender*/) {
+            ++decoded;
+            WorldSnapshot world;
+            if (readSnapshotDelta(msg.body, world)) ++snapshotBodies;
+        }
+    };
+
+    constexpr auto kHandlers = Wire::makeDispatchTable<FuzzReceiver>();
+
+    /// Runs one packet through framing and dispatch; returns false if it was rejected anywhere.
+    bool receive(FuzzReceiver& receiver, const uint8_t* data, std::size_t size) {
+        if (size > Wire::kMaxPacket) return false;
+        bool clean = true;
+        const bool framed = PacketCoalescer::forEachFrame(data, size, [&](const uint8_t* frame, std::size_t frameSize) {
+            const uint8_t id = frame[0];
+            const auto handler = id < kHandlers.size() ? kHandlers[id] : nullptr;
+            Wire::ByteReader reader(frame + 1, frameSize - 1);
+            if (!handler || !handler(receiver, reader, CSteamID()))
+                clean = false;
+        });
+        return framed && clean;
+    }
+
+    //--------------------------------------------------------------------------
+    // Seed corpus: one packet per message plus all of them coalesced.
+    //--------------------------------------------------------------------------
+    std::vector<std::vector<uint8_t>> makeSeeds() {
+        const CSteamID peer(76561197960287930ULL);
+        std::vector<std::vector<uint8_t>> seeds;
+        const auto collect = [&](CSteamID, const uint8_t* data, std::size_t size) {
+            seeds.emplace_back(data, data + size);
+            return true;
+        };
+        PacketCoalescer single, coalesced;
+        Wire::ByteWriter w;
+        auto add = [&](const auto& msg) {
+            Wire::encode(w, msg);
+            single.queue(peer, w);
+            single.flush(collect);
+            coalesced.queue(peer, w);
+        };
+
+        Wire::PlayerUpdate player;
+        player.player = peer;
+        player.x = player.renderedX = 812.5f;
+        player.y = player.renderedY = -140.f;
+        player.health = 95;
+        player.kills = 12;
+        player.money = 340;
+        player.speed = 150.f;
+        player.ready = true;
+        add(player);
+
+        Wire::EnemySpawn spawn;
+        spawn.id = 0x12340007;
+        spawn.x = 300.f;
+        spawn.y = 420.f;
+        spawn.health = 40;
+        spawn.spawnDelay = 1.5f;
+        spawn.type = 1;
+        spawn.tick = 4000;
+        add(spawn);
+
+        Wire::BulletFire fire;
+        fire.messageId = 77;
+        fire.shooter = peer;
+        fire.bulletIndex = 19;
+        fire.startX = 812.f;
+        fire.startY = -140.f;
+        fire.targetX = 1000.f;
+        fire.targetY = 0.f;
+        fire.lifetime = 2.f;
+        add(fire);
+
+        Wire::Hit hit;
+        hit.shooter = peer;
+        hit.bulletIndex = 19;
+        hit.enemyId = spawn.id;
+        hit.damage = 10;
+        hit.tick = 4010;
+        add(hit);
+
+        Wire::SnapshotAck ack;
+        ack.seq = 88;
+        add(ack);
+        add(Wire::Welcome());
+        add(Wire::Ping());
+
+        // A full and a delta snapshot of a small world.
+        WorldSnapshot base, next;
+        for (uint64_t id = 1; id <= 40; ++id) {
+            EnemyNetState e;
+            e.id = id;
+            e.x = static_cast<uint16_t>(32768 + id * 37);
+            e.y = static_cast<uint16_t>(32768 - id * 11);
+            e.health = 30;
+            e.type = static_cast<uint8_t>(id & 1);
+            base.enemies.push_back(e);
+        }
+        PlayerNetState p;
+        p.account = peer.GetAccountID();
+        p.x = p.y = 32768;
+        p.health = 100;
+        p.flags = PlayerNetState::Alive;
+        base.players.push_back(p);
+        next = base;
+        for (EnemyNetState& e : next.enemies) e.x = static_cast<uint16_t>(e.x + 3);
+        next.enemies.erase(next.enemies.begin() + 5);
+
+        std::vector<Wire::ByteWriter> bodies;
+        const WorldSnapshot* baselines[] = { nullptr, &base };
+        for (const WorldSnapshot* from : baselines) {
+            writeSnapshotDelta(from, next, bodies);
+            Wire::SnapshotPart part;
+            part.seq = 9;
+            part.baseline = 8;
+            part.hasBaseline = from != nullptr;
+            part.partCount = static_cast<uint8_t>(bodies.size());
+            for (std::size_t i = 0; i < bodies.size(); ++i) {
+                part.part = static_cast<uint8_t>(i);
+                part.body.data = bodies[i].data();
+                part.body.size = bodies[i].size();
+                add(part);
+            }
+        }
+
+        coalesced.flush(collect);
+        return seeds;
+    }
+
+    void mutate(std::vector<uint8_t>& packet, const std::vector<std::vector<uint8_t>>& seeds, std::mt19937& rng) {
+        std::uniform_int_distribution<int> byte(0, 255);
+        const int edits = 1 + static_cast<int>(rng() % 4);
+        for (int i = 0; i < edits; ++i) {
+            const std::size_t at = packet.empty() ? 0 : rng() % packet.size();
+            switch (rng() % 6) {
+                case 0: if (!packet.empty()) packet[at] ^= static_cast<uint8_t>(1u << (rng() % 8)); break;
+                case 1: if (!packet.empty()) packet[at] = static_cast<uint8_t>(byte(rng)); break;
+                case 2: packet.resize(at); break;
+                case 3: packet.insert(packet.begin() + at, static_cast<uint8_t>(byte(rng))); break;
+                case 4: if (!packet.empty()) packet[at] = rng() % 2 ? 0xFF : 0x80; break; // Varint continuation bytes.
+                default: {
+                    const std::vector<uint8_t>& other = seeds[rng() % seeds.size()];
+                    if (other.size() > 1) {
+                        const std::size_t from = 1 + rng() % (other.size() - 1);
+                        packet.insert(packet.begin() + at, other.begin() + from, other.end());
+                    }
+                    break;
+                }
+            }
+        }
+        if (!packet.empty() && rng() % 4 != 0) packet[0] = Wire::kVersion; // Mostly get past the version check.
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) {
+    FuzzReceiver receiver;
+    receive(receiver, data, size);
+    return 0;
+}
+
+#ifndef CUBEGAME_WIRE_LIBFUZZER
+int main(int argc, char** argv) {
+    const unsigned long iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000ul;
+    const unsigned long seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1ul;
+
+    const std::vector<std::vector<uint8_t>> seeds = makeSeeds();
+    FuzzReceiver receiver;
+    for (const std::vector<uint8_t>& packet : seeds) {
+        if (!receive(receiver, packet.data(), packet.size())) {
+            std::cerr << "[ERROR] A valid seed packet was rejected" << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(seed));
+    std::vector<uint8_t> packet;
+    std::size_t accepted = 0;
+    for (unsigned long i = 0; i < iterations; ++i) {
+        packet = seeds[rng() % seeds.size()];
+        mutate(packet, seeds, rng);
+        if (receive(receiver, packet.data(), packet.size())) ++accepted;
+    }
+
+    std::cout << "wire_fuzz: " << iterations << " mutated packets (seed " << seed << ", "
+              << seeds.size() << " seed packets), " << accepted << " accepted whole, "
+              << receiver.decoded << " messages decoded, " << receiver.snapshotBodies
+              << " snapshot bodies applied" << std::endl;
+    return 0;
+}
+#endif